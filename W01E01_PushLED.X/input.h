@@ -0,0 +1,83 @@
+/*
+ * File:   input.h
+ * Author: Nevil Sandaradura
+ * Email: npsand@utu.fi
+ * Device:  ATmega4809 Curiosity Nano
+ *
+ * Debounced digital inputs without polling. Every input interrupts on
+ * both edges. The first edge masks the pin and starts a one-shot TCB2
+ * timeout, the bounces that follow are not seen. When the timeout ends
+ * every masked pin is unmasked and sampled, and if its level differs from
+ * the last debounced level the callback gets the new one.
+ *
+ * Edge sensing on both edges wakes the CPU from standby and power-down on
+ * any pin. TCB2 runs in standby while a timeout is due, so sleep in
+ * standby (or IDLE) between the events. The engine owns TCB2 and the
+ * PORTx_PORT_vect interrupts of the ports enabled with the INPUT_PORTx
+ * flags, set 1 for every port that has an input in the pin table. The
+ * other pins of those ports must not have interrupts of their own.
+ *
+ * The callback runs in the TCB2 interrupt. A FreeRTOS project can pass
+ * the event to a task with xQueueSendFromISR().
+ *
+ * With INPUT_STATS set to 1 the engine counts the edges, the debounced
+ * events and the CPU cycles the device has been awake (TCB3 counts the
+ * peripheral clock, which it does not get in standby or power-down).
+ *
+ * Same file in every project that uses the inputs, except for the
+ * INPUT_PORTx flags.
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef INPUT_H
+#define	INPUT_H
+
+#include <stdint.h>
+#include <avr/io.h>
+
+// Time a pin must be left alone after an edge
+#define INPUT_DEBOUNCE_MS 20
+// Peripheral clock, TCB2 counts it divided by 2
+#define INPUT_CLOCK_HZ 3333333UL
+#define INPUT_MAX 8
+// 1 counts edges, events and the active CPU cycles
+#define INPUT_STATS 0
+// 1 for the ports with inputs, their PORTx_PORT_vect is defined
+#define INPUT_PORTA 0
+#define INPUT_PORTB 0
+#define INPUT_PORTC 0
+#define INPUT_PORTD 0
+#define INPUT_PORTE 0
+#define INPUT_PORTF 1
+
+typedef struct
+{
+    PORT_t *port;       // E.g. &PORTA
+    uint8_t pin;        // PINn_bm
+    uint8_t pullup;     // 1 enables the internal pull-up
+} input_pin_t;
+
+// Input is the index in the pin table, level is 0 or 1
+typedef void (*input_callback_t)(uint8_t input, uint8_t level);
+
+#if INPUT_STATS == 1
+typedef struct
+{
+    uint16_t edges;         // Pin interrupts, bounces included
+    uint16_t events;        // Debounced level changes
+    uint32_t active_cycles; // Peripheral clock cycles awake
+} input_stats_t;
+#endif
+
+// Declaring functions
+// The table must stay valid, at most INPUT_MAX pins
+void input_init(const input_pin_t *pins, uint8_t count,
+                input_callback_t callback);
+// Debounced level of an input
+uint8_t input_level(uint8_t input);
+#if INPUT_STATS == 1
+void input_get_stats(input_stats_t *stats);
+#endif
+
+#endif	/* INPUT_H */
@@ -2,25 +2,49 @@
  * File:   main.c
  * Author: Nevil Sandaradura
  *
+ * The LED on PF5 follows the button on PF6. The button is debounced by
+ * input.c, the CPU sleeps in standby between the presses.
+ *
  * Created on October 27, 2021, 2:43 PM
  */
 
 
 #include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+
+#include "input.h"
+
+// Button on PF6, pressed connects it to ground
+const input_pin_t g_inputs[] =
+{
+    { &PORTF, PIN6_bm, 1 }
+};
+
+// LED is on (low) while the button is pressed (low)
+void button_changed(uint8_t input, uint8_t level)
+{
+    if(level)
+    {
+        PORTF.OUT = PORTF.OUT | PIN5_bm;
+    }else
+    {
+        PORTF.OUT = PORTF.OUT & ~PIN5_bm;
+    }
+}
 
 int main(void) 
 {
     PORTF.DIR = PORTF.DIR | PIN5_bm;
-    PORTF.DIR = PORTF.DIR & ~PIN6_bm;
     
+    input_init(g_inputs, 1, button_changed);
+    button_changed(0, input_level(0));
+    
+    set_sleep_mode(SLPCTRL_SMODE_STDBY_gc);
+    sei();
     while (1) 
     {
-        if(PORTF.IN & PIN6_bm)
-        {
-            PORTF.OUT = PORTF.OUT | PIN5_bm;
-        }else
-        {
-            PORTF.OUT = PORTF.OUT & ~PIN5_bm;
-        }
+        // Everything happens in the interrupts
+        sleep_mode();
     }
 }
@@ -9,72 +9,72 @@
  * if an interrupt occurs countdown will be halted. When 
  * reaching number 0 start blinking zero on the display.
  * 
+ * The countdown sleeps in standby between the seconds, countdown.c
+ * wakes it once a second from the RTC. input.c debounces the button.
+ * 
  * Created on November 1, 2021, 3:59 PM
  */
-#define F_CPU 3333333
-
 #include <avr/io.h>
-#include <util/delay.h>
 #include <avr/interrupt.h>
 
+#include "segdisplay.h"
+#include "countdown.h"
+#include "input.h"
+
 // global increment variable
 volatile uint8_t g_running = 1;
-    
-int main(void)
+// number on the display, 10 is blank
+uint8_t g_index = 9;
+// button on PA4, pressing pulls it low
+const input_pin_t g_inputs[] =
 {
-    // array containing numbers 0-9 and blank for seven segment display
-    uint8_t seven_segment_numbers[] =
-    {
-        0b00111111, 0b00000110, 0b01011011, 
-        0b01001111, 0b01100110, 0b01101101, 
-        0b01111101, 0b00000111, 0b01111111, 
-        0b01100111, 0b00000000
-    };
-    
-    // set PORTC as output
-    PORTC.DIRSET = 0xFF;
-    
-    // set PA4 as input
-    PORTA.DIRCLR = PIN4_bm;
-    // enable internal pull-up resistor for PA4
-    // trigger interrupts on falling edge
-    PORTA.PIN4CTRL = PORT_PULLUPEN_bm | PORT_ISC_FALLING_gc;
+    { &PORTA, PIN4_bm, 1 }
+};
 
-    //starting countdown from number 9
-    uint8_t index = 9;
-    // enable interrupts
-    sei();
-    while (1)
+// halts the countdown when the button is pressed
+void button_changed(uint8_t input, uint8_t level)
+{
+    if(!level)
     {
-        // display number on seven segment display
-        PORTC.OUT = seven_segment_numbers[index];
-        
-        if(index == 10)
-        {
-            // set index to zero to display number 0
-            index = 0;
-        }
-        else if(index > 0)
-        {
-            // decrease numbers amount of g_running
-            index -= g_running;
-        }
-        else
-        {
-            // set index to ten to clear display
-            index = 10;
-        }
-        // 1 second delay
-        _delay_ms(1000);
+        // set increment to 0 to halt countdown
+        g_running = 0;
     }
 }
 
-ISR(PORTA_PORT_vect)
+// shows the next number, called every second
+void bomb_second(void)
 {
-    // clear interrupt flags
-    PORTA.INTFLAGS = 0xFF;
-    // set increment to 0 to halt countdown
-    g_running = 0;
-
+    if(g_index == 10)
+    {
+        // set index to zero to display number 0
+        g_index = 0;
+    }
+    else if(g_index > 0)
+    {
+        // decrease numbers amount of g_running
+        g_index -= g_running;
+    }
+    else
+    {
+        // set index to ten to clear display
+        g_index = 10;
+    }
+    // display number on seven segment display, 10 is blank
+    seg_set_char(g_index < 10 ? '0' + g_index : ' ');
 }
+    
+int main(void)
+{
+    // seven segment display holds the digit while the CPU sleeps
+    seg_init();
+    
+    // PA4 as input with pull-up, debounced
+    input_init(g_inputs, 1, button_changed);
 
+    //starting countdown from number 9
+    seg_set_char('0' + g_index);
+    // one second wake-ups from the RTC
+    countdown_init(bomb_second);
+    // enable interrupts and count down
+    countdown_run();
+}
@@ -0,0 +1,43 @@
+/* 
+ * File:   segdisplay.h
+ * Author: Nevil Sandaradura
+ * Email: npsand@utu.fi
+ * Device:  ATmega4809 Curiosity Nano
+ * 
+ * Seven segment display driver for one digit. The application writes
+ * characters or segment patterns, the driver writes them straight to the
+ * pins. The pins hold the digit, so nothing refreshes it and the CPU can
+ * sleep in any mode while it is shown.
+ * 
+ * Segments a-g are bits 0-6 of SEG_SEGMENT_VPORT, the decimal point bit 7.
+ * The digit is lit when SEG_DIGIT_PIN in SEG_DIGIT_VPORT is high. The
+ * Curiosity Nano wiring grounds it through the transistor on PF5.
+ * 
+ * Same file in every project that uses the display.
+ * 
+ * Created on October 19, 2026
+ */
+
+#ifndef SEGDISPLAY_H
+#define	SEGDISPLAY_H
+
+#include <stdint.h>
+
+// Display wiring
+#define SEG_SEGMENT_VPORT VPORTC
+#define SEG_DIGIT_VPORT VPORTF
+#define SEG_DIGIT_PIN PIN5_bm
+
+// Segment bit of the decimal point
+#define SEG_DP 0x80
+
+// Declaring functions
+// Pins as outputs, the digit lit with no segments
+void seg_init(void);
+// 0 darkens the digit, other values light it, the segments are kept
+void seg_set_lit(uint8_t lit);
+// Characters without a segment pattern are blank
+void seg_set_char(char c);
+void seg_set_segments(uint8_t segments);
+
+#endif	/* SEGDISPLAY_H */
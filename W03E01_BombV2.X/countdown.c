@@ -0,0 +1,198 @@
+/*
+ * File:   countdown.c
+ * Author: Nevil Sandaradura
+ * Email: npsand@utu.fi
+ * Device:  ATmega4809 Curiosity Nano
+ *
+ * Low-power one second timebase, see countdown.h.
+ *
+ * Created on October 19, 2026
+ */
+
+#include <avr/io.h>
+#include <avr/cpufunc.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+#include <stdlib.h>             // for utoa() and ultoa()
+
+#include "countdown.h"
+
+// Setting macro to apply BAUD RATE
+// Copied from Microchip's Getting Started with USART
+#define USART0_BAUD_RATE(BAUD_RATE) \
+((float)(COUNTDOWN_CLOCK_HZ * 64 / (16 *(float)BAUD_RATE)) + 0.5)
+
+static countdown_callback_t countdown_callback;
+// Set by the PIT interrupt every second
+static volatile uint8_t countdown_second = 0;
+
+#if COUNTDOWN_STATS_INTERVAL_S > 0
+// Over the current interval
+static uint16_t countdown_wakeups = 0;
+static uint32_t countdown_active_counts = 0;
+// TCB0 count when the active time was last added
+static uint16_t countdown_last_count;
+static uint8_t countdown_seconds = 0;
+
+// Copied from Microchip's Getting Started with USART
+static void countdown_send_char(char c)
+{
+    while (!(USART0.STATUS & USART_DREIF_bm))
+    {
+        ;
+    }
+    USART0.TXDATAL = c;
+}
+
+static void countdown_send_string(const char *str)
+{
+    while(*str != '\0')
+    {
+        countdown_send_char(*str++);
+    }
+}
+
+static void countdown_stats_init(void)
+{
+    // Setting PA0 as output (TX)
+    PORTA.DIRSET = PIN0_bm;
+    //Setting baud rate to 9600 using macro
+    USART0.BAUD = (uint16_t)USART0_BAUD_RATE(9600);
+    // Enable transmitter
+    USART0.CTRLB |= USART_TXEN_bm;
+
+    // TCB0 counts the undivided peripheral clock over its full range. It
+    // stops with the clock in standby and power-down
+    TCB0.CTRLB = TCB_CNTMODE_INT_gc;
+    TCB0.CCMP = 0xFFFF;
+    TCB0.CTRLA = TCB_CLKSEL_CLKDIV1_gc | TCB_ENABLE_bm;
+    countdown_last_count = TCB0.CNT;
+}
+
+// Adds the time awake since the last call, which must be less than a TCB0
+// period (19.7 ms)
+static void countdown_stats_update(void)
+{
+    uint16_t count = TCB0.CNT;
+
+    countdown_active_counts += (uint16_t)(count - countdown_last_count);
+    countdown_last_count = count;
+}
+
+// Sends the statistics of the interval and starts the next one
+static void countdown_stats_send(void)
+{
+    char number[11];
+    uint32_t ppm;
+
+    ppm = (uint64_t)countdown_active_counts * 1000000 /
+          (COUNTDOWN_CLOCK_HZ * COUNTDOWN_STATS_INTERVAL_S);
+    countdown_send_string("STATS wakeups/s: ");
+    countdown_send_string(utoa(countdown_wakeups /
+                               COUNTDOWN_STATS_INTERVAL_S, number, 10));
+    countdown_send_string("\tactive ppm: ");
+    countdown_send_string(ultoa(ppm, number, 10));
+    countdown_send_string("\r\n");
+    // Standby would cut the last byte
+    while (!(USART0.STATUS & USART_TXCIF_bm))
+    {
+        ;
+    }
+    USART0.STATUS = USART_TXCIF_bm;
+
+    countdown_wakeups = 0;
+    countdown_active_counts = 0;
+    // Sending is not counted
+    countdown_last_count = TCB0.CNT;
+}
+#endif
+
+/*
+ * This function is copied and modified from technical brief TB3213.
+ * Initialize RTC to use external crystal.
+ */
+void countdown_init(countdown_callback_t callback)
+{
+    uint8_t temp;
+
+    countdown_callback = callback;
+    // Disable oscillator
+    temp = CLKCTRL.XOSC32KCTRLA;
+    temp &= ~CLKCTRL_ENABLE_bm;
+    ccp_write_io((void*)&CLKCTRL.XOSC32KCTRLA, temp);
+    // Wait for the clock to be released (0 = unstable, unused)
+    while (CLKCTRL.MCLKSTATUS & CLKCTRL_XOSC32KS_bm);
+
+    // Select external crystal (SEL = 0)
+    temp = CLKCTRL.XOSC32KCTRLA;
+    temp &= ~CLKCTRL_SEL_bm;
+    ccp_write_io((void*)&CLKCTRL.XOSC32KCTRLA, temp);
+
+    // Enable oscillator
+    temp = CLKCTRL.XOSC32KCTRLA;
+    temp |= CLKCTRL_ENABLE_bm;
+    ccp_write_io((void*)&CLKCTRL.XOSC32KCTRLA, temp);
+    // Wait for the clock to stabilize
+    while (RTC.STATUS > 0);
+
+    // Configure RTC module
+    // Select 32.768 kHz external oscillator
+    RTC.CLKSEL = RTC_CLKSEL_TOSC32K_gc;
+    // Enable Periodic Interrupt
+    RTC.PITINTCTRL = RTC_PI_bm;
+    // Set period to 32768 cycles (1 second) and enable PIT function, the
+    // PIT keeps running in standby and power-down
+    while (RTC.PITSTATUS > 0);
+    RTC.PITCTRLA = RTC_PERIOD_CYC32768_gc | RTC_PITEN_bm;
+
+#if COUNTDOWN_STATS_INTERVAL_S > 0
+    countdown_stats_init();
+#endif
+}
+
+void countdown_run(void)
+{
+    set_sleep_mode(COUNTDOWN_SLEEP_MODE);
+    sei();
+
+    while (1)
+    {
+        if(countdown_second)
+        {
+            countdown_second = 0;
+            countdown_callback();
+#if COUNTDOWN_STATS_INTERVAL_S > 0
+            if(++countdown_seconds >= COUNTDOWN_STATS_INTERVAL_S)
+            {
+                countdown_seconds = 0;
+                countdown_stats_update();
+                countdown_stats_send();
+            }
+#endif
+        }
+#if COUNTDOWN_STATS_INTERVAL_S > 0
+        countdown_stats_update();
+#endif
+        // Sleep unless an interrupt came after the check, sleep_cpu() runs
+        // before an interrupt enabled by sei()
+        cli();
+        if(!countdown_second)
+        {
+            sleep_enable();
+            sei();
+            sleep_cpu();
+            sleep_disable();
+#if COUNTDOWN_STATS_INTERVAL_S > 0
+            countdown_wakeups++;
+#endif
+        }
+        sei();
+    }
+}
+
+ISR(RTC_PIT_vect)
+{
+    // Clear interrupt flag
+    RTC.PITINTFLAGS = RTC_PI_bm;
+    countdown_second = 1;
+}
@@ -0,0 +1,50 @@
+/*
+ * File:   countdown.h
+ * Author: Nevil Sandaradura
+ * Email: npsand@utu.fi
+ * Device:  ATmega4809 Curiosity Nano
+ *
+ * Low-power one second timebase for the bomb countdowns. The RTC periodic
+ * interrupt (PIT) runs from the 32.768 kHz crystal with a period of one
+ * second, so the CPU wakes once a second instead of counting shorter
+ * periods. Between the seconds it sleeps in COUNTDOWN_SLEEP_MODE. Standby
+ * stops everything but the PIT and the peripherals that are set to run in
+ * standby, like the debounce timer of input.c while it is due, so it
+ * draws about the same as power-down. Power-down is not used because it
+ * would stop that timer.
+ *
+ * The application's callback runs in the main loop after the wake-up.
+ *
+ * With COUNTDOWN_STATS_INTERVAL_S above 0 the wake-ups per second and the
+ * share of time the CPU was awake (parts per million) are sent to USART0
+ * (PA0, 9600 baud). TCB0 counts the peripheral clock and stops in standby
+ * and power-down, so the figure is not valid in IDLE sleep.
+ *
+ * Same file in every project that uses the countdown.
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef COUNTDOWN_H
+#define	COUNTDOWN_H
+
+#include <stdint.h>
+
+// Sleep mode between the seconds
+#define COUNTDOWN_SLEEP_MODE SLPCTRL_SMODE_STDBY_gc
+// Seconds between statistics on USART0, 0 disables them
+#define COUNTDOWN_STATS_INTERVAL_S 0
+// Peripheral clock, TCB0 counts it undivided
+#define COUNTDOWN_CLOCK_HZ 3333333UL
+
+// Called once a second
+typedef void (*countdown_callback_t)(void);
+
+// Declaring functions
+// Starts the crystal and the one second PIT
+void countdown_init(countdown_callback_t callback);
+// Enables interrupts, sleeps and runs the callback every second, does not
+// return
+void countdown_run(void);
+
+#endif	/* COUNTDOWN_H */
@@ -0,0 +1,243 @@
+/*
+ * File:   input.c
+ * Author: Nevil Sandaradura
+ * Email: npsand@utu.fi
+ * Device:  ATmega4809 Curiosity Nano
+ *
+ * Debounced digital inputs, see input.h.
+ *
+ * A pin is masked by setting its sense configuration to INTDISABLE, which
+ * keeps the input buffer on so the pin can still be sampled.
+ *
+ * Created on October 19, 2026
+ */
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+#include "input.h"
+
+// TCB2 counts of the debounce timeout
+#define INPUT_DEBOUNCE_COUNTS (INPUT_CLOCK_HZ / 2 / 1000 * INPUT_DEBOUNCE_MS)
+
+#if INPUT_DEBOUNCE_COUNTS > 0xFFFF
+#error INPUT_DEBOUNCE_MS is too long for the 16-bit TCB2
+#endif
+
+static const input_pin_t *input_pins;
+static uint8_t input_count;
+static input_callback_t input_callback;
+// Bit n is the debounced level of input n
+static volatile uint8_t input_levels;
+// Bit n set while input n is masked until the timeout
+static volatile uint8_t input_settling;
+
+#if INPUT_STATS == 1
+static volatile uint16_t input_edges;
+static volatile uint16_t input_events;
+// TCB3 periods awake
+static volatile uint16_t input_active_high;
+#endif
+
+// Writes the pin control register of an input
+static void input_sense(const input_pin_t *input, uint8_t sense)
+{
+    uint8_t n = 0;
+
+    // PIN0CTRL-PIN7CTRL follow each other
+    while(!(input->pin & (1 << n)))
+    {
+        n++;
+    }
+    (&input->port->PIN0CTRL)[n] = (input->pullup ? PORT_PULLUPEN_bm : 0) |
+                                  sense;
+}
+
+// Starts the timeout again from zero
+static void input_timer_restart(void)
+{
+    TCB2.CTRLA = 0;
+    TCB2.CNT = 0;
+    TCB2.INTFLAGS = TCB_CAPT_bm;
+    // Keeps running in standby until the timeout ends
+    TCB2.CTRLA = TCB_CLKSEL_CLKDIV2_gc | TCB_RUNSTDBY_bm | TCB_ENABLE_bm;
+}
+
+void input_init(const input_pin_t *pins, uint8_t count,
+                input_callback_t callback)
+{
+    input_pins = pins;
+    input_count = count > INPUT_MAX ? INPUT_MAX : count;
+    input_callback = callback;
+    input_settling = 0;
+
+    // One-shot timeout, stopped in its interrupt
+    TCB2.CTRLA = 0;
+    TCB2.CTRLB = TCB_CNTMODE_INT_gc;
+    TCB2.CCMP = INPUT_DEBOUNCE_COUNTS - 1;
+    TCB2.INTCTRL = TCB_CAPT_bm;
+
+#if INPUT_STATS == 1
+    // Free-running over the full range, the interrupt counts the periods
+    TCB3.CTRLB = TCB_CNTMODE_INT_gc;
+    TCB3.CCMP = 0xFFFF;
+    TCB3.INTCTRL = TCB_CAPT_bm;
+    TCB3.CTRLA = TCB_CLKSEL_CLKDIV1_gc | TCB_ENABLE_bm;
+#endif
+
+    input_levels = 0;
+    for(uint8_t i = 0; i < input_count; i++)
+    {
+        pins[i].port->DIRCLR = pins[i].pin;
+        input_sense(&pins[i], PORT_ISC_BOTHEDGES_gc);
+    }
+    // Levels after the pull-ups are on
+    for(uint8_t i = 0; i < input_count; i++)
+    {
+        if(pins[i].port->IN & pins[i].pin)
+        {
+            input_levels |= 1 << i;
+        }
+    }
+}
+
+uint8_t input_level(uint8_t input)
+{
+    return (input_levels >> input) & 1;
+}
+
+#if INPUT_STATS == 1
+void input_get_stats(input_stats_t *stats)
+{
+    uint8_t sreg = SREG;
+    uint16_t count;
+    uint16_t high;
+
+    cli();
+    count = TCB3.CNT;
+    high = input_active_high;
+    // Period ended but its interrupt has not run yet
+    if((TCB3.INTFLAGS & TCB_CAPT_bm) && count < 0x8000)
+    {
+        high++;
+    }
+    stats->edges = input_edges;
+    stats->events = input_events;
+    SREG = sreg;
+    stats->active_cycles = ((uint32_t)high << 16) | count;
+}
+
+ISR(TCB3_INT_vect)
+{
+    TCB3.INTFLAGS = TCB_CAPT_bm;
+    input_active_high++;
+}
+#endif
+
+// Masks the pins that changed and starts the timeout
+static void input_port_interrupt(PORT_t *port)
+{
+    uint8_t pins = 0;
+    uint8_t flags;
+    uint8_t changed = 0;
+
+    // Only the flags of the inputs, the other pins are not ours
+    for(uint8_t i = 0; i < input_count; i++)
+    {
+        if(input_pins[i].port == port)
+        {
+            pins |= input_pins[i].pin;
+        }
+    }
+    flags = port->INTFLAGS & pins;
+    port->INTFLAGS = flags;
+    for(uint8_t i = 0; i < input_count; i++)
+    {
+        if(input_pins[i].port == port && (flags & input_pins[i].pin))
+        {
+            input_sense(&input_pins[i], PORT_ISC_INTDISABLE_gc);
+            input_settling |= 1 << i;
+            changed = 1;
+#if INPUT_STATS == 1
+            input_edges++;
+#endif
+        }
+    }
+    if(changed)
+    {
+        input_timer_restart();
+    }
+}
+
+ISR(TCB2_INT_vect)
+{
+    uint8_t settled = input_settling;
+
+    TCB2.INTFLAGS = TCB_CAPT_bm;
+    TCB2.CTRLA = 0;
+    input_settling = 0;
+    for(uint8_t i = 0; i < input_count; i++)
+    {
+        const input_pin_t *input = &input_pins[i];
+        uint8_t level;
+
+        if(!(settled & (1 << i)))
+        {
+            continue;
+        }
+        // Unmask before sampling, a later edge interrupts again
+        input->port->INTFLAGS = input->pin;
+        input_sense(input, PORT_ISC_BOTHEDGES_gc);
+        level = (input->port->IN & input->pin) ? 1 : 0;
+        if(level != input_level(i))
+        {
+            input_levels ^= 1 << i;
+#if INPUT_STATS == 1
+            input_events++;
+#endif
+            input_callback(i, level);
+        }
+    }
+}
+
+#if INPUT_PORTA == 1
+ISR(PORTA_PORT_vect)
+{
+    input_port_interrupt(&PORTA);
+}
+#endif
+
+#if INPUT_PORTB == 1
+ISR(PORTB_PORT_vect)
+{
+    input_port_interrupt(&PORTB);
+}
+#endif
+
+#if INPUT_PORTC == 1
+ISR(PORTC_PORT_vect)
+{
+    input_port_interrupt(&PORTC);
+}
+#endif
+
+#if INPUT_PORTD == 1
+ISR(PORTD_PORT_vect)
+{
+    input_port_interrupt(&PORTD);
+}
+#endif
+
+#if INPUT_PORTE == 1
+ISR(PORTE_PORT_vect)
+{
+    input_port_interrupt(&PORTE);
+}
+#endif
+
+#if INPUT_PORTF == 1
+ISR(PORTF_PORT_vect)
+{
+    input_port_interrupt(&PORTF);
+}
+#endif
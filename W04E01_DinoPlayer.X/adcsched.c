@@ -0,0 +1,150 @@
+/*
+ * File:   adcsched.c
+ * Author: Nevil Sandaradura
+ * Email: npsand@utu.fi
+ * Device:  ATmega4809 Curiosity Nano
+ *
+ * ADC0 conversion scheduler, see adcsched.h.
+ *
+ * The scheduler remembers the reference and sample length it last wrote,
+ * so it can pick the next conversion without reading the registers back
+ * and only touches CTRLC and SAMPCTRL when a channel needs other values.
+ *
+ * Created on October 19, 2026
+ */
+
+#include <avr/io.h>
+
+#include "adcsched.h"
+
+static const adc_channel_t *adc_channels;
+static uint8_t adc_channel_count;
+// Bit n set when channel n is waiting for a conversion
+static uint8_t adc_pending;
+static uint16_t adc_results[ADC_SCHED_CHANNELS_MAX];
+// Configuration of ADC0 right now
+static uint8_t adc_refsel;
+static uint8_t adc_samplen;
+// Conversions since the last adc_sched_throughput()
+static uint16_t adc_conversions;
+static uint16_t adc_reference_count;
+
+void adc_sched_init(const adc_channel_t *channels, uint8_t count)
+{
+    adc_channels = channels;
+    adc_channel_count = count > ADC_SCHED_CHANNELS_MAX ?
+                        ADC_SCHED_CHANNELS_MAX : count;
+    adc_pending = 0;
+    adc_conversions = 0;
+    adc_reference_count = 0;
+    // Start from what the registers have, e.g. the reset values
+    adc_refsel = ADC0.CTRLC & ADC_REFSEL_gm;
+    adc_samplen = ADC0.SAMPCTRL;
+    // The hardware applies the delay when the reference changes
+    ADC0.CTRLD = (ADC0.CTRLD & ~ADC_INITDLY_gm) | ADC_SCHED_SETTLE_gc;
+}
+
+// Writes the registers that differ from the channel configuration
+static void adc_configure(const adc_channel_t *channel)
+{
+    if(channel->refsel != adc_refsel)
+    {
+        adc_refsel = channel->refsel;
+        ADC0.CTRLC = (ADC0.CTRLC & ~ADC_REFSEL_gm) | adc_refsel;
+        adc_reference_count++;
+    }
+    if(channel->samplen != adc_samplen)
+    {
+        adc_samplen = channel->samplen;
+        ADC0.SAMPCTRL = adc_samplen;
+    }
+    ADC0.MUXPOS = channel->muxpos;
+}
+
+// Next pending channel. The current reference comes first, the current
+// sample length second, so the channels of a group run back to back
+static uint8_t adc_next(void)
+{
+    uint8_t next = 0;
+    uint8_t best = 0;
+
+    for(uint8_t i = 0; i < adc_channel_count; i++)
+    {
+        uint8_t score;
+
+        if(!(adc_pending & (1 << i)))
+        {
+            continue;
+        }
+        score = 1;
+        if(adc_channels[i].refsel == adc_refsel)
+        {
+            score += 2;
+        }
+        if(adc_channels[i].samplen == adc_samplen)
+        {
+            score += 1;
+        }
+        if(score > best)
+        {
+            best = score;
+            next = i;
+        }
+    }
+    return next;
+}
+
+void adc_sched_request(uint8_t mask)
+{
+    adc_pending |= mask & (uint8_t)((1 << adc_channel_count) - 1);
+}
+
+uint8_t adc_sched_run(void)
+{
+    uint8_t converted = adc_pending;
+
+    while(adc_pending)
+    {
+        uint8_t channel = adc_next();
+
+        adc_configure(&adc_channels[channel]);
+        ADC0.INTFLAGS = ADC_RESRDY_bm;
+        ADC0.COMMAND = ADC_STCONV_bm;
+        // Wait for ADC0.INTFLAGS to get set
+        while(!(ADC0.INTFLAGS & ADC_RESRDY_bm))
+        {
+            ;
+        }
+        adc_results[channel] = ADC0.RES;
+        adc_pending &= ~(1 << channel);
+        adc_conversions++;
+    }
+    return converted;
+}
+
+uint16_t adc_sched_result(uint8_t channel)
+{
+    return adc_results[channel];
+}
+
+void adc_sched_select(uint8_t channel)
+{
+    adc_configure(&adc_channels[channel]);
+}
+
+uint16_t adc_sched_throughput(uint16_t elapsed_ms)
+{
+    uint32_t rate = 0;
+
+    if(elapsed_ms > 0)
+    {
+        rate = (uint32_t)adc_conversions * 1000 / elapsed_ms;
+    }
+    adc_conversions = 0;
+    return rate > 0xFFFF ? 0xFFFF : (uint16_t)rate;
+}
+
+uint16_t adc_sched_reference_changes(void)
+{
+    return adc_reference_count;
+}
@@ -0,0 +1,72 @@
+/*
+ * File:   jumptiming.c
+ * Author: Nevil Sandaradura
+ * Email: npsand@utu.fi
+ * Device:  ATmega4809 Curiosity Nano
+ * 
+ * Game speed estimate and press timing, see jumptiming.h.
+ * 
+ * Called from interrupts only, so no locking.
+ * 
+ * Created on October 19, 2026
+ */
+
+#include "jumptiming.h"
+
+// Durations of the last JUMP_WINDOW cacti, oldest overwritten first
+static uint16_t durations[JUMP_WINDOW];
+static uint8_t durations_next;
+// Shortest of durations
+static uint16_t shortest;
+
+void jump_timing_init(void)
+{
+    for(uint8_t i = 0; i < JUMP_WINDOW; i++)
+    {
+        durations[i] = JUMP_BASE_DURATION;
+    }
+    durations_next = 0;
+    shortest = JUMP_BASE_DURATION;
+}
+
+void jump_timing_obstacle(uint16_t duration)
+{
+    // A glitch halves the estimate at most, so it cannot ruin the next
+    // jumps before it leaves the window. Groups of cacti are longer and
+    // never the shortest.
+    if(duration < shortest / 2)
+    {
+        duration = shortest / 2;
+    }
+    durations[durations_next] = duration;
+    durations_next = (durations_next + 1) % JUMP_WINDOW;
+
+    shortest = 0xFFFF;
+    for(uint8_t i = 0; i < JUMP_WINDOW; i++)
+    {
+        if(durations[i] < shortest)
+        {
+            shortest = durations[i];
+        }
+    }
+}
+
+uint16_t jump_timing_duration(void)
+{
+    return shortest;
+}
+
+uint16_t jump_timing_press_delay(void)
+{
+    // Travel time from the LDR to the dino scales with the duration
+    uint32_t travel = (uint32_t)(JUMP_BASE_DELAY + JUMP_SERVO_LEAD) *
+                      jump_timing_duration() / JUMP_BASE_DURATION;
+
+    // Servo needs its lead time whatever the speed
+    if(travel <= JUMP_SERVO_LEAD)
+    {
+        return 0;
+    }
+    travel -= JUMP_SERVO_LEAD;
+    return travel > JUMP_PRESS_DELAY_MAX ? JUMP_PRESS_DELAY_MAX : travel;
+}
@@ -0,0 +1,48 @@
+/* 
+ * File:   jumptiming.h
+ * Author: Nevil Sandaradura
+ * Email: npsand@utu.fi
+ * Device:  ATmega4809 Curiosity Nano
+ * 
+ * Predicts when to press the spacebar from the game speed. The time a
+ * cactus keeps the LDR below the threshold is its width divided by the
+ * scroll speed. Cacti come in a few widths and groups, so an average of
+ * these durations depends on which cacti came. The narrowest cactus turns
+ * up often, so the shortest duration of the last JUMP_WINDOW cacti follows
+ * the speed instead. The time the cactus needs from the LDR to the dino
+ * scales with the same estimate, the servo travel time does not.
+ * 
+ * All times are RTC ticks (32768 Hz).
+ * 
+ * Created on October 19, 2026
+ */
+
+#ifndef JUMPTIMING_H
+#define	JUMPTIMING_H
+
+#include <stdint.h>
+
+// Time the narrowest cactus keeps the LDR dark at the start speed of the game
+#define JUMP_BASE_DURATION 1600
+// Number of the latest cacti the shortest duration is taken from
+#define JUMP_WINDOW 8
+// Delay from the leading edge of a cactus to the press at the start speed
+#define JUMP_BASE_DELAY 8192
+// Time from pressing to the servo hitting the spacebar, independent of speed
+#define JUMP_SERVO_LEAD 2048
+// Longest press delay. rtc_schedule_at() in main.c takes a compare time
+// as a signed 16-bit distance from now, so a delay of 0x8000 or more
+// would look past and the press would fire at once.
+#define JUMP_PRESS_DELAY_MAX 0x7FFF
+
+// Declaring functions
+void jump_timing_init(void);
+// Adds the time a cactus kept the LDR dark to the speed estimate
+void jump_timing_obstacle(uint16_t duration);
+// Current speed estimate, shortest duration of the last JUMP_WINDOW cacti
+uint16_t jump_timing_duration(void);
+// Delay from the leading edge of a cactus to pressing the spacebar, at
+// most JUMP_PRESS_DELAY_MAX
+uint16_t jump_timing_press_delay(void);
+
+#endif	/* JUMPTIMING_H */
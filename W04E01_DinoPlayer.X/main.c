@@ -12,6 +12,25 @@
  * display. When LDR readed value is less than or equal to 
  * threshold, servo operates.
  * 
+ * The ADC converts the LDR continuously and its window comparator raises an
+ * interrupt when the value is below the threshold, so the CPU sleeps while
+ * waiting for a cactus. The press and the return of the servo are timed by
+ * the RTC compare interrupt. The trimpot is read every 1/8 second.
+ * 
+ * The LDR uses the internal 2.5 V reference and the trimpot VDD, adcsched.c
+ * only rewrites REFSEL and waits for the reference to settle when the
+ * channel needs the other one.
+ * 
+ * The game speeds up, so the press delay is not fixed. The comparator also
+ * catches the trailing edge of the cactus, and jumptiming.c predicts the
+ * press time from how long the cacti keep the LDR dark.
+ * 
+ * With LATENCY_MODE set to 1 every press is logged to USART0 (9600 baud) in
+ * RTC ticks (30.5 us): detection to press, and press to the PWM period in
+ * which the servo gets the new pulse width, with the shortest recent cactus
+ * duration the press was timed with. Once a second it also logs the
+ * trimpot conversions and the reference changes.
+ * 
  * 
  * Note:
  * I use W02E01 wiring for the seven segment display.
@@ -26,34 +45,81 @@
 #include <avr/io.h>
 #include <avr/cpufunc.h>        // for ccp_write_io()
 #include <avr/interrupt.h>
+#include <avr/sleep.h>
+#include <stdlib.h>             // for utoa()
+
+#include "segdisplay.h"
+#include "jumptiming.h"
+#include "adcsched.h"
 
 // MACROS FOR DRIVING THE SERVO
 #define SERVO_PWM_PERIOD (0x1046)
 #define SERVO_PWM_DUTY_NEUTRAL (0x0138)
 #define SERVO_PWM_DUTY_MAX  (0x00D0) //0x01A0
 
-// Number 0-10 for the seven segment display. A is signifying number 10.
-const uint8_t digit[] =
-{
-    0b00111111,     // 0
-    0b00000110,
-    0b01011011,
-    0b01001111,
-    0b01100110,
-    0b01101101,     // 5
-    0b01111101,
-    0b00000111,
-    0b01111111,
-    0b01101111,     // 9
-    0b01110111      // A
-    
+// Servo timing in RTC ticks (32768 Hz), the press delay is in jumptiming.h
+// Time the spacebar is held down (125 ms)
+#define SERVO_HOLD_TIME 4096
+// Least ticks ahead the RTC compare can be set, it is synchronised to the
+// RTC clock
+#define RTC_MIN_AHEAD 3
+
+// 1 logs detect-to-servo latency to USART0
+#define LATENCY_MODE 0
+
+// Setting macro to apply BAUD RATE
+// Copied from Microchip's Getting Started with USART
+#define USART0_BAUD_RATE(BAUD_RATE) \
+((float)(3333333 * 64 / (16 *(float)BAUD_RATE)) + 0.5)
+
+// Channel numbers of the conversion scheduler
+#define ADC_LDR 0
+#define ADC_TRIMPOT 1
+
+// States of the servo
+typedef enum
+{
+    SERVO_IDLE,         // Waiting for a cactus
+    SERVO_PRESS_DUE,    // Cactus detected, press when RTC compare matches
+    SERVO_PRESSED       // Spacebar down, release when RTC compare matches
+} servo_state_t;
+
+// Edges of a cactus the window comparator watches for
+typedef enum
+{
+    WATCH_NONE,
+    WATCH_LEADING,      // LDR goes below the threshold
+    WATCH_TRAILING      // LDR comes back above the threshold
+} watch_t;
+
+volatile servo_state_t g_servo_state = SERVO_IDLE;
+// Set by the PIT interrupt when the trimpot should be read
+volatile uint8_t g_read_trimpot = 0;
+// LDR is being converted, the window comparator may be enabled
+volatile uint8_t g_ldr_running = 0;
+volatile watch_t g_watch = WATCH_LEADING;
+// RTC count at the leading edge of the last cactus
+volatile uint16_t g_leading_time;
+
+// LDR (PE0) with internal reference (2.5v), TRIMPOT (PF4) with VDD
+const adc_channel_t g_adc_channels[] =
+{
+    [ADC_LDR] = { ADC_MUXPOS_AIN8_gc, ADC_REFSEL_INTREF_gc, 0 },
+    [ADC_TRIMPOT] = { ADC_MUXPOS_AIN14_gc, ADC_REFSEL_VDDREF_gc, 0 }
 };
 
-// Global variable that checks if servo is returning to neutral position
-volatile uint8_t g_neutral = 0;
-// Global variable which tells if servo should move to 45 degree 
-// position to press spacebar
-volatile uint8_t g_press = 0;
+#if LATENCY_MODE == 1
+// RTC counts of the last press, written in the interrupts
+volatile uint16_t g_detect_time;
+volatile uint16_t g_press_time;
+volatile uint16_t g_pwm_time;
+// Average cactus duration the press was timed with
+volatile uint16_t g_press_duration;
+// Set when the PWM has the new pulse width and the times can be logged
+volatile uint8_t g_latency_ready = 0;
+// Trimpot reads since the last ADC log
+uint8_t g_adc_log_counter = 0;
+#endif
 
 
 /*
@@ -85,50 +151,152 @@ void rtc_init(void)
     // Configure RTC module
     // Select 32.768 kHz external oscillator
     RTC.CLKSEL = RTC_CLKSEL_TOSC32K_gc;
-    // Enable OVF interrupt
-    RTC.INTCTRL |= RTC_OVF_bm; 
+    // Free-running counter, servo moves are scheduled with the compare
+    // interrupt, which is enabled when a move is due
+    RTC.PER = 0xFFFF;
     // Enable RTC
     RTC.CTRLA = RTC_RTCEN_bm; 
+    // Periodic interrupt every 4096 cycles (1/8 second) to read the trimpot
+    RTC.PITINTCTRL = RTC_PI_bm;
+    RTC.PITCTRLA = RTC_PERIOD_CYC4096_gc | RTC_PITEN_bm;
+}
+
+// Schedules the RTC compare interrupt at the given RTC count, or as soon
+// as possible if that has passed
+void rtc_schedule_at(uint16_t time)
+{
+    // Wait for the compare register to be free
+    while(RTC.STATUS & RTC_CMPBUSY_bm);
+    uint16_t now = RTC.CNT;
+    if((int16_t)(time - now) < RTC_MIN_AHEAD)
+    {
+        time = now + RTC_MIN_AHEAD;
+    }
+    RTC.CMP = time;
+    RTC.INTFLAGS = RTC_CMP_bm;
+    RTC.INTCTRL |= RTC_CMP_bm;
 }
 
-uint16_t ldr_read(void)
+// Sets the edge the window comparator interrupts on. Called with
+// interrupts disabled, the hardware is only touched while the LDR is being
+// converted.
+void window_watch(watch_t watch)
 {
-    // Clear REFSEL
-    ADC0.CTRLC &= ~ADC_REFSEL_VDDREF_gc;
-    // Set voltagerefrence to internal (2.5v)
-    ADC0.CTRLC |= ADC_REFSEL_INTREF_gc;
-    // Change MUXPOS to AIN8 to read LDR (PE0)
-    ADC0.MUXPOS = ADC_MUXPOS_AIN8_gc;
-    // Start conversion
+    g_watch = watch;
+    if(!g_ldr_running)
+    {
+        return;
+    }
+    // LDR below WINLT is a cactus, above WINHT (WINLT - 1) is background
+    ADC0.CTRLE = watch == WATCH_TRAILING ? ADC_WINCM_ABOVE_gc :
+                 ADC_WINCM_BELOW_gc;
+    ADC0.INTFLAGS = ADC_WCMP_bm;
+    ADC0.INTCTRL = watch == WATCH_NONE ? 0 : ADC_WCMP_bm;
+}
+
+// Starts the continuous LDR conversions and the cactus detection
+void ldr_start(void)
+{
+    // Reference and MUXPOS of the LDR
+    adc_sched_select(ADC_LDR);
+    // Convert continuously
+    ADC0.CTRLA |= ADC_FREERUN_bm;
     ADC0.COMMAND = ADC_STCONV_bm;
-    // Wait for ADC0.INTFLAGS to get set
-    while (!(ADC0.INTFLAGS & ADC_RESRDY_bm));
-    // Return read value
-    return ADC0.RES;
+    
+    // Interrupts must not see the flag and the watched edge change apart
+    cli();
+    g_ldr_running = 1;
+    window_watch(g_watch);
+    sei();
+}
+
+// Stops the LDR conversions, so the ADC can read the trimpot
+void ldr_stop(void)
+{
+    cli();
+    g_ldr_running = 0;
+    // Trimpot result must not trigger the window comparator
+    ADC0.INTCTRL = 0;
+    sei();
+    // Stop continuous conversions, the current one finishes
+    ADC0.CTRLA &= ~ADC_FREERUN_bm;
+    while (ADC0.COMMAND & ADC_STCONV_bm);
 }
 
+// LDR conversions must be stopped
 uint16_t trimpot_read(void)
 {
-    // Clear REFSEL
-    ADC0.CTRLC &= ~ADC_REFSEL_VDDREF_gc;
-    // Set voltagerefrence to VDD (5v)
-    ADC0.CTRLC |= ADC_REFSEL_VDDREF_gc;
-    // Change MUXPOS to AIN14 to read TRIMPOT (PF4)
-    ADC0.MUXPOS = ADC_MUXPOS_AIN14_gc;
-    // Start conversion
-    ADC0.COMMAND = ADC_STCONV_bm;
-    // Wait for ADC0.INTFLAGS to get set
-    while (!(ADC0.INTFLAGS & ADC_RESRDY_bm));
+    adc_sched_request(1 << ADC_TRIMPOT);
+    adc_sched_run();
     // Return read value
-    return ADC0.RES;
+    return adc_sched_result(ADC_TRIMPOT);
 }
 
+#if LATENCY_MODE == 1
+// Copied from Microchip's Getting Started with USART
+// Used to write characters to serial terminal
+void USART0_sendChar(char c)
+{
+    while (!(USART0.STATUS & USART_DREIF_bm))
+    {
+        ;
+    }
+    USART0.TXDATAL = c;
+}
 
-int main(void)
+// Used to write strings to serial terminal
+void USART0_sendString(const char *str)
+{
+    while(*str != '\0')
+    {
+        USART0_sendChar(*str++);
+    }
+}
+
+// Function to initialize USART0 transmitter
+void USART0_init(void)
+{
+    // Setting PA0 as output (TX)
+    PORTA.DIRSET = PIN0_bm;
+    //Setting baud rate to 9600 using macro
+    USART0.BAUD = (uint16_t)USART0_BAUD_RATE(9600);
+    // Enable transmitter
+    USART0.CTRLB |= USART_TXEN_bm;
+}
+
+// Sends the times of the last press
+void latency_log(void)
 {
-    // Set entire PORTC (7-segment LED display) as output
-    PORTC.DIRSET = 0xFF;
+    char number[6];
     
+    USART0_sendString("LATENCY detect-press: ");
+    USART0_sendString(utoa((uint16_t)(g_press_time - g_detect_time),
+                           number, 10));
+    USART0_sendString("\tpress-pwm: ");
+    USART0_sendString(utoa((uint16_t)(g_pwm_time - g_press_time),
+                           number, 10));
+    USART0_sendString("\tduration: ");
+    USART0_sendString(utoa(g_press_duration, number, 10));
+    USART0_sendString("\r\n");
+}
+
+// Sends the trimpot conversions per second and the reference changes. The
+// free-running LDR conversions are not counted, adcsched.c does not run them.
+void adc_log(void)
+{
+    char number[6];
+
+    USART0_sendString("ADC trimpot conversions/s: ");
+    USART0_sendString(utoa(adc_sched_throughput(1000), number, 10));
+    USART0_sendString("\treference changes: ");
+    USART0_sendString(utoa(adc_sched_reference_changes(), number, 10));
+    USART0_sendString("\r\n");
+}
+#endif
+
+
+int main(void)
+{
     // SERVO
     // Route TCA0 PWM waveform to PORTB
     PORTMUX.TCAROUTEA |= PORTMUX_TCA0_PORTB_gc;
@@ -149,13 +317,9 @@ int main(void)
     
     
     
-    // Set PF5 (on-board LED) as output.
-    // Drives the 7-segment grounding transistor.
-    PORTF.DIRSET = PIN5_bm;
-
-    // Set PF5 HIGH to ground the 7-segment display
-    // (and turn off the on-board LED)
-    PORTF.OUTSET = PIN5_bm;
+    // 7-segment LED display, driven directly, PF5 switches on its
+    // grounding transistor
+    seg_init();
     
     // LDR
     // Set PE0 (AIN8) as input 
@@ -164,6 +328,10 @@ int main(void)
     PORTE.PIN0CTRL = PORT_ISC_INPUT_DISABLE_gc;
     // Set prescaler of 16
     ADC0.CTRLC |= ADC_PRESC_DIV16_gc;
+    // Scheduler sets the references and the settling delay
+    adc_sched_init(g_adc_channels,
+                   sizeof(g_adc_channels) / sizeof(g_adc_channels[0]));
+    // Window comparator mode is set by window_watch()
     // Enable ADC
     ADC0.CTRLA |= ADC_ENABLE_bm;
     // Set internal reference voltage to 2.5V
@@ -176,58 +344,144 @@ int main(void)
     // Disable input buffer
     PORTF.PIN4CTRL = PORT_ISC_INPUT_DISABLE_gc;
     
+#if LATENCY_MODE == 1
+    // Latency log to serial terminal
+    USART0_init();
+#endif
+    
     // Initialise RTC
     rtc_init();
+    // Game starts at its lowest speed
+    jump_timing_init();
+    
+    // First threshold, the LDR conversions start after it
+    g_read_trimpot = 1;
+    
+    // CPU sleeps until the next interrupt
+    set_sleep_mode(SLPCTRL_SMODE_IDLE_gc);
 
     // Enable interrupts
     sei();
 
     while (1)
     {
-        // Read the LDR and divide it by 100
-        uint16_t ldr_value = ldr_read() / 100;
-        // Read the trimpot and divide it by 100
-        uint16_t threshold = trimpot_read() / 100;
-        // Display threshold on the seven segment display
-        VPORTC.OUT = digit[threshold];
-        
-        // Checks if LDR value is less than or equal to the threshold value
-        if(!g_neutral && ldr_value <= threshold)
+        if(g_read_trimpot)
+        {
+            g_read_trimpot = 0;
+            ldr_stop();
+            // Read the trimpot and divide it by 100
+            uint16_t threshold = trimpot_read() / 100;
+            // Display threshold on the seven segment display.
+            // A is signifying number 10.
+            seg_set_char(threshold < 10 ? '0' + threshold : 'A');
+            // LDR value divided by 100 is less than or equal to the
+            // threshold when the LDR value is below the next hundred
+            ADC0.WINLT = (threshold + 1) * 100;
+            ADC0.WINHT = threshold * 100 + 99;
+            ldr_start();
+#if LATENCY_MODE == 1
+            // The PIT reads the trimpot 8 times a second
+            if(++g_adc_log_counter >= 8)
+            {
+                g_adc_log_counter = 0;
+                adc_log();
+            }
+#endif
+        }
+#if LATENCY_MODE == 1
+        if(g_latency_ready)
         {
-            g_press = 1;
-            // Wait for the clock to stabilise
-            while(RTC.STATUS > 0);
-            // Set perioid to 8192 for 250ms delay before clicking spacebar
-            RTC.PER = 8192;
+            g_latency_ready = 0;
+            latency_log();
         }
+#endif
+        // Re-enter sleep mode after every interrupt wake-up
+        sleep_mode();
     }
 }
 
 
+ISR(ADC0_WCOMP_vect)
+{
+    uint16_t now = RTC.CNT;
+    
+    // Clear interrupt flag
+    ADC0.INTFLAGS = ADC_WCMP_bm;
+    if(g_watch == WATCH_LEADING)
+    {
+        // Cactus reached the LDR
+        g_leading_time = now;
+#if LATENCY_MODE == 1
+        g_detect_time = now;
+#endif
+        g_servo_state = SERVO_PRESS_DUE;
+        // Press with the speed known so far, corrected at the trailing edge
+        rtc_schedule_at(now + jump_timing_press_delay());
+        window_watch(WATCH_TRAILING);
+    }
+    else
+    {
+        // Cactus passed the LDR, its duration updates the game speed
+        jump_timing_obstacle(now - g_leading_time);
+        if(g_servo_state == SERVO_PRESS_DUE)
+        {
+            rtc_schedule_at(g_leading_time + jump_timing_press_delay());
+        }
+        // Next cactus is watched for after the press
+        window_watch(g_servo_state == SERVO_IDLE ? WATCH_LEADING :
+                     WATCH_NONE);
+    }
+}
+
 ISR(RTC_CNT_vect)
 {
     // Clear interrupt flags
-    RTC.INTFLAGS = RTC_OVF_bm;
+    RTC.INTFLAGS = RTC_CMP_bm;
     // Check if the servo should press the spacebar
-    if(!g_neutral && g_press)
+    if(g_servo_state == SERVO_PRESS_DUE)
     {
         // Set servo to 45 degree
         TCA0.SINGLE.CMP2BUF = SERVO_PWM_DUTY_MAX;
-        // Set g_press to 0 after servo is operated
-        g_press = 0;
-        // Set g_neutral to 1 to set the servo to neutral position
-        g_neutral = 1;
-        // Wait for the clock to stabilise
-        while(RTC.STATUS > 0);
-        // Set perioid to 4096 to wait for ~100ms
-        RTC.PER = 4096;
+#if LATENCY_MODE == 1
+        g_press_time = RTC.CNT;
+        g_press_duration = jump_timing_duration();
+        TCA0.SINGLE.INTFLAGS = TCA_SINGLE_OVF_bm;
+        TCA0.SINGLE.INTCTRL = TCA_SINGLE_OVF_bm;
+#endif
+        g_servo_state = SERVO_PRESSED;
+        // Wait to release spacebar
+        rtc_schedule_at(RTC.CNT + SERVO_HOLD_TIME);
     }
     else
     {
         // Set servo to neutral position
         TCA0.SINGLE.CMP2BUF = SERVO_PWM_DUTY_NEUTRAL;
-        // Set g_neutral to 0 after servo is returned to neutral position
-        g_neutral = 0;
+        RTC.INTCTRL &= ~RTC_CMP_bm;
+        g_servo_state = SERVO_IDLE;
+        // Watch for the next cactus, unless the trailing edge of this one
+        // has not come yet
+        if(g_watch == WATCH_NONE)
+        {
+            window_watch(WATCH_LEADING);
+        }
     }
-    
 }
+
+ISR(RTC_PIT_vect)
+{
+    // Clear interrupt flag
+    RTC.PITINTFLAGS = RTC_PI_bm;
+    // Main loop reads the trimpot
+    g_read_trimpot = 1;
+}
+
+#if LATENCY_MODE == 1
+ISR(TCA0_OVF_vect)
+{
+    // Buffered pulse width is in use from this period on
+    TCA0.SINGLE.INTFLAGS = TCA_SINGLE_OVF_bm;
+    TCA0.SINGLE.INTCTRL = 0;
+    g_pwm_time = RTC.CNT;
+    g_latency_ready = 1;
+}
+#endif
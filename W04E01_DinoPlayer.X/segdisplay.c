@@ -0,0 +1,70 @@
+/*
+ * File:   segdisplay.c
+ * Author: Nevil Sandaradura
+ * Email: npsand@utu.fi
+ * Device:  ATmega4809 Curiosity Nano
+ * 
+ * Seven segment display driver, see segdisplay.h.
+ * 
+ * Created on October 19, 2026
+ */
+
+#include <avr/io.h>
+#include <avr/pgmspace.h>
+
+#include "segdisplay.h"
+
+// Segment patterns of ASCII 0x20-0x7F, letters as close as seven segments
+// allow, kept in flash
+static const uint8_t seg_font[96] PROGMEM =
+{
+    0x00, 0x86, 0x22, 0x7E, 0x6D, 0xD2, 0x46, 0x20, // space ! " # $ % & '
+    0x29, 0x0B, 0x21, 0x70, 0x10, 0x40, 0x80, 0x52, // ( ) * + , - . /
+    0x3F, 0x06, 0x5B, 0x4F, 0x66, 0x6D, 0x7D, 0x07, // 0-7
+    0x7F, 0x6F, 0x09, 0x0D, 0x61, 0x48, 0x43, 0xD3, // 8 9 : ; < = > ?
+    0x5F, 0x77, 0x7C, 0x39, 0x5E, 0x79, 0x71, 0x3D, // @ A-G
+    0x76, 0x30, 0x1E, 0x75, 0x38, 0x15, 0x37, 0x3F, // H-O
+    0x73, 0x6B, 0x33, 0x6D, 0x78, 0x3E, 0x3E, 0x2A, // P-W
+    0x76, 0x6E, 0x5B, 0x39, 0x64, 0x0F, 0x23, 0x08, // X Y Z [ \ ] ^ _
+    0x02, 0x5F, 0x7C, 0x58, 0x5E, 0x7B, 0x71, 0x6F, // ` a-g
+    0x74, 0x10, 0x0C, 0x75, 0x30, 0x14, 0x54, 0x5C, // h-o
+    0x73, 0x67, 0x50, 0x6D, 0x78, 0x1C, 0x1C, 0x14, // p-w
+    0x76, 0x6E, 0x5B, 0x46, 0x30, 0x70, 0x01, 0x00  // x y z { | } ~ DEL
+};
+
+void seg_init(void)
+{
+    // Segment and digit select pins as outputs, segments dark
+    SEG_SEGMENT_VPORT.DIR = 0xFF;
+    SEG_SEGMENT_VPORT.OUT = 0x00;
+    SEG_DIGIT_VPORT.DIR |= SEG_DIGIT_PIN;
+    SEG_DIGIT_VPORT.OUT |= SEG_DIGIT_PIN;
+}
+
+void seg_set_lit(uint8_t lit)
+{
+    if(lit)
+    {
+        SEG_DIGIT_VPORT.OUT |= SEG_DIGIT_PIN;
+    }
+    else
+    {
+        SEG_DIGIT_VPORT.OUT &= ~SEG_DIGIT_PIN;
+    }
+}
+
+void seg_set_segments(uint8_t segments)
+{
+    SEG_SEGMENT_VPORT.OUT = segments;
+}
+
+void seg_set_char(char c)
+{
+    uint8_t segments = 0x00;
+
+    if(c >= 0x20 && c <= 0x7F)
+    {
+        segments = pgm_read_byte(&seg_font[c - 0x20]);
+    }
+    seg_set_segments(segments);
+}
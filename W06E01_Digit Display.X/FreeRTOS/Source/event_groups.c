@@ -61,6 +61,16 @@
     #define eventEVENT_BITS_CONTROL_BYTES    0xff000000UL
 #endif
 
+#if ( configUSE_EVENT_GROUP_WAITER_BUCKETS == 1 )
+
+/* The number of event bits, which is the number of waiter buckets. */
+    #if configUSE_16_BIT_TICKS == 1
+        #define eventNUMBER_OF_BUCKETS    8U
+    #else
+        #define eventNUMBER_OF_BUCKETS    24U
+    #endif
+#endif
+
 typedef struct EventGroupDef_t
 {
     EventBits_t uxEventBits;
@@ -73,6 +83,15 @@ typedef struct EventGroupDef_t
     #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
         uint8_t ucStaticallyAllocated; /*< Set to pdTRUE if the event group is statically allocated to ensure no attempt is made to free the memory. */
     #endif
+
+    #if ( configUSE_EVENT_GROUP_WAITER_BUCKETS == 1 )
+        List_t xTasksWaitingForBit[ eventNUMBER_OF_BUCKETS ]; /*< Tasks that cannot be unblocked until a particular bit is set, indexed by that bit.  xTasksWaitingForBits then only holds tasks waiting for any one of several bits. */
+    #endif
+
+    #if ( configUSE_EVENT_GROUP_DIRECT_FROM_ISR == 1 )
+        EventBits_t uxBitsSetFromISR; /*< Bits set by interrupts while the event group was locked, set by the task that unlocks it. */
+        volatile uint8_t ucLockCount; /*< Non-zero while a task accesses the event bits or the waiting task lists with the scheduler suspended, which interrupts must then leave alone. */
+    #endif
 } EventGroup_t;
 
 /*-----------------------------------------------------------*/
@@ -89,6 +108,85 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits,
                                         const EventBits_t uxBitsToWaitFor,
                                         const BaseType_t xWaitForAllBits ) PRIVILEGED_FUNCTION;
 
+/*
+ * Unblock the tasks in pxList whose wait condition is met by the current
+ * event bits.  Returns the bits to clear because an unblocked task asked for
+ * them to be cleared on exit.  Must be called with the scheduler suspended.
+ */
+static EventBits_t prvUnblockWaiters( EventGroup_t * pxEventBits,
+                                      List_t const * pxList,
+                                      BaseType_t * pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/*
+ * Set the bits and unblock the tasks that are waiting for them.  Called with
+ * the scheduler suspended and pxHigherPriorityTaskWoken NULL from tasks, or
+ * from a critical section with pxHigherPriorityTaskWoken pointing to the flag
+ * to set if a task with a priority above the current task is unblocked.
+ */
+static void prvSetBits( EventGroup_t * pxEventBits,
+                        const EventBits_t uxBitsToSet,
+                        BaseType_t * pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unblock every task in pxList, used when the event group is deleted.
+ */
+static void prvUnblockAllWaiters( List_t const * pxList ) PRIVILEGED_FUNCTION;
+
+#if ( configUSE_EVENT_GROUP_WAITER_BUCKETS == 1 )
+
+/*
+ * Select the list a task waiting for uxBitsToWaitFor blocks on.  A task that
+ * needs a particular bit before it can be unblocked - all the bits, or a
+ * single bit - is placed in the bucket of the lowest bit it is still missing,
+ * and is only tested again when that bit gets set.  A task waiting for any one
+ * of several bits stays in xTasksWaitingForBits, which is tested every time
+ * bits are set.
+ */
+    static List_t * prvGetWaiterList( EventGroup_t * pxEventBits,
+                                      const EventBits_t uxBitsToWaitFor,
+                                      const EventBits_t uxCurrentEventBits,
+                                      const BaseType_t xWaitForAllBits ) PRIVILEGED_FUNCTION;
+
+#else /* if ( configUSE_EVENT_GROUP_WAITER_BUCKETS == 1 ) */
+
+    #define prvGetWaiterList( pxEventBits, uxBitsToWaitFor, uxCurrentEventBits, xWaitForAllBits )    ( &( ( pxEventBits )->xTasksWaitingForBits ) )
+
+#endif /* configUSE_EVENT_GROUP_WAITER_BUCKETS */
+
+#if ( configUSE_EVENT_GROUP_DIRECT_FROM_ISR == 1 )
+
+/*
+ * Locks an event group.  Interrupts do not access a locked event group, they
+ * leave the bits they set in uxBitsSetFromISR instead.  Locks nest, and must
+ * only be taken with the scheduler suspended.  Interrupts only read the lock
+ * count, so as with uxSchedulerSuspended no critical section is needed.
+ */
+    #define prvLockEventGroup( pxEventBits )  \
+    {                                         \
+        ++( ( pxEventBits )->ucLockCount );   \
+        portMEMORY_BARRIER();                 \
+    }
+
+/*
+ * Unlocks an event group.  The last unlock sets the bits that interrupts set
+ * while the event group was locked, unblocking any tasks waiting for them.
+ */
+    static void prvUnlockEventGroup( EventGroup_t * pxEventBits ) PRIVILEGED_FUNCTION;
+
+/*
+ * The number of waiting tasks that setting uxBitsToSet would have to test.
+ */
+    static UBaseType_t prvGetWaiterCount( EventGroup_t const * pxEventBits,
+                                          const EventBits_t uxBitsToSet ) PRIVILEGED_FUNCTION;
+
+#else /* if ( configUSE_EVENT_GROUP_DIRECT_FROM_ISR == 1 ) */
+
+/* Interrupts do not access event groups, only the scheduler lock is needed. */
+    #define prvLockEventGroup( pxEventBits )
+    #define prvUnlockEventGroup( pxEventBits )
+
+#endif /* configUSE_EVENT_GROUP_DIRECT_FROM_ISR */
+
 /*-----------------------------------------------------------*/
 
 #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
@@ -118,6 +216,24 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits,
             pxEventBits->uxEventBits = 0;
             vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
 
+            #if ( configUSE_EVENT_GROUP_WAITER_BUCKETS == 1 )
+                {
+                    UBaseType_t uxBit;
+
+                    for( uxBit = 0; uxBit < eventNUMBER_OF_BUCKETS; uxBit++ )
+                    {
+                        vListInitialise( &( pxEventBits->xTasksWaitingForBit[ uxBit ] ) );
+                    }
+                }
+            #endif
+
+            #if ( configUSE_EVENT_GROUP_DIRECT_FROM_ISR == 1 )
+                {
+                    pxEventBits->uxBitsSetFromISR = 0;
+                    pxEventBits->ucLockCount = 0;
+                }
+            #endif
+
             #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
                 {
                     /* Both static and dynamic allocation can be used, so note that
@@ -169,6 +285,24 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits,
             pxEventBits->uxEventBits = 0;
             vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
 
+            #if ( configUSE_EVENT_GROUP_WAITER_BUCKETS == 1 )
+                {
+                    UBaseType_t uxBit;
+
+                    for( uxBit = 0; uxBit < eventNUMBER_OF_BUCKETS; uxBit++ )
+                    {
+                        vListInitialise( &( pxEventBits->xTasksWaitingForBit[ uxBit ] ) );
+                    }
+                }
+            #endif
+
+            #if ( configUSE_EVENT_GROUP_DIRECT_FROM_ISR == 1 )
+                {
+                    pxEventBits->uxBitsSetFromISR = 0;
+                    pxEventBits->ucLockCount = 0;
+                }
+            #endif
+
             #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
                 {
                     /* Both static and dynamic allocation can be used, so note this
@@ -210,6 +344,7 @@ EventBits_t xEventGroupSync( EventGroupHandle_t xEventGroup,
     #endif
 
     vTaskSuspendAll();
+    prvLockEventGroup( pxEventBits );
     {
         uxOriginalBitValue = pxEventBits->uxEventBits;
 
@@ -235,7 +370,7 @@ EventBits_t xEventGroupSync( EventGroupHandle_t xEventGroup,
                 /* Store the bits that the calling task is waiting for in the
                  * task's event list item so the kernel knows when a match is
                  * found.  Then enter the blocked state. */
-                vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ), xTicksToWait );
+                vTaskPlaceOnUnorderedEventList( prvGetWaiterList( pxEventBits, uxBitsToWaitFor, pxEventBits->uxEventBits, pdTRUE ), ( uxBitsToWaitFor | eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ), xTicksToWait );
 
                 /* This assignment is obsolete as uxReturn will get set after
                  * the task unblocks, but some compilers mistakenly generate a
@@ -252,6 +387,7 @@ EventBits_t xEventGroupSync( EventGroupHandle_t xEventGroup,
             }
         }
     }
+    prvUnlockEventGroup( pxEventBits );
     xAlreadyYielded = xTaskResumeAll();
 
     if( xTicksToWait != ( TickType_t ) 0 )
@@ -337,6 +473,7 @@ EventBits_t xEventGroupWaitBits( EventGroupHandle_t xEventGroup,
     #endif
 
     vTaskSuspendAll();
+    prvLockEventGroup( pxEventBits );
     {
         const EventBits_t uxCurrentEventBits = pxEventBits->uxEventBits;
 
@@ -394,7 +531,7 @@ EventBits_t xEventGroupWaitBits( EventGroupHandle_t xEventGroup,
             /* Store the bits that the calling task is waiting for in the
              * task's event list item so the kernel knows when a match is
              * found.  Then enter the blocked state. */
-            vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
+            vTaskPlaceOnUnorderedEventList( prvGetWaiterList( pxEventBits, uxBitsToWaitFor, uxCurrentEventBits, xWaitForAllBits ), ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
 
             /* This is obsolete as it will get set after the task unblocks, but
              * some compilers mistakenly generate a warning about the variable
@@ -404,6 +541,7 @@ EventBits_t xEventGroupWaitBits( EventGroupHandle_t xEventGroup,
             traceEVENT_GROUP_WAIT_BITS_BLOCK( xEventGroup, uxBitsToWaitFor );
         }
     }
+    prvUnlockEventGroup( pxEventBits );
     xAlreadyYielded = xTaskResumeAll();
 
     if( xTicksToWait != ( TickType_t ) 0 )
@@ -533,92 +671,21 @@ EventBits_t xEventGroupGetBitsFromISR( EventGroupHandle_t xEventGroup )
 EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup,
                                 const EventBits_t uxBitsToSet )
 {
-    ListItem_t * pxListItem, * pxNext;
-    ListItem_t const * pxListEnd;
-    List_t const * pxList;
-    EventBits_t uxBitsToClear = 0, uxBitsWaitedFor, uxControlBits;
     EventGroup_t * pxEventBits = xEventGroup;
-    BaseType_t xMatchFound = pdFALSE;
 
     /* Check the user is not attempting to set the bits used by the kernel
      * itself. */
     configASSERT( xEventGroup );
     configASSERT( ( uxBitsToSet & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
 
-    pxList = &( pxEventBits->xTasksWaitingForBits );
-    pxListEnd = listGET_END_MARKER( pxList ); /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
     vTaskSuspendAll();
+    prvLockEventGroup( pxEventBits );
     {
         traceEVENT_GROUP_SET_BITS( xEventGroup, uxBitsToSet );
 
-        pxListItem = listGET_HEAD_ENTRY( pxList );
-
-        /* Set the bits. */
-        pxEventBits->uxEventBits |= uxBitsToSet;
-
-        /* See if the new bit value should unblock any tasks. */
-        while( pxListItem != pxListEnd )
-        {
-            pxNext = listGET_NEXT( pxListItem );
-            uxBitsWaitedFor = listGET_LIST_ITEM_VALUE( pxListItem );
-            xMatchFound = pdFALSE;
-
-            /* Split the bits waited for from the control bits. */
-            uxControlBits = uxBitsWaitedFor & eventEVENT_BITS_CONTROL_BYTES;
-            uxBitsWaitedFor &= ~eventEVENT_BITS_CONTROL_BYTES;
-
-            if( ( uxControlBits & eventWAIT_FOR_ALL_BITS ) == ( EventBits_t ) 0 )
-            {
-                /* Just looking for single bit being set. */
-                if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) != ( EventBits_t ) 0 )
-                {
-                    xMatchFound = pdTRUE;
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
-            }
-            else if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) == uxBitsWaitedFor )
-            {
-                /* All bits are set. */
-                xMatchFound = pdTRUE;
-            }
-            else
-            {
-                /* Need all bits to be set, but not all the bits were set. */
-            }
-
-            if( xMatchFound != pdFALSE )
-            {
-                /* The bits match.  Should the bits be cleared on exit? */
-                if( ( uxControlBits & eventCLEAR_EVENTS_ON_EXIT_BIT ) != ( EventBits_t ) 0 )
-                {
-                    uxBitsToClear |= uxBitsWaitedFor;
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
-
-                /* Store the actual event flag value in the task's event list
-                 * item before removing the task from the event list.  The
-                 * eventUNBLOCKED_DUE_TO_BIT_SET bit is set so the task knows
-                 * that is was unblocked due to its required bits matching, rather
-                 * than because it timed out. */
-                vTaskRemoveFromUnorderedEventList( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET );
-            }
-
-            /* Move onto the next list item.  Note pxListItem->pxNext is not
-             * used here as the list item may have been removed from the event list
-             * and inserted into the ready/pending reading list. */
-            pxListItem = pxNext;
-        }
-
-        /* Clear any bits that matched when the eventCLEAR_EVENTS_ON_EXIT_BIT
-         * bit was set in the control word. */
-        pxEventBits->uxEventBits &= ~uxBitsToClear;
+        prvSetBits( pxEventBits, uxBitsToSet, NULL );
     }
+    prvUnlockEventGroup( pxEventBits );
     ( void ) xTaskResumeAll();
 
     return pxEventBits->uxEventBits;
@@ -628,23 +695,25 @@ EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup,
 void vEventGroupDelete( EventGroupHandle_t xEventGroup )
 {
     EventGroup_t * pxEventBits = xEventGroup;
-    const List_t * pxTasksWaitingForBits;
 
     configASSERT( pxEventBits );
 
-    pxTasksWaitingForBits = &( pxEventBits->xTasksWaitingForBits );
-
     vTaskSuspendAll();
     {
         traceEVENT_GROUP_DELETE( xEventGroup );
 
-        while( listCURRENT_LIST_LENGTH( pxTasksWaitingForBits ) > ( UBaseType_t ) 0 )
-        {
-            /* Unblock the task, returning 0 as the event list is being deleted
-             * and cannot therefore have any bits set. */
-            configASSERT( pxTasksWaitingForBits->xListEnd.pxNext != ( const ListItem_t * ) &( pxTasksWaitingForBits->xListEnd ) );
-            vTaskRemoveFromUnorderedEventList( pxTasksWaitingForBits->xListEnd.pxNext, eventUNBLOCKED_DUE_TO_BIT_SET );
-        }
+        prvUnblockAllWaiters( &( pxEventBits->xTasksWaitingForBits ) );
+
+        #if ( configUSE_EVENT_GROUP_WAITER_BUCKETS == 1 )
+            {
+                UBaseType_t uxBit;
+
+                for( uxBit = 0; uxBit < eventNUMBER_OF_BUCKETS; uxBit++ )
+                {
+                    prvUnblockAllWaiters( &( pxEventBits->xTasksWaitingForBit[ uxBit ] ) );
+                }
+            }
+        #endif
 
         #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
             {
@@ -726,7 +795,338 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits,
 }
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
+static EventBits_t prvUnblockWaiters( EventGroup_t * pxEventBits,
+                                      List_t const * pxList,
+                                      BaseType_t * pxHigherPriorityTaskWoken )
+{
+    ListItem_t * pxListItem, * pxNext;
+    ListItem_t const * pxListEnd;
+    EventBits_t uxBitsToClear = 0, uxBitsWaitedFor, uxControlBits;
+    BaseType_t xMatchFound;
+
+    pxListEnd = listGET_END_MARKER( pxList ); /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+    pxListItem = listGET_HEAD_ENTRY( pxList );
+
+    while( pxListItem != pxListEnd )
+    {
+        pxNext = listGET_NEXT( pxListItem );
+        uxBitsWaitedFor = listGET_LIST_ITEM_VALUE( pxListItem );
+        xMatchFound = pdFALSE;
+
+        /* Split the bits waited for from the control bits. */
+        uxControlBits = uxBitsWaitedFor & eventEVENT_BITS_CONTROL_BYTES;
+        uxBitsWaitedFor &= ~eventEVENT_BITS_CONTROL_BYTES;
+
+        if( ( uxControlBits & eventWAIT_FOR_ALL_BITS ) == ( EventBits_t ) 0 )
+        {
+            /* Just looking for single bit being set. */
+            if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) != ( EventBits_t ) 0 )
+            {
+                xMatchFound = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) == uxBitsWaitedFor )
+        {
+            /* All bits are set. */
+            xMatchFound = pdTRUE;
+        }
+        else
+        {
+            /* Need all bits to be set, but not all the bits were set. */
+            #if ( configUSE_EVENT_GROUP_WAITER_BUCKETS == 1 )
+                {
+                    if( pxList != &( pxEventBits->xTasksWaitingForBits ) )
+                    {
+                        /* The bit the task was filed under is now set, file it
+                         * under a bit it is still missing.  That bit is not
+                         * being set, so the task is not tested again in this
+                         * call. */
+                        ( void ) uxListRemove( pxListItem );
+                        vListInsertEnd( prvGetWaiterList( pxEventBits, uxBitsWaitedFor, pxEventBits->uxEventBits, pdTRUE ), pxListItem );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            #endif /* configUSE_EVENT_GROUP_WAITER_BUCKETS */
+        }
+
+        if( xMatchFound != pdFALSE )
+        {
+            /* The bits match.  Should the bits be cleared on exit? */
+            if( ( uxControlBits & eventCLEAR_EVENTS_ON_EXIT_BIT ) != ( EventBits_t ) 0 )
+            {
+                uxBitsToClear |= uxBitsWaitedFor;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* Store the actual event flag value in the task's event list
+             * item before removing the task from the event list.  The
+             * eventUNBLOCKED_DUE_TO_BIT_SET bit is set so the task knows
+             * that is was unblocked due to its required bits matching, rather
+             * than because it timed out. */
+            #if ( configUSE_EVENT_GROUP_DIRECT_FROM_ISR == 1 )
+                if( pxHigherPriorityTaskWoken != NULL )
+                {
+                    if( xTaskRemoveFromUnorderedEventListFromISR( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET ) != pdFALSE )
+                    {
+                        *pxHigherPriorityTaskWoken = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+            #endif /* configUSE_EVENT_GROUP_DIRECT_FROM_ISR */
+            {
+                vTaskRemoveFromUnorderedEventList( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET );
+            }
+        }
+
+        /* Move onto the next list item.  Note pxListItem->pxNext is not
+         * used here as the list item may have been removed from the event list
+         * and inserted into the ready/pending reading list. */
+        pxListItem = pxNext;
+    }
+
+    #if ( configUSE_EVENT_GROUP_DIRECT_FROM_ISR == 0 )
+        {
+            ( void ) pxHigherPriorityTaskWoken;
+        }
+    #endif
+
+    return uxBitsToClear;
+}
+/*-----------------------------------------------------------*/
+
+static void prvSetBits( EventGroup_t * pxEventBits,
+                        const EventBits_t uxBitsToSet,
+                        BaseType_t * pxHigherPriorityTaskWoken )
+{
+    EventBits_t uxBitsToClear = 0;
+
+    /* Set the bits. */
+    pxEventBits->uxEventBits |= uxBitsToSet;
+
+    /* See if the new bit value should unblock any tasks. */
+    #if ( configUSE_EVENT_GROUP_WAITER_BUCKETS == 1 )
+        {
+            EventBits_t uxBitsLeft;
+            UBaseType_t uxBit;
+
+            /* Only the buckets of the bits being set can hold tasks that
+             * are now unblocked. */
+            for( uxBit = 0, uxBitsLeft = uxBitsToSet; uxBitsLeft != ( EventBits_t ) 0; uxBit++, uxBitsLeft >>= 1 )
+            {
+                if( ( uxBitsLeft & ( EventBits_t ) 1 ) != ( EventBits_t ) 0 )
+                {
+                    uxBitsToClear |= prvUnblockWaiters( pxEventBits, &( pxEventBits->xTasksWaitingForBit[ uxBit ] ), pxHigherPriorityTaskWoken );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+    #endif /* configUSE_EVENT_GROUP_WAITER_BUCKETS */
+
+    uxBitsToClear |= prvUnblockWaiters( pxEventBits, &( pxEventBits->xTasksWaitingForBits ), pxHigherPriorityTaskWoken );
+
+    /* Clear any bits that matched when the eventCLEAR_EVENTS_ON_EXIT_BIT
+     * bit was set in the control word. */
+    pxEventBits->uxEventBits &= ~uxBitsToClear;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EVENT_GROUP_DIRECT_FROM_ISR == 1 )
+
+    static void prvUnlockEventGroup( EventGroup_t * pxEventBits )
+    {
+        EventBits_t uxBitsSetFromISR;
+        BaseType_t xUnlocked = pdFALSE;
+
+        /* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED. */
+
+        while( xUnlocked == pdFALSE )
+        {
+            taskENTER_CRITICAL();
+            {
+                uxBitsSetFromISR = pxEventBits->uxBitsSetFromISR;
+
+                if( ( pxEventBits->ucLockCount > ( uint8_t ) 1 ) || ( uxBitsSetFromISR == ( EventBits_t ) 0 ) )
+                {
+                    pxEventBits->ucLockCount--;
+                    xUnlocked = pdTRUE;
+                }
+                else
+                {
+                    pxEventBits->uxBitsSetFromISR = 0;
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            if( xUnlocked == pdFALSE )
+            {
+                /* Interrupts set bits while the event group was locked.  Set
+                 * them now, still locked, then check again. */
+                prvSetBits( pxEventBits, uxBitsSetFromISR, NULL );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    }
+
+#endif /* configUSE_EVENT_GROUP_DIRECT_FROM_ISR */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EVENT_GROUP_DIRECT_FROM_ISR == 1 )
+
+    static UBaseType_t prvGetWaiterCount( EventGroup_t const * pxEventBits,
+                                          const EventBits_t uxBitsToSet )
+    {
+        UBaseType_t uxCount = listCURRENT_LIST_LENGTH( &( pxEventBits->xTasksWaitingForBits ) );
+
+        #if ( configUSE_EVENT_GROUP_WAITER_BUCKETS == 1 )
+            {
+                EventBits_t uxBitsLeft;
+                UBaseType_t uxBit;
+
+                for( uxBit = 0, uxBitsLeft = uxBitsToSet; uxBitsLeft != ( EventBits_t ) 0; uxBit++, uxBitsLeft >>= 1 )
+                {
+                    if( ( uxBitsLeft & ( EventBits_t ) 1 ) != ( EventBits_t ) 0 )
+                    {
+                        uxCount += listCURRENT_LIST_LENGTH( &( pxEventBits->xTasksWaitingForBit[ uxBit ] ) );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+        #else
+            {
+                ( void ) uxBitsToSet;
+            }
+        #endif /* configUSE_EVENT_GROUP_WAITER_BUCKETS */
+
+        return uxCount;
+    }
+
+#endif /* configUSE_EVENT_GROUP_DIRECT_FROM_ISR */
+/*-----------------------------------------------------------*/
+
+static void prvUnblockAllWaiters( List_t const * pxList )
+{
+    while( listCURRENT_LIST_LENGTH( pxList ) > ( UBaseType_t ) 0 )
+    {
+        /* Unblock the task, returning 0 as the event list is being deleted
+         * and cannot therefore have any bits set. */
+        configASSERT( pxList->xListEnd.pxNext != ( const ListItem_t * ) &( pxList->xListEnd ) );
+        vTaskRemoveFromUnorderedEventList( pxList->xListEnd.pxNext, eventUNBLOCKED_DUE_TO_BIT_SET );
+    }
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EVENT_GROUP_WAITER_BUCKETS == 1 )
+
+    static List_t * prvGetWaiterList( EventGroup_t * pxEventBits,
+                                      const EventBits_t uxBitsToWaitFor,
+                                      const EventBits_t uxCurrentEventBits,
+                                      const BaseType_t xWaitForAllBits )
+    {
+        List_t * pxList;
+        EventBits_t uxBitsMissing;
+        UBaseType_t uxBit;
+
+        if( ( xWaitForAllBits == pdFALSE ) && ( ( uxBitsToWaitFor & ( uxBitsToWaitFor - ( EventBits_t ) 1 ) ) != ( EventBits_t ) 0 ) )
+        {
+            /* Any one of several bits unblocks the task. */
+            pxList = &( pxEventBits->xTasksWaitingForBits );
+        }
+        else
+        {
+            /* The wait condition is not met, so at least one bit is missing. */
+            uxBitsMissing = uxBitsToWaitFor & ~uxCurrentEventBits;
+            configASSERT( uxBitsMissing != ( EventBits_t ) 0 );
+
+            for( uxBit = 0; ( uxBitsMissing & ( EventBits_t ) 1 ) == ( EventBits_t ) 0; uxBit++ )
+            {
+                uxBitsMissing >>= 1;
+            }
+
+            pxList = &( pxEventBits->xTasksWaitingForBit[ uxBit ] );
+        }
+
+        return pxList;
+    }
+
+#endif /* configUSE_EVENT_GROUP_WAITER_BUCKETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EVENT_GROUP_DIRECT_FROM_ISR == 1 )
+
+    BaseType_t xEventGroupSetBitsFromISR( EventGroupHandle_t xEventGroup,
+                                          const EventBits_t uxBitsToSet,
+                                          BaseType_t * pxHigherPriorityTaskWoken )
+    {
+        EventGroup_t * pxEventBits = xEventGroup;
+        UBaseType_t uxSavedInterruptStatus;
+        BaseType_t xReturn = pdPASS, xDefer = pdFALSE, xTaskWoken = pdFALSE;
+
+        configASSERT( xEventGroup );
+        configASSERT( ( uxBitsToSet & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
+
+        traceEVENT_GROUP_SET_BITS_FROM_ISR( xEventGroup, uxBitsToSet );
+
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            if( pxEventBits->ucLockCount != ( uint8_t ) 0 )
+            {
+                /* A task is accessing the event group, it sets the bits when
+                 * it unlocks the event group. */
+                pxEventBits->uxBitsSetFromISR |= uxBitsToSet;
+            }
+            else if( prvGetWaiterCount( pxEventBits, uxBitsToSet ) <= ( UBaseType_t ) configEVENT_GROUP_ISR_MAX_WAITERS )
+            {
+                prvSetBits( pxEventBits, uxBitsToSet, &xTaskWoken );
+            }
+            else
+            {
+                xDefer = pdTRUE;
+            }
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+        if( xDefer != pdFALSE )
+        {
+            /* Too many tasks to test in an interrupt, have the timer task set
+             * the bits. */
+            xReturn = xTimerPendFunctionCallFromISR( vEventGroupSetBitsCallback, ( void * ) xEventGroup, ( uint32_t ) uxBitsToSet, pxHigherPriorityTaskWoken ); /*lint !e9087 Can't avoid cast to void* as a generic callback function not specific to this use case. Callback casts back to original type so safe. */
+        }
+        else if( ( xTaskWoken != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+        {
+            *pxHigherPriorityTaskWoken = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+
+#elif ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
 
     BaseType_t xEventGroupSetBitsFromISR( EventGroupHandle_t xEventGroup,
                                           const EventBits_t uxBitsToSet,
@@ -740,7 +1140,7 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits,
         return xReturn;
     }
 
-#endif /* if ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) ) */
+#endif /* if ( configUSE_EVENT_GROUP_DIRECT_FROM_ISR == 1 ) */
 /*-----------------------------------------------------------*/
 
 #if ( configUSE_TRACE_FACILITY == 1 )
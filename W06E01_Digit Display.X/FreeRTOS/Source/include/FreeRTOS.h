@@ -790,6 +790,12 @@
     #define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime )
 #endif
 
+#ifndef portIDLE_TASK_HOOK
+    /* Called on every iteration of the idle task loop.  Ports that emulate
+     * the passing of time let the time of one iteration pass here. */
+    #define portIDLE_TASK_HOOK()
+#endif
+
 #ifndef configEXPECTED_IDLE_TIME_BEFORE_SLEEP
     #define configEXPECTED_IDLE_TIME_BEFORE_SLEEP    2
 #endif
@@ -915,6 +921,41 @@
     #define configRUN_TIME_COUNTER_TYPE    uint32_t
 #endif
 
+#ifndef configUSE_STREAM_BUFFER_IDLE_TIMEOUT
+
+/* Set to 1 to allow a stream buffer reader to be unblocked when a gap in the
+ * incoming data is detected, as well as when the trigger level is reached.
+ * See xStreamBufferSetIdleTimeout(). */
+    #define configUSE_STREAM_BUFFER_IDLE_TIMEOUT    0
+#endif
+
+#ifndef configUSE_EVENT_GROUP_WAITER_BUCKETS
+
+/* Set to 1 to keep an event group's blocked tasks in one list per event bit,
+ * so setting bits only tests the tasks that wait for those bits rather than
+ * every task blocked on the group.  Costs one list per event bit in every
+ * event group. */
+    #define configUSE_EVENT_GROUP_WAITER_BUCKETS    0
+#endif
+
+#ifndef configUSE_EVENT_GROUP_DIRECT_FROM_ISR
+
+/* Set to 1 to have xEventGroupSetBitsFromISR() set the bits and unblock the
+ * waiting tasks in the interrupt itself, instead of deferring the set to the
+ * timer task.  A set that would have to test more than
+ * configEVENT_GROUP_ISR_MAX_WAITERS tasks is still deferred, which bounds the
+ * time spent in the interrupt. */
+    #define configUSE_EVENT_GROUP_DIRECT_FROM_ISR    0
+#endif
+
+#ifndef configEVENT_GROUP_ISR_MAX_WAITERS
+    #define configEVENT_GROUP_ISR_MAX_WAITERS    4
+#endif
+
+#if ( ( configUSE_EVENT_GROUP_DIRECT_FROM_ISR == 1 ) && ( ( configUSE_TIMERS == 0 ) || ( INCLUDE_xTimerPendFunctionCall == 0 ) ) )
+    #error configUSE_EVENT_GROUP_DIRECT_FROM_ISR requires configUSE_TIMERS and INCLUDE_xTimerPendFunctionCall to be set to 1, to defer sets that exceed configEVENT_GROUP_ISR_MAX_WAITERS.
+#endif
+
 #ifndef configMESSAGE_BUFFER_LENGTH_TYPE
 
 /* Defaults to size_t for backward compatibility, but can be overridden
@@ -1297,6 +1338,19 @@ typedef struct xSTATIC_EVENT_GROUP
     #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
         uint8_t ucDummy4;
     #endif
+
+    #if ( configUSE_EVENT_GROUP_WAITER_BUCKETS == 1 )
+        #if ( configUSE_16_BIT_TICKS == 1 )
+            StaticList_t xDummy5[ 8 ];
+        #else
+            StaticList_t xDummy5[ 24 ];
+        #endif
+    #endif
+
+    #if ( configUSE_EVENT_GROUP_DIRECT_FROM_ISR == 1 )
+        TickType_t xDummy6;
+        uint8_t ucDummy7;
+    #endif
 } StaticEventGroup_t;
 
 /*
@@ -1348,11 +1402,65 @@ typedef struct xSTATIC_STREAM_BUFFER
     #if ( configUSE_TRACE_FACILITY == 1 )
         UBaseType_t uxDummy4;
     #endif
+    #if ( configUSE_STREAM_BUFFER_IDLE_TIMEOUT == 1 )
+        TickType_t xDummy5[ 2 ];
+    #endif
 } StaticStreamBuffer_t;
 
 /* Message buffers are built on stream buffers. */
 typedef StaticStreamBuffer_t StaticMessageBuffer_t;
 
+/*
+ * In line with software engineering best practice, FreeRTOS implements a strict
+ * data hiding policy, so the real memory pool structure is not accessible to
+ * the application.  However, if the application writer wants to statically
+ * allocate the memory required to create a memory pool then the size of the
+ * memory pool object needs to be known.  The StaticMemoryPool_t structure below
+ * is provided for this purpose.  Its size and alignment requirements are
+ * guaranteed to match those of the genuine structure, no matter how the values
+ * in FreeRTOSConfig.h are set.  Its contents are somewhat obfuscated in the hope
+ * users will recognise that it would be unwise to make direct use of the
+ * structure members.
+ */
+typedef struct xSTATIC_MEMORY_POOL
+{
+    void * pvDummy1[ 2 ];
+    size_t xDummy2;
+    UBaseType_t uxDummy3[ 3 ];
+    void * pvDummy4;
+
+    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+        StaticSemaphore_t xDummy5;
+    #endif
+
+    #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+        uint8_t ucDummy6;
+    #endif
+} StaticMemoryPool_t;
+
+/*
+ * In line with software engineering best practice, FreeRTOS implements a strict
+ * data hiding policy, so the real sequence lock structure is not accessible to
+ * the application.  However, if the application writer wants to statically
+ * allocate the memory required to create a sequence lock then the size of the
+ * sequence lock object needs to be known.  The StaticSeqLock_t structure below
+ * is provided for this purpose.  Its size and alignment requirements are
+ * guaranteed to match those of the genuine structure, no matter how the values
+ * in FreeRTOSConfig.h are set.  Its contents are somewhat obfuscated in the hope
+ * users will recognise that it would be unwise to make direct use of the
+ * structure members.
+ */
+typedef struct xSTATIC_SEQUENCE_LOCK
+{
+    UBaseType_t uxDummy1;
+    void * pvDummy2;
+    size_t xDummy3;
+
+    #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+        uint8_t ucDummy4;
+    #endif
+} StaticSeqLock_t;
+
 /* *INDENT-OFF* */
 #ifdef __cplusplus
     }
@@ -0,0 +1,363 @@
+/*
+ * FreeRTOS Kernel V10.4.6
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Memory pools provide fixed size blocks of RAM from a pre-sized area.  A block
+ * is obtained and returned in constant time from either a task or an
+ * interrupt, and a task can block until a block becomes free.  As the blocks
+ * do not move, a pointer to a block can be passed through a queue in place of
+ * copying the data it holds - the receiver frees the block when done with it.
+ *
+ * Memory pools use a counting semaphore to track the free blocks, so
+ * configUSE_COUNTING_SEMAPHORES must be set to 1 in FreeRTOSConfig.h, and
+ * FreeRTOS/source/mempool.c must be included in the build.
+ */
+
+#ifndef MEMORY_POOL_H
+#define MEMORY_POOL_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include mempool.h"
+#endif
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * Type by which memory pools are referenced.  For example, a call to
+ * xMemoryPoolCreate() returns a MemoryPoolHandle_t variable that can then be
+ * used as a parameter to pvMemoryPoolAlloc(), vMemoryPoolFree(), etc.
+ */
+struct MemoryPoolDef_t;
+typedef struct MemoryPoolDef_t * MemoryPoolHandle_t;
+
+/**
+ * mempool.h
+ *
+ * @code{c}
+ * MemoryPoolHandle_t xMemoryPoolCreate( UBaseType_t uxBlockCount, size_t xBlockSize );
+ * @endcode
+ *
+ * Creates a memory pool of uxBlockCount blocks, each able to hold xBlockSize
+ * bytes, using RAM allocated from the FreeRTOS heap.  Each block is rounded up
+ * to a multiple of portBYTE_ALIGNMENT, and to at least the size of a pointer,
+ * so the address of every block is suitably aligned for any type.
+ *
+ * configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h for
+ * xMemoryPoolCreate() to be available.
+ *
+ * @param uxBlockCount The number of blocks in the pool.
+ *
+ * @param xBlockSize The size of each block in bytes.
+ *
+ * @return If the pool was created then a handle to the pool is returned.  If
+ * there was insufficient FreeRTOS heap available then NULL is returned.
+ *
+ * Example use:
+ * @code{c}
+ * void vAFunction( void )
+ * {
+ * MemoryPoolHandle_t xSamplePool;
+ *
+ *  // Create a pool of four buffers, each holding 32 ADC samples.
+ *  xSamplePool = xMemoryPoolCreate( 4, 32 * sizeof( uint16_t ) );
+ *
+ *  if( xSamplePool == NULL )
+ *  {
+ *      // There was not enough heap memory space available to create the
+ *      // memory pool.
+ *  }
+ * }
+ * @endcode
+ * \defgroup xMemoryPoolCreate xMemoryPoolCreate
+ * \ingroup MemoryPoolManagement
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    MemoryPoolHandle_t xMemoryPoolCreate( UBaseType_t uxBlockCount,
+                                          size_t xBlockSize ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * mempool.h
+ *
+ * @code{c}
+ * MemoryPoolHandle_t xMemoryPoolCreateStatic( UBaseType_t uxBlockCount,
+ *                                             size_t xBlockSize,
+ *                                             uint8_t *pucPoolStorageArea,
+ *                                             StaticMemoryPool_t *pxStaticMemoryPool );
+ * @endcode
+ *
+ * Creates a memory pool using RAM provided by the application.
+ *
+ * @param uxBlockCount The number of blocks in the pool.
+ *
+ * @param xBlockSize The size of each block in bytes.  Must already be a
+ * multiple of portBYTE_ALIGNMENT and at least sizeof( void * ) -
+ * mpoolBLOCK_SIZE() rounds a size up to meet both requirements.
+ *
+ * @param pucPoolStorageArea An array of at least
+ * ( uxBlockCount * xBlockSize ) bytes, aligned to portBYTE_ALIGNMENT, that
+ * holds the blocks.
+ *
+ * @param pxStaticMemoryPool A StaticMemoryPool_t variable used to hold the
+ * pool's data structure.
+ *
+ * @return If neither pucPoolStorageArea nor pxStaticMemoryPool are NULL then a
+ * handle to the created pool is returned, otherwise NULL is returned.
+ *
+ * Example use:
+ * @code{c}
+ * #define SAMPLE_BLOCK_SIZE     mpoolBLOCK_SIZE( 32 * sizeof( uint16_t ) )
+ * #define SAMPLE_BLOCK_COUNT    4
+ *
+ * static uint8_t ucSampleStorage[ SAMPLE_BLOCK_COUNT * SAMPLE_BLOCK_SIZE ];
+ * static StaticMemoryPool_t xSamplePoolStruct;
+ *
+ * void vAFunction( void )
+ * {
+ * MemoryPoolHandle_t xSamplePool;
+ *
+ *  xSamplePool = xMemoryPoolCreateStatic( SAMPLE_BLOCK_COUNT,
+ *                                         SAMPLE_BLOCK_SIZE,
+ *                                         ucSampleStorage,
+ *                                         &xSamplePoolStruct );
+ * }
+ * @endcode
+ * \defgroup xMemoryPoolCreateStatic xMemoryPoolCreateStatic
+ * \ingroup MemoryPoolManagement
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    MemoryPoolHandle_t xMemoryPoolCreateStatic( UBaseType_t uxBlockCount,
+                                                size_t xBlockSize,
+                                                uint8_t * pucPoolStorageArea,
+                                                StaticMemoryPool_t * pxStaticMemoryPool ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * mempool.h
+ *
+ * Rounds xSize up to the size each block of a pool actually occupies.  Use it
+ * to size the storage area passed to xMemoryPoolCreateStatic().
+ */
+#define mpoolBLOCK_SIZE( xSize )                                                                \
+    ( ( ( ( xSize ) < sizeof( void * ) ? sizeof( void * ) : ( xSize ) ) + portBYTE_ALIGNMENT_MASK ) \
+      & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) )
+
+/**
+ * mempool.h
+ *
+ * @code{c}
+ * void vMemoryPoolDelete( MemoryPoolHandle_t xMemoryPool );
+ * @endcode
+ *
+ * Deletes a memory pool.  If the pool was created with xMemoryPoolCreate()
+ * its RAM is returned to the FreeRTOS heap.  No task may be blocked on the
+ * pool, and no block from the pool may be used after the pool is deleted.
+ *
+ * @param xMemoryPool The handle of the memory pool to be deleted.
+ *
+ * \defgroup vMemoryPoolDelete vMemoryPoolDelete
+ * \ingroup MemoryPoolManagement
+ */
+void vMemoryPoolDelete( MemoryPoolHandle_t xMemoryPool ) PRIVILEGED_FUNCTION;
+
+/**
+ * mempool.h
+ *
+ * @code{c}
+ * void * pvMemoryPoolAlloc( MemoryPoolHandle_t xMemoryPool, TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Takes a block from a memory pool.  If the pool is empty the calling task
+ * can optionally wait in the Blocked state for another task or an interrupt to
+ * free a block.  When several tasks are waiting, the highest priority task is
+ * given the next block that is freed.
+ *
+ * @param xMemoryPool The handle of the memory pool to take a block from.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in the
+ * Blocked state waiting for a block to be freed.  Setting xTicksToWait to
+ * portMAX_DELAY will cause the task to wait indefinitely, provided
+ * INCLUDE_vTaskSuspend is set to 1 in FreeRTOSConfig.h.
+ *
+ * @return A pointer to the block, or NULL if no block became free before the
+ * block time expired.
+ *
+ * Example use:
+ * @code{c}
+ * void vProducerTask( void *pvParameters )
+ * {
+ * uint16_t *pusSamples;
+ *
+ *  for( ;; )
+ *  {
+ *      // Wait up to 10ms for a free buffer.
+ *      pusSamples = pvMemoryPoolAlloc( xSamplePool, pdMS_TO_TICKS( 10 ) );
+ *
+ *      if( pusSamples != NULL )
+ *      {
+ *          vFillBuffer( pusSamples );
+ *
+ *          // Pass ownership of the buffer, rather than its contents, to the
+ *          // consumer.  The consumer calls vMemoryPoolFree() when done.
+ *          xQueueSend( xSampleQueue, &pusSamples, portMAX_DELAY );
+ *      }
+ *  }
+ * }
+ * @endcode
+ * \defgroup pvMemoryPoolAlloc pvMemoryPoolAlloc
+ * \ingroup MemoryPoolManagement
+ */
+void * pvMemoryPoolAlloc( MemoryPoolHandle_t xMemoryPool,
+                          TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * mempool.h
+ *
+ * @code{c}
+ * void * pvMemoryPoolAllocFromISR( MemoryPoolHandle_t xMemoryPool );
+ * @endcode
+ *
+ * A version of pvMemoryPoolAlloc() that can be called from an interrupt
+ * service routine.  It never blocks.
+ *
+ * @param xMemoryPool The handle of the memory pool to take a block from.
+ *
+ * @return A pointer to the block, or NULL if the pool is empty.
+ *
+ * \defgroup pvMemoryPoolAllocFromISR pvMemoryPoolAllocFromISR
+ * \ingroup MemoryPoolManagement
+ */
+void * pvMemoryPoolAllocFromISR( MemoryPoolHandle_t xMemoryPool ) PRIVILEGED_FUNCTION;
+
+/**
+ * mempool.h
+ *
+ * @code{c}
+ * void vMemoryPoolFree( MemoryPoolHandle_t xMemoryPool, void *pvBlock );
+ * @endcode
+ *
+ * Returns a block to the memory pool it was taken from.  If a task is blocked
+ * waiting for a block it is unblocked.
+ *
+ * @param xMemoryPool The handle of the memory pool the block belongs to.
+ *
+ * @param pvBlock A block previously returned by pvMemoryPoolAlloc() or
+ * pvMemoryPoolAllocFromISR() for the same pool.
+ *
+ * \defgroup vMemoryPoolFree vMemoryPoolFree
+ * \ingroup MemoryPoolManagement
+ */
+void vMemoryPoolFree( MemoryPoolHandle_t xMemoryPool,
+                      void * pvBlock ) PRIVILEGED_FUNCTION;
+
+/**
+ * mempool.h
+ *
+ * @code{c}
+ * void vMemoryPoolFreeFromISR( MemoryPoolHandle_t xMemoryPool,
+ *                              void *pvBlock,
+ *                              BaseType_t *pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of vMemoryPoolFree() that can be called from an interrupt service
+ * routine.
+ *
+ * @param xMemoryPool The handle of the memory pool the block belongs to.
+ *
+ * @param pvBlock The block being returned.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if freeing the block
+ * unblocked a task with a priority higher than the interrupted task, in which
+ * case a context switch should be requested before the interrupt exits.
+ * *pxHigherPriorityTaskWoken should be set to pdFALSE before it is passed in.
+ *
+ * \defgroup vMemoryPoolFreeFromISR vMemoryPoolFreeFromISR
+ * \ingroup MemoryPoolManagement
+ */
+void vMemoryPoolFreeFromISR( MemoryPoolHandle_t xMemoryPool,
+                             void * pvBlock,
+                             BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * mempool.h
+ *
+ * @code{c}
+ * UBaseType_t uxMemoryPoolGetFreeCount( MemoryPoolHandle_t xMemoryPool );
+ * @endcode
+ *
+ * @return The number of blocks currently free in the pool.
+ *
+ * \defgroup uxMemoryPoolGetFreeCount uxMemoryPoolGetFreeCount
+ * \ingroup MemoryPoolManagement
+ */
+UBaseType_t uxMemoryPoolGetFreeCount( MemoryPoolHandle_t xMemoryPool ) PRIVILEGED_FUNCTION;
+
+/**
+ * mempool.h
+ *
+ * @code{c}
+ * UBaseType_t uxMemoryPoolGetMinimumEverFreeCount( MemoryPoolHandle_t xMemoryPool );
+ * @endcode
+ *
+ * The high water mark of a pool - the number of blocks that were still free
+ * when the pool was at its fullest.  A value of 0 means that at some point
+ * every block was in use, so an allocation may have failed or waited.
+ *
+ * @return The lowest number of free blocks seen since the pool was created.
+ *
+ * \defgroup uxMemoryPoolGetMinimumEverFreeCount uxMemoryPoolGetMinimumEverFreeCount
+ * \ingroup MemoryPoolManagement
+ */
+UBaseType_t uxMemoryPoolGetMinimumEverFreeCount( MemoryPoolHandle_t xMemoryPool ) PRIVILEGED_FUNCTION;
+
+/**
+ * mempool.h
+ *
+ * @code{c}
+ * size_t xMemoryPoolGetBlockSize( MemoryPoolHandle_t xMemoryPool );
+ * @endcode
+ *
+ * @return The usable size of each block in the pool, which may be larger than
+ * the size requested when the pool was created.
+ *
+ * \defgroup xMemoryPoolGetBlockSize xMemoryPoolGetBlockSize
+ * \ingroup MemoryPoolManagement
+ */
+size_t xMemoryPoolGetBlockSize( MemoryPoolHandle_t xMemoryPool ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* !defined( MEMORY_POOL_H ) */
@@ -0,0 +1,316 @@
+/*
+ * FreeRTOS Kernel V10.4.6
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * A sequence lock holds a small snapshot of plain data - a set of sensor
+ * readings for example - that one writer updates and any number of readers
+ * copy.  The writer increments a sequence counter before and after each
+ * update.  Readers copy the snapshot without taking any lock and copy it again
+ * if the counter shows the snapshot changed while it was being copied, so
+ * readers never block each other or the writer.
+ *
+ * There must only ever be one writer, which can be a task or an interrupt.
+ * The snapshot is copied a byte at a time, so sequence locks suit snapshots
+ * of a few tens of bytes at most.
+ *
+ * FreeRTOS/source/seqlock.c must be included in the build.
+ */
+
+#ifndef SEQUENCE_LOCK_H
+#define SEQUENCE_LOCK_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include seqlock.h"
+#endif
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * Type by which sequence locks are referenced.  For example, a call to
+ * xSeqLockCreate() returns a SeqLockHandle_t variable that can then be used as
+ * a parameter to vSeqLockWrite(), uxSeqLockRead(), etc.
+ */
+struct SeqLockDef_t;
+typedef struct SeqLockDef_t * SeqLockHandle_t;
+
+/**
+ * seqlock.h
+ *
+ * @code{c}
+ * SeqLockHandle_t xSeqLockCreate( size_t xDataSize );
+ * @endcode
+ *
+ * Creates a sequence lock holding a snapshot of xDataSize bytes, using RAM
+ * allocated from the FreeRTOS heap.  The snapshot is initially all zeros.
+ *
+ * configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h for
+ * xSeqLockCreate() to be available.
+ *
+ * @param xDataSize The size of the snapshot in bytes.
+ *
+ * @return If the sequence lock was created then a handle to it is returned.
+ * If there was insufficient FreeRTOS heap available then NULL is returned.
+ *
+ * Example use:
+ * @code{c}
+ * typedef struct
+ * {
+ *  uint16_t usLight;
+ *  uint16_t usTemperature;
+ * } Readings_t;
+ *
+ * SeqLockHandle_t xReadingsLock;
+ *
+ * void vAFunction( void )
+ * {
+ *  xReadingsLock = xSeqLockCreate( sizeof( Readings_t ) );
+ *
+ *  if( xReadingsLock == NULL )
+ *  {
+ *      // There was not enough heap memory space available to create the
+ *      // sequence lock.
+ *  }
+ * }
+ * @endcode
+ * \defgroup xSeqLockCreate xSeqLockCreate
+ * \ingroup SeqLockManagement
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    SeqLockHandle_t xSeqLockCreate( size_t xDataSize ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * seqlock.h
+ *
+ * @code{c}
+ * SeqLockHandle_t xSeqLockCreateStatic( size_t xDataSize,
+ *                                       uint8_t *pucDataStorageArea,
+ *                                       StaticSeqLock_t *pxStaticSeqLock );
+ * @endcode
+ *
+ * Creates a sequence lock using RAM provided by the application.  The
+ * snapshot is initially all zeros.
+ *
+ * @param xDataSize The size of the snapshot in bytes.
+ *
+ * @param pucDataStorageArea An array of at least xDataSize bytes that holds
+ * the snapshot.
+ *
+ * @param pxStaticSeqLock A StaticSeqLock_t variable used to hold the sequence
+ * lock's data structure.
+ *
+ * @return If neither pucDataStorageArea nor pxStaticSeqLock are NULL then a
+ * handle to the created sequence lock is returned, otherwise NULL is returned.
+ *
+ * Example use:
+ * @code{c}
+ * static uint8_t ucReadingsStorage[ sizeof( Readings_t ) ];
+ * static StaticSeqLock_t xReadingsLockStruct;
+ *
+ * void vAFunction( void )
+ * {
+ *  xReadingsLock = xSeqLockCreateStatic( sizeof( Readings_t ),
+ *                                        ucReadingsStorage,
+ *                                        &xReadingsLockStruct );
+ * }
+ * @endcode
+ * \defgroup xSeqLockCreateStatic xSeqLockCreateStatic
+ * \ingroup SeqLockManagement
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    SeqLockHandle_t xSeqLockCreateStatic( size_t xDataSize,
+                                          uint8_t * pucDataStorageArea,
+                                          StaticSeqLock_t * pxStaticSeqLock ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * seqlock.h
+ *
+ * @code{c}
+ * void vSeqLockDelete( SeqLockHandle_t xSeqLock );
+ * @endcode
+ *
+ * Deletes a sequence lock.  If it was created with xSeqLockCreate() its RAM is
+ * returned to the FreeRTOS heap.
+ *
+ * @param xSeqLock The handle of the sequence lock to be deleted.
+ *
+ * \defgroup vSeqLockDelete vSeqLockDelete
+ * \ingroup SeqLockManagement
+ */
+void vSeqLockDelete( SeqLockHandle_t xSeqLock ) PRIVILEGED_FUNCTION;
+
+/**
+ * seqlock.h
+ *
+ * @code{c}
+ * void vSeqLockWrite( SeqLockHandle_t xSeqLock, const void *pvData );
+ * @endcode
+ *
+ * Replaces the snapshot with the xDataSize bytes pointed to by pvData.  Must
+ * only be called by the one task that writes to the sequence lock.  The
+ * scheduler is suspended while the snapshot is updated, so no reading task
+ * can run in the middle of the update.  Interrupts are not disabled.
+ *
+ * @param xSeqLock The handle of the sequence lock being written.
+ *
+ * @param pvData The new snapshot.
+ *
+ * Example use:
+ * @code{c}
+ * void vSamplingTask( void * pvParameters )
+ * {
+ * Readings_t xReadings;
+ *
+ *  for( ;; )
+ *  {
+ *      xReadings.usLight = usReadLight();
+ *      xReadings.usTemperature = usReadTemperature();
+ *      vSeqLockWrite( xReadingsLock, &xReadings );
+ *      vTaskDelay( pdMS_TO_TICKS( 100 ) );
+ *  }
+ * }
+ * @endcode
+ * \defgroup vSeqLockWrite vSeqLockWrite
+ * \ingroup SeqLockManagement
+ */
+void vSeqLockWrite( SeqLockHandle_t xSeqLock,
+                    const void * pvData ) PRIVILEGED_FUNCTION;
+
+/**
+ * seqlock.h
+ *
+ * @code{c}
+ * void vSeqLockWriteFromISR( SeqLockHandle_t xSeqLock, const void *pvData );
+ * @endcode
+ *
+ * A version of vSeqLockWrite() for a sequence lock that is written by an
+ * interrupt.  Writing never unblocks a task, so there is no
+ * pxHigherPriorityTaskWoken parameter.
+ *
+ * @param xSeqLock The handle of the sequence lock being written.
+ *
+ * @param pvData The new snapshot.
+ *
+ * \defgroup vSeqLockWriteFromISR vSeqLockWriteFromISR
+ * \ingroup SeqLockManagement
+ */
+void vSeqLockWriteFromISR( SeqLockHandle_t xSeqLock,
+                           const void * pvData ) PRIVILEGED_FUNCTION;
+
+/**
+ * seqlock.h
+ *
+ * @code{c}
+ * UBaseType_t uxSeqLockRead( SeqLockHandle_t xSeqLock, void *pvBuffer );
+ * @endcode
+ *
+ * Copies the snapshot into pvBuffer.  The copy is repeated until it was not
+ * overlapped by a write, which can only happen when the writer preempted the
+ * reading task during the copy.  Must not be called from an interrupt, use
+ * xSeqLockReadFromISR() instead.
+ *
+ * @param xSeqLock The handle of the sequence lock being read.
+ *
+ * @param pvBuffer A buffer of at least xDataSize bytes that receives the
+ * snapshot.
+ *
+ * @return The sequence number of the snapshot copied.  The sequence number
+ * changes on every write, so comparing it with the value returned by the
+ * previous read tells whether the snapshot is new.  The sequence number is a
+ * UBaseType_t that wraps, so on 8-bit ports it repeats every 128 writes.
+ *
+ * Example use:
+ * @code{c}
+ * void vDisplayTask( void * pvParameters )
+ * {
+ * Readings_t xReadings;
+ * UBaseType_t uxLastSequence = 0, uxSequence;
+ *
+ *  for( ;; )
+ *  {
+ *      uxSequence = uxSeqLockRead( xReadingsLock, &xReadings );
+ *
+ *      if( uxSequence != uxLastSequence )
+ *      {
+ *          uxLastSequence = uxSequence;
+ *          vShowReadings( &xReadings );
+ *      }
+ *
+ *      vTaskDelay( pdMS_TO_TICKS( 50 ) );
+ *  }
+ * }
+ * @endcode
+ * \defgroup uxSeqLockRead uxSeqLockRead
+ * \ingroup SeqLockManagement
+ */
+UBaseType_t uxSeqLockRead( SeqLockHandle_t xSeqLock,
+                           void * pvBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * seqlock.h
+ *
+ * @code{c}
+ * BaseType_t xSeqLockReadFromISR( SeqLockHandle_t xSeqLock,
+ *                                 void *pvBuffer,
+ *                                 UBaseType_t *puxSequence );
+ * @endcode
+ *
+ * A version of uxSeqLockRead() that can be called from an interrupt.  An
+ * interrupt cannot wait for the write it interrupted to finish, so the read
+ * fails instead of being repeated if a write is in progress.
+ *
+ * @param xSeqLock The handle of the sequence lock being read.
+ *
+ * @param pvBuffer A buffer of at least xDataSize bytes that receives the
+ * snapshot.  Its contents are undefined if the read fails.
+ *
+ * @param puxSequence Set to the sequence number of the snapshot copied, see
+ * uxSeqLockRead().  Can be NULL.
+ *
+ * @return pdPASS if the snapshot was copied, or pdFAIL if the interrupt
+ * occurred while the snapshot was being written.
+ *
+ * \defgroup xSeqLockReadFromISR xSeqLockReadFromISR
+ * \ingroup SeqLockManagement
+ */
+BaseType_t xSeqLockReadFromISR( SeqLockHandle_t xSeqLock,
+                                void * pvBuffer,
+                                UBaseType_t * puxSequence ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* !defined( SEQUENCE_LOCK_H ) */
@@ -0,0 +1,502 @@
+/*
+ * FreeRTOS Kernel V10.4.6
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "mempool.h"
+
+#if ( configUSE_COUNTING_SEMAPHORES != 1 )
+    #error configUSE_COUNTING_SEMAPHORES must be set to 1 to build mempool.c
+#endif
+
+/* Lint e961, e750 and e9021 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021 See comment above. */
+
+/* Free blocks are held in a singly linked list threaded through the blocks
+ * themselves, so the pool needs no RAM per block beyond the blocks. */
+typedef struct xMEMORY_POOL_FREE_BLOCK
+{
+    struct xMEMORY_POOL_FREE_BLOCK * pxNext;
+} MemoryPoolFreeBlock_t;
+
+typedef struct MemoryPoolDef_t
+{
+    MemoryPoolFreeBlock_t * pxFreeList;   /*< The first free block, or NULL if every block is in use. */
+    uint8_t * pucStorage;                 /*< The first block - used to validate blocks being freed. */
+    size_t xBlockSize;                    /*< The size of each block, already rounded up by mpoolBLOCK_SIZE(). */
+    UBaseType_t uxBlockCount;             /*< The number of blocks in the pool. */
+    volatile UBaseType_t uxFreeCount;     /*< The number of blocks in pxFreeList. */
+    UBaseType_t uxMinimumEverFreeCount;   /*< The lowest value uxFreeCount has held. */
+    SemaphoreHandle_t xBlocksAvailable;   /*< Counting semaphore holding one count per free block, on which allocating tasks block. */
+
+    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+        StaticSemaphore_t xSemaphoreBuffer; /*< Storage for xBlocksAvailable, so no further allocation is needed. */
+    #endif
+
+    #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+        uint8_t ucStaticallyAllocated; /*< Set to pdTRUE if the memory pool is statically allocated to ensure no attempt is made to free the memory. */
+    #endif
+} MemoryPool_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Called by both xMemoryPoolCreate() and xMemoryPoolCreateStatic() to thread
+ * every block onto the free list and create the semaphore.  Returns pdFAIL if
+ * the semaphore could not be created.
+ */
+static BaseType_t prvInitialiseNewMemoryPool( MemoryPool_t * pxMemoryPool,
+                                              UBaseType_t uxBlockCount,
+                                              size_t xBlockSize,
+                                              uint8_t * pucStorage ) PRIVILEGED_FUNCTION;
+
+/*
+ * Removes the first block from the free list.  The caller must already hold a
+ * count of xBlocksAvailable, which guarantees the list is not empty, and must
+ * call this from within a critical section.
+ */
+static void * prvTakeFreeBlock( MemoryPool_t * pxMemoryPool ) PRIVILEGED_FUNCTION;
+
+/*
+ * Adds a block to the front of the free list.  Must be called from within a
+ * critical section.
+ */
+static void prvReturnFreeBlock( MemoryPool_t * pxMemoryPool,
+                                void * pvBlock ) PRIVILEGED_FUNCTION;
+
+#if ( configASSERT_DEFINED == 1 )
+
+/*
+ * Returns pdTRUE if pvBlock is the start of one of the pool's blocks - inside
+ * pucStorage and on a block boundary.  Used by the free functions to assert
+ * that the block being freed came from the pool.
+ */
+    static BaseType_t prvIsPoolBlock( const MemoryPool_t * pxMemoryPool,
+                                      const void * pvBlock ) PRIVILEGED_FUNCTION;
+
+#endif /* configASSERT_DEFINED */
+
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+    MemoryPoolHandle_t xMemoryPoolCreate( UBaseType_t uxBlockCount,
+                                          size_t xBlockSize )
+    {
+        MemoryPool_t * pxMemoryPool = NULL;
+        size_t xStructSize, xStorageSize;
+
+        configASSERT( uxBlockCount > ( UBaseType_t ) 0 );
+
+        /* The structure and the blocks are allocated in a single call to
+         * pvPortMalloc(), with the blocks following the structure.  Both the
+         * structure size and block size are rounded up so every block is
+         * aligned. */
+        xStructSize = mpoolBLOCK_SIZE( sizeof( MemoryPool_t ) );
+        xBlockSize = mpoolBLOCK_SIZE( xBlockSize );
+        xStorageSize = xBlockSize * ( size_t ) uxBlockCount;
+
+        /* Check for multiplication and addition overflow. */
+        if( ( ( xStorageSize / ( size_t ) uxBlockCount ) == xBlockSize ) &&
+            ( ( xStorageSize + xStructSize ) > xStorageSize ) )
+        {
+            pxMemoryPool = ( MemoryPool_t * ) pvPortMalloc( xStructSize + xStorageSize ); /*lint !e9087 !e9079 see comment above. */
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( pxMemoryPool != NULL )
+        {
+            if( prvInitialiseNewMemoryPool( pxMemoryPool, uxBlockCount, xBlockSize, ( ( uint8_t * ) pxMemoryPool ) + xStructSize ) != pdFAIL )
+            {
+                #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+                    {
+                        /* Both static and dynamic allocation can be used, so note
+                         * this pool was allocated dynamically in case it is later
+                         * deleted. */
+                        pxMemoryPool->ucStaticallyAllocated = pdFALSE;
+                    }
+                #endif /* configSUPPORT_STATIC_ALLOCATION */
+            }
+            else
+            {
+                vPortFree( pxMemoryPool );
+                pxMemoryPool = NULL;
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxMemoryPool;
+    }
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+    MemoryPoolHandle_t xMemoryPoolCreateStatic( UBaseType_t uxBlockCount,
+                                                size_t xBlockSize,
+                                                uint8_t * pucPoolStorageArea,
+                                                StaticMemoryPool_t * pxStaticMemoryPool )
+    {
+        MemoryPool_t * pxMemoryPool = NULL;
+
+        configASSERT( pucPoolStorageArea );
+        configASSERT( pxStaticMemoryPool );
+        configASSERT( uxBlockCount > ( UBaseType_t ) 0 );
+
+        /* The application must have sized the blocks with mpoolBLOCK_SIZE(),
+         * and aligned the storage area, or the blocks would be misaligned. */
+        configASSERT( xBlockSize == mpoolBLOCK_SIZE( xBlockSize ) );
+        configASSERT( ( ( ( size_t ) pucPoolStorageArea ) & ( size_t ) portBYTE_ALIGNMENT_MASK ) == 0 );
+
+        #if ( configASSERT_DEFINED == 1 )
+            {
+                /* Sanity check that the size of the structure used to declare a
+                 * variable of type StaticMemoryPool_t equals the size of the real
+                 * memory pool structure. */
+                volatile size_t xSize = sizeof( StaticMemoryPool_t );
+                configASSERT( xSize == sizeof( MemoryPool_t ) );
+            } /*lint !e529 xSize is referenced if configASSERT() is defined. */
+        #endif /* configASSERT_DEFINED */
+
+        if( ( pucPoolStorageArea != NULL ) && ( pxStaticMemoryPool != NULL ) )
+        {
+            pxMemoryPool = ( MemoryPool_t * ) pxStaticMemoryPool; /*lint !e740 !e9087 StaticMemoryPool_t is a pointer to a MemoryPool_t, so guaranteed to be aligned and sized correctly (checked by an assert()). */
+
+            /* Creating the semaphore into pxMemoryPool->xSemaphoreBuffer
+             * cannot fail. */
+            ( void ) prvInitialiseNewMemoryPool( pxMemoryPool, uxBlockCount, xBlockSize, pucPoolStorageArea );
+
+            #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+                {
+                    /* Both static and dynamic allocation can be used, so note
+                     * that this pool was created statically in case it is later
+                     * deleted. */
+                    pxMemoryPool->ucStaticallyAllocated = pdTRUE;
+                }
+            #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxMemoryPool;
+    }
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+void vMemoryPoolDelete( MemoryPoolHandle_t xMemoryPool )
+{
+    MemoryPool_t * pxMemoryPool = xMemoryPool;
+
+    configASSERT( pxMemoryPool );
+
+    /* As with vSemaphoreDelete(), the pool must not be deleted while a task
+     * is blocked on it. */
+    vSemaphoreDelete( pxMemoryPool->xBlocksAvailable );
+
+    #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
+        {
+            /* The pool can only have been allocated dynamically - free it
+             * again. */
+            vPortFree( pxMemoryPool );
+        }
+    #elif ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+        {
+            /* The pool could have been allocated statically or dynamically, so
+             * check before attempting to free the memory. */
+            if( pxMemoryPool->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+            {
+                vPortFree( pxMemoryPool );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+}
+/*-----------------------------------------------------------*/
+
+void * pvMemoryPoolAlloc( MemoryPoolHandle_t xMemoryPool,
+                          TickType_t xTicksToWait )
+{
+    MemoryPool_t * const pxMemoryPool = xMemoryPool;
+    void * pvReturn = NULL;
+
+    configASSERT( pxMemoryPool );
+
+    /* Reserve a block first.  This is where the task blocks if the pool is
+     * empty, and the semaphore ensures the highest priority waiting task is
+     * given the next block freed. */
+    if( xSemaphoreTake( pxMemoryPool->xBlocksAvailable, xTicksToWait ) != pdFALSE )
+    {
+        taskENTER_CRITICAL();
+        {
+            pvReturn = prvTakeFreeBlock( pxMemoryPool );
+        }
+        taskEXIT_CRITICAL();
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void * pvMemoryPoolAllocFromISR( MemoryPoolHandle_t xMemoryPool )
+{
+    MemoryPool_t * const pxMemoryPool = xMemoryPool;
+    void * pvReturn = NULL;
+    UBaseType_t uxSavedInterruptStatus;
+
+    configASSERT( pxMemoryPool );
+
+    /* Taking a counting semaphore never unblocks a task, so
+     * pxHigherPriorityTaskWoken is not needed. */
+    if( xSemaphoreTakeFromISR( pxMemoryPool->xBlocksAvailable, NULL ) != pdFALSE )
+    {
+        uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            pvReturn = prvTakeFreeBlock( pxMemoryPool );
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vMemoryPoolFree( MemoryPoolHandle_t xMemoryPool,
+                      void * pvBlock )
+{
+    MemoryPool_t * const pxMemoryPool = xMemoryPool;
+
+    configASSERT( pxMemoryPool );
+    configASSERT( pvBlock );
+    configASSERT( prvIsPoolBlock( pxMemoryPool, pvBlock ) != pdFALSE );
+
+    taskENTER_CRITICAL();
+    {
+        prvReturnFreeBlock( pxMemoryPool, pvBlock );
+    }
+    taskEXIT_CRITICAL();
+
+    /* Only now is the block available to the next allocating task. */
+    ( void ) xSemaphoreGive( pxMemoryPool->xBlocksAvailable );
+}
+/*-----------------------------------------------------------*/
+
+void vMemoryPoolFreeFromISR( MemoryPoolHandle_t xMemoryPool,
+                             void * pvBlock,
+                             BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    MemoryPool_t * const pxMemoryPool = xMemoryPool;
+    UBaseType_t uxSavedInterruptStatus;
+
+    configASSERT( pxMemoryPool );
+    configASSERT( pvBlock );
+    configASSERT( prvIsPoolBlock( pxMemoryPool, pvBlock ) != pdFALSE );
+
+    uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();
+    {
+        prvReturnFreeBlock( pxMemoryPool, pvBlock );
+    }
+    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+    ( void ) xSemaphoreGiveFromISR( pxMemoryPool->xBlocksAvailable, pxHigherPriorityTaskWoken );
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxMemoryPoolGetFreeCount( MemoryPoolHandle_t xMemoryPool )
+{
+    const MemoryPool_t * const pxMemoryPool = xMemoryPool;
+
+    configASSERT( pxMemoryPool );
+
+    return pxMemoryPool->uxFreeCount;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxMemoryPoolGetMinimumEverFreeCount( MemoryPoolHandle_t xMemoryPool )
+{
+    const MemoryPool_t * const pxMemoryPool = xMemoryPool;
+
+    configASSERT( pxMemoryPool );
+
+    return pxMemoryPool->uxMinimumEverFreeCount;
+}
+/*-----------------------------------------------------------*/
+
+size_t xMemoryPoolGetBlockSize( MemoryPoolHandle_t xMemoryPool )
+{
+    const MemoryPool_t * const pxMemoryPool = xMemoryPool;
+
+    configASSERT( pxMemoryPool );
+
+    return pxMemoryPool->xBlockSize;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvInitialiseNewMemoryPool( MemoryPool_t * pxMemoryPool,
+                                              UBaseType_t uxBlockCount,
+                                              size_t xBlockSize,
+                                              uint8_t * pucStorage )
+{
+    UBaseType_t uxBlock;
+    MemoryPoolFreeBlock_t * pxBlock;
+    BaseType_t xReturn = pdPASS;
+
+    pxMemoryPool->pucStorage = pucStorage;
+    pxMemoryPool->xBlockSize = xBlockSize;
+    pxMemoryPool->uxBlockCount = uxBlockCount;
+    pxMemoryPool->uxFreeCount = uxBlockCount;
+    pxMemoryPool->uxMinimumEverFreeCount = uxBlockCount;
+
+    /* Thread the blocks onto the free list in address order. */
+    pxMemoryPool->pxFreeList = NULL;
+
+    for( uxBlock = uxBlockCount; uxBlock > ( UBaseType_t ) 0; uxBlock-- )
+    {
+        pxBlock = ( MemoryPoolFreeBlock_t * ) ( pucStorage + ( ( size_t ) ( uxBlock - ( UBaseType_t ) 1 ) * xBlockSize ) ); /*lint !e9087 !e826 Blocks are aligned by mpoolBLOCK_SIZE(). */
+        pxBlock->pxNext = pxMemoryPool->pxFreeList;
+        pxMemoryPool->pxFreeList = pxBlock;
+    }
+
+    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+        {
+            pxMemoryPool->xBlocksAvailable = xSemaphoreCreateCountingStatic( uxBlockCount, uxBlockCount, &( pxMemoryPool->xSemaphoreBuffer ) );
+        }
+    #else
+        {
+            pxMemoryPool->xBlocksAvailable = xSemaphoreCreateCounting( uxBlockCount, uxBlockCount );
+        }
+    #endif /* configSUPPORT_STATIC_ALLOCATION */
+
+    if( pxMemoryPool->xBlocksAvailable == NULL )
+    {
+        xReturn = pdFAIL;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void * prvTakeFreeBlock( MemoryPool_t * pxMemoryPool )
+{
+    MemoryPoolFreeBlock_t * pxBlock;
+
+    pxBlock = pxMemoryPool->pxFreeList;
+    configASSERT( pxBlock );
+
+    pxMemoryPool->pxFreeList = pxBlock->pxNext;
+    pxMemoryPool->uxFreeCount--;
+
+    if( pxMemoryPool->uxFreeCount < pxMemoryPool->uxMinimumEverFreeCount )
+    {
+        pxMemoryPool->uxMinimumEverFreeCount = pxMemoryPool->uxFreeCount;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return ( void * ) pxBlock;
+}
+/*-----------------------------------------------------------*/
+
+static void prvReturnFreeBlock( MemoryPool_t * pxMemoryPool,
+                                void * pvBlock )
+{
+    MemoryPoolFreeBlock_t * pxBlock = ( MemoryPoolFreeBlock_t * ) pvBlock; /*lint !e9087 !e9079 Blocks are aligned by mpoolBLOCK_SIZE(). */
+
+    /* The pool cannot hold more free blocks than it has - a block was freed
+     * twice.  The callers have already checked the block is the pool's. */
+    configASSERT( pxMemoryPool->uxFreeCount < pxMemoryPool->uxBlockCount );
+
+    pxBlock->pxNext = pxMemoryPool->pxFreeList;
+    pxMemoryPool->pxFreeList = pxBlock;
+    pxMemoryPool->uxFreeCount++;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configASSERT_DEFINED == 1 )
+
+    static BaseType_t prvIsPoolBlock( const MemoryPool_t * pxMemoryPool,
+                                      const void * pvBlock )
+    {
+        const uint8_t * pucBlock = ( const uint8_t * ) pvBlock;
+        BaseType_t xReturn = pdFALSE;
+
+        if( ( pucBlock >= pxMemoryPool->pucStorage ) &&
+            ( ( size_t ) ( pucBlock - pxMemoryPool->pucStorage ) < ( ( size_t ) pxMemoryPool->uxBlockCount * pxMemoryPool->xBlockSize ) ) &&
+            ( ( ( size_t ) ( pucBlock - pxMemoryPool->pucStorage ) % pxMemoryPool->xBlockSize ) == 0 ) )
+        {
+            xReturn = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+
+#endif /* configASSERT_DEFINED */
+/*-----------------------------------------------------------*/
@@ -66,6 +66,10 @@
 /* Index into the ucHeap array. */
 static size_t xNextFreeByte = ( size_t ) 0;
 
+/* Allocation counters reported by vPortGetHeapStats(). */
+static size_t xNumberOfSuccessfulAllocations = 0;
+static size_t xNumberOfFailedAllocations = 0;
+
 /*-----------------------------------------------------------*/
 
 void * pvPortMalloc( size_t xWantedSize )
@@ -108,6 +112,11 @@ void * pvPortMalloc( size_t xWantedSize )
              * block. */
             pvReturn = pucAlignedHeap + xNextFreeByte;
             xNextFreeByte += xWantedSize;
+            xNumberOfSuccessfulAllocations++;
+        }
+        else
+        {
+            xNumberOfFailedAllocations++;
         }
 
         traceMALLOC( pvReturn, xWantedSize );
@@ -144,6 +153,8 @@ void vPortInitialiseBlocks( void )
 {
     /* Only required when static memory is not cleared. */
     xNextFreeByte = ( size_t ) 0;
+    xNumberOfSuccessfulAllocations = 0;
+    xNumberOfFailedAllocations = 0;
 }
 /*-----------------------------------------------------------*/
 
@@ -151,3 +162,29 @@ size_t xPortGetFreeHeapSize( void )
 {
     return( configADJUSTED_HEAP_SIZE - xNextFreeByte );
 }
+/*-----------------------------------------------------------*/
+
+size_t xPortGetMinimumEverFreeHeapSize( void )
+{
+    /* Memory is never returned, so the free space only ever shrinks. */
+    return xPortGetFreeHeapSize();
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetHeapStats( HeapStats_t * pxHeapStats )
+{
+    vTaskSuspendAll();
+    {
+        /* The unallocated space is always a single contiguous block at the
+         * end of the heap. */
+        pxHeapStats->xAvailableHeapSpaceInBytes = configADJUSTED_HEAP_SIZE - xNextFreeByte;
+        pxHeapStats->xSizeOfLargestFreeBlockInBytes = pxHeapStats->xAvailableHeapSpaceInBytes;
+        pxHeapStats->xSizeOfSmallestFreeBlockInBytes = pxHeapStats->xAvailableHeapSpaceInBytes;
+        pxHeapStats->xNumberOfFreeBlocks = ( pxHeapStats->xAvailableHeapSpaceInBytes > 0 ) ? 1 : 0;
+        pxHeapStats->xMinimumEverFreeBytesRemaining = pxHeapStats->xAvailableHeapSpaceInBytes;
+        pxHeapStats->xNumberOfSuccessfulAllocations = xNumberOfSuccessfulAllocations;
+        pxHeapStats->xNumberOfSuccessfulFrees = 0;
+        pxHeapStats->xNumberOfFailedAllocations = xNumberOfFailedAllocations;
+    }
+    ( void ) xTaskResumeAll();
+}
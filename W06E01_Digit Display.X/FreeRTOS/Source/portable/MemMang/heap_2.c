@@ -88,6 +88,12 @@ static BlockLink_t xStart, xEnd;
 /* Keeps track of the number of free bytes remaining, but says nothing about
  * fragmentation. */
 static size_t xFreeBytesRemaining = configADJUSTED_HEAP_SIZE;
+static size_t xMinimumEverFreeBytesRemaining = configADJUSTED_HEAP_SIZE;
+
+/* Allocation and free counters reported by vPortGetHeapStats(). */
+static size_t xNumberOfSuccessfulAllocations = 0;
+static size_t xNumberOfSuccessfulFrees = 0;
+static size_t xNumberOfFailedAllocations = 0;
 
 /* STATIC FUNCTIONS ARE DEFINED AS MACROS TO MINIMIZE THE FUNCTION CALL DEPTH. */
 
@@ -200,9 +206,21 @@ void * pvPortMalloc( size_t xWantedSize )
                 }
 
                 xFreeBytesRemaining -= pxBlock->xBlockSize;
+
+                if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+                {
+                    xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+                }
+
+                xNumberOfSuccessfulAllocations++;
             }
         }
 
+        if( pvReturn == NULL )
+        {
+            xNumberOfFailedAllocations++;
+        }
+
         traceMALLOC( pvReturn, xWantedSize );
     }
     ( void ) xTaskResumeAll();
@@ -241,6 +259,7 @@ void vPortFree( void * pv )
             /* Add this block to the list of free blocks. */
             prvInsertBlockIntoFreeList( ( ( BlockLink_t * ) pxLink ) );
             xFreeBytesRemaining += pxLink->xBlockSize;
+            xNumberOfSuccessfulFrees++;
             traceFREE( pv, pxLink->xBlockSize );
         }
         ( void ) xTaskResumeAll();
@@ -254,6 +273,12 @@ size_t xPortGetFreeHeapSize( void )
 }
 /*-----------------------------------------------------------*/
 
+size_t xPortGetMinimumEverFreeHeapSize( void )
+{
+    return xMinimumEverFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
 void vPortInitialiseBlocks( void )
 {
     /* This just exists to keep the linker quiet. */
@@ -284,3 +309,52 @@ static void prvHeapInit( void )
     pxFirstFreeBlock->pxNextFreeBlock = &xEnd;
 }
 /*-----------------------------------------------------------*/
+
+void vPortGetHeapStats( HeapStats_t * pxHeapStats )
+{
+    BlockLink_t * pxBlock;
+    size_t xBlocks = 0, xMaxSize = 0, xMinSize = 0;
+
+    vTaskSuspendAll();
+    {
+        pxBlock = xStart.pxNextFreeBlock;
+
+        if( pxBlock == NULL )
+        {
+            /* The heap is initialised by the first call to pvPortMalloc(), so
+             * until then it is one free block. */
+            xBlocks = 1;
+            xMaxSize = xFreeBytesRemaining;
+            xMinSize = xFreeBytesRemaining;
+        }
+        else
+        {
+            /* The free list is ordered by size, so the first block is the
+             * smallest and the last block before xEnd is the largest. */
+            xMinSize = pxBlock->xBlockSize;
+
+            while( pxBlock != &xEnd )
+            {
+                xBlocks++;
+                xMaxSize = pxBlock->xBlockSize;
+                pxBlock = pxBlock->pxNextFreeBlock;
+            }
+
+            if( xBlocks == 0 )
+            {
+                xMinSize = 0;
+            }
+        }
+
+        pxHeapStats->xSizeOfLargestFreeBlockInBytes = xMaxSize;
+        pxHeapStats->xSizeOfSmallestFreeBlockInBytes = xMinSize;
+        pxHeapStats->xNumberOfFreeBlocks = xBlocks;
+        pxHeapStats->xAvailableHeapSpaceInBytes = xFreeBytesRemaining;
+        pxHeapStats->xMinimumEverFreeBytesRemaining = xMinimumEverFreeBytesRemaining;
+        pxHeapStats->xNumberOfSuccessfulAllocations = xNumberOfSuccessfulAllocations;
+        pxHeapStats->xNumberOfSuccessfulFrees = xNumberOfSuccessfulFrees;
+        pxHeapStats->xNumberOfFailedAllocations = xNumberOfFailedAllocations;
+    }
+    ( void ) xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
@@ -34,6 +34,9 @@
  * This file can only be used if the linker is configured to to generate
  * a heap memory area.
  *
+ * The C library does not report how much of its heap is free, so
+ * vPortGetHeapStats() only reports the allocation and free counts.
+ *
  * See heap_1.c, heap_2.c and heap_4.c for alternative implementations, and the
  * memory management pages of https://www.FreeRTOS.org for more information.
  */
@@ -54,6 +57,11 @@
     #error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
 #endif
 
+/* Allocation and free counters reported by vPortGetHeapStats(). */
+static size_t xNumberOfSuccessfulAllocations = 0;
+static size_t xNumberOfSuccessfulFrees = 0;
+static size_t xNumberOfFailedAllocations = 0;
+
 /*-----------------------------------------------------------*/
 
 void * pvPortMalloc( size_t xWantedSize )
@@ -63,6 +71,16 @@ void * pvPortMalloc( size_t xWantedSize )
     vTaskSuspendAll();
     {
         pvReturn = malloc( xWantedSize );
+
+        if( pvReturn != NULL )
+        {
+            xNumberOfSuccessfulAllocations++;
+        }
+        else
+        {
+            xNumberOfFailedAllocations++;
+        }
+
         traceMALLOC( pvReturn, xWantedSize );
     }
     ( void ) xTaskResumeAll();
@@ -88,8 +106,27 @@ void vPortFree( void * pv )
         vTaskSuspendAll();
         {
             free( pv );
+            xNumberOfSuccessfulFrees++;
             traceFREE( pv, 0 );
         }
         ( void ) xTaskResumeAll();
     }
 }
+/*-----------------------------------------------------------*/
+
+void vPortGetHeapStats( HeapStats_t * pxHeapStats )
+{
+    vTaskSuspendAll();
+    {
+        /* The sizes are not known to this scheme, so are reported as zero. */
+        pxHeapStats->xAvailableHeapSpaceInBytes = 0;
+        pxHeapStats->xSizeOfLargestFreeBlockInBytes = 0;
+        pxHeapStats->xSizeOfSmallestFreeBlockInBytes = 0;
+        pxHeapStats->xNumberOfFreeBlocks = 0;
+        pxHeapStats->xMinimumEverFreeBytesRemaining = 0;
+        pxHeapStats->xNumberOfSuccessfulAllocations = xNumberOfSuccessfulAllocations;
+        pxHeapStats->xNumberOfSuccessfulFrees = xNumberOfSuccessfulFrees;
+        pxHeapStats->xNumberOfFailedAllocations = xNumberOfFailedAllocations;
+    }
+    ( void ) xTaskResumeAll();
+}
@@ -123,6 +123,7 @@ static size_t xFreeBytesRemaining = 0U;
 static size_t xMinimumEverFreeBytesRemaining = 0U;
 static size_t xNumberOfSuccessfulAllocations = 0;
 static size_t xNumberOfSuccessfulFrees = 0;
+static size_t xNumberOfFailedAllocations = 0;
 
 /* Gets set to the top bit of an size_t type.  When this bit in the xBlockSize
  * member of an BlockLink_t structure is set then the block belongs to the
@@ -260,6 +261,15 @@ void * pvPortMalloc( size_t xWantedSize )
             mtCOVERAGE_TEST_MARKER();
         }
 
+        if( pvReturn == NULL )
+        {
+            xNumberOfFailedAllocations++;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
         traceMALLOC( pvReturn, xWantedSize );
     }
     ( void ) xTaskResumeAll();
@@ -554,6 +564,7 @@ void vPortGetHeapStats( HeapStats_t * pxHeapStats )
         pxHeapStats->xNumberOfSuccessfulAllocations = xNumberOfSuccessfulAllocations;
         pxHeapStats->xNumberOfSuccessfulFrees = xNumberOfSuccessfulFrees;
         pxHeapStats->xMinimumEverFreeBytesRemaining = xMinimumEverFreeBytesRemaining;
+        pxHeapStats->xNumberOfFailedAllocations = xNumberOfFailedAllocations;
     }
     taskEXIT_CRITICAL();
 }
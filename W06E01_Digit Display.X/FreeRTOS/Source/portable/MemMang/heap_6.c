@@ -0,0 +1,720 @@
+/*
+ * FreeRTOS Kernel V10.4.6
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * A sample implementation of pvPortMalloc() and vPortFree() that uses two
+ * level segregated fit (TLSF) free lists.  Free blocks are kept in one of a
+ * fixed number of lists according to their size class, and a pair of bitmaps
+ * records which lists are not empty.  Finding a suitable block, splitting it,
+ * and merging a freed block with its physical neighbours all take a bounded
+ * number of steps that does not depend on how many blocks are free - unlike
+ * heap_2.c and heap_4.c, which walk the free list.  Like heap_4.c, adjacent
+ * free blocks are combined (coalesced) to limit fragmentation.
+ *
+ * Blocks are found by rounding the requested size up to the next size class,
+ * so any block taken from a list is large enough without searching the list.
+ * That can leave a suitable block unused when the heap is almost full, so this
+ * implementation may fail an allocation that heap_4.c would have satisfied.
+ *
+ * configHEAP_TLSF_SL_INDEX_COUNT_LOG2 sets how many second level lists each
+ * power of two size range is split into (1 << value, default 2 so 4 lists).
+ * Larger values waste less memory to rounding but use more RAM for the list
+ * heads.
+ *
+ * See heap_1.c, heap_2.c, heap_3.c, heap_4.c and heap_5.c for alternative
+ * implementations, and the memory management pages of https://www.FreeRTOS.org
+ * for more information.
+ */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+    #error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
+#endif
+
+#ifndef configHEAP_TLSF_SL_INDEX_COUNT_LOG2
+    #define configHEAP_TLSF_SL_INDEX_COUNT_LOG2    2
+#endif
+
+#if ( ( configHEAP_TLSF_SL_INDEX_COUNT_LOG2 < 1 ) || ( configHEAP_TLSF_SL_INDEX_COUNT_LOG2 > 3 ) )
+    #error configHEAP_TLSF_SL_INDEX_COUNT_LOG2 must be between 1 and 3
+#endif
+
+/* Assumes 8bit bytes! */
+#define heapBITS_PER_BYTE           ( ( size_t ) 8 )
+
+/* Block sizes are always a multiple of heapGRANULARITY, which leaves the two
+ * least significant bits of the size free to hold the block's flags. */
+#if ( portBYTE_ALIGNMENT >= 32 )
+    #define heapGRANULARITY_LOG2    5
+#elif ( portBYTE_ALIGNMENT == 16 )
+    #define heapGRANULARITY_LOG2    4
+#elif ( portBYTE_ALIGNMENT == 8 )
+    #define heapGRANULARITY_LOG2    3
+#else
+    #define heapGRANULARITY_LOG2    2
+#endif
+#define heapGRANULARITY             ( ( size_t ) 1 << heapGRANULARITY_LOG2 )
+#define heapGRANULARITY_MASK        ( heapGRANULARITY - ( size_t ) 1 )
+
+/* Flags held in the bottom bits of xBlockSize. */
+#define heapBLOCK_IS_FREE           ( ( size_t ) 1 )
+#define heapPREVIOUS_BLOCK_IS_FREE  ( ( size_t ) 2 )
+#define heapBLOCK_FLAGS_MASK        ( heapBLOCK_IS_FREE | heapPREVIOUS_BLOCK_IS_FREE )
+
+/* Each first level (power of two) size range is split into heapSL_INDEX_COUNT
+ * second level lists.  Blocks smaller than heapSMALL_BLOCK_SIZE are all held
+ * in first level list 0, which is split linearly. */
+#define heapSL_INDEX_COUNT_LOG2     ( configHEAP_TLSF_SL_INDEX_COUNT_LOG2 )
+#define heapSL_INDEX_COUNT          ( 1 << heapSL_INDEX_COUNT_LOG2 )
+#define heapFL_INDEX_SHIFT          ( heapSL_INDEX_COUNT_LOG2 + heapGRANULARITY_LOG2 )
+#define heapSMALL_BLOCK_SIZE        ( ( size_t ) 1 << heapFL_INDEX_SHIFT )
+
+/* The first level bitmap is a uint32_t, so at most 32 bits of block size are
+ * indexed - far more than any heap this file is used with. */
+#define heapFL_INDEX_MAX            ( ( ( sizeof( size_t ) * heapBITS_PER_BYTE ) > 32 ) ? 32 : ( sizeof( size_t ) * heapBITS_PER_BYTE ) )
+#define heapFL_INDEX_COUNT          ( heapFL_INDEX_MAX - heapFL_INDEX_SHIFT + 1 )
+
+/* Allocate the memory for the heap. */
+#if ( configAPPLICATION_ALLOCATED_HEAP == 1 )
+
+/* The application writer has already defined the array used for the RTOS
+* heap - probably so it can be placed in a special segment or address. */
+    extern uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+#else
+    PRIVILEGED_DATA static uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+#endif /* configAPPLICATION_ALLOCATED_HEAP */
+
+/* The header at the start of every block.  The free list links are only valid
+ * while the block is free, and overlay the start of the memory returned to the
+ * application when it is allocated. */
+typedef struct A_BLOCK_HEADER
+{
+    struct A_BLOCK_HEADER * pxPreviousPhysicalBlock; /*<< The block immediately below this one in memory, valid only when that block is free. */
+    size_t xBlockSize;                               /*<< The size of the block, including this header, ORed with the block flags. */
+    struct A_BLOCK_HEADER * pxNextFreeBlock;         /*<< The next block in the same free list. */
+    struct A_BLOCK_HEADER * pxPreviousFreeBlock;     /*<< The previous block in the same free list. */
+} BlockHeader_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Called automatically to setup the required heap structures the first time
+ * pvPortMalloc() is called.
+ */
+static void prvHeapInit( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the first and second level list indexes for a block of xSize bytes.
+ */
+static void prvMapSizeToLists( size_t xSize,
+                               UBaseType_t * puxFirstLevel,
+                               UBaseType_t * puxSecondLevel ) PRIVILEGED_FUNCTION;
+
+/*
+ * Finds a free block of at least xSize bytes without walking any list.
+ * Returns NULL if there is none.
+ */
+static BlockHeader_t * prvFindSuitableBlock( size_t xSize ) PRIVILEGED_FUNCTION;
+
+/*
+ * Add a free block to, or remove a free block from, the list for its size.
+ */
+static void prvInsertFreeBlock( BlockHeader_t * pxBlock ) PRIVILEGED_FUNCTION;
+static void prvRemoveFreeBlock( BlockHeader_t * pxBlock ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the index of the most significant set bit in ulValue, which must
+ * not be zero.  Takes the same number of steps for any value.
+ */
+static UBaseType_t prvFindLastSet( uint32_t ulValue ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+/* The size of the part of BlockHeader_t that remains in front of an allocated
+ * block, rounded up to keep the memory returned to the application aligned. */
+static const size_t xHeapStructSize = ( sizeof( BlockHeader_t * ) + sizeof( size_t ) + heapGRANULARITY_MASK ) & ~heapGRANULARITY_MASK;
+
+/* Every block must be able to hold the full header once it is freed. */
+static const size_t xMinimumBlockSize = ( sizeof( BlockHeader_t ) + heapGRANULARITY_MASK ) & ~heapGRANULARITY_MASK;
+
+/* The free lists, and the bitmaps that say which of them hold blocks.  Bit n
+ * of ulFirstLevelBitmap is set if any bit of ucSecondLevelBitmaps[ n ] is
+ * set. */
+PRIVILEGED_DATA static BlockHeader_t * pxFreeLists[ heapFL_INDEX_COUNT ][ heapSL_INDEX_COUNT ];
+PRIVILEGED_DATA static uint32_t ulFirstLevelBitmap = 0;
+PRIVILEGED_DATA static uint8_t ucSecondLevelBitmaps[ heapFL_INDEX_COUNT ];
+
+/* Zero sized, permanently allocated, block that marks the end of the heap so
+ * the last real block always has a physical successor. */
+PRIVILEGED_DATA static BlockHeader_t * pxEnd = NULL;
+
+/* Keeps track of the number of calls to allocate and free memory as well as the
+ * number of free bytes remaining, but says nothing about fragmentation. */
+PRIVILEGED_DATA static size_t xFreeBytesRemaining = 0U;
+PRIVILEGED_DATA static size_t xMinimumEverFreeBytesRemaining = 0U;
+PRIVILEGED_DATA static size_t xNumberOfSuccessfulAllocations = 0;
+PRIVILEGED_DATA static size_t xNumberOfSuccessfulFrees = 0;
+PRIVILEGED_DATA static size_t xNumberOfFailedAllocations = 0;
+
+/*-----------------------------------------------------------*/
+
+#define heapBLOCK_SIZE( pxBlock )          ( ( pxBlock )->xBlockSize & ~heapBLOCK_FLAGS_MASK )
+#define heapNEXT_PHYSICAL_BLOCK( pxBlock ) ( ( BlockHeader_t * ) ( ( ( uint8_t * ) ( pxBlock ) ) + heapBLOCK_SIZE( pxBlock ) ) )
+
+/*-----------------------------------------------------------*/
+
+void * pvPortMalloc( size_t xWantedSize )
+{
+    BlockHeader_t * pxBlock, * pxNewBlock, * pxNextBlock;
+    size_t xBlockSize = 0;
+    void * pvReturn = NULL;
+
+    vTaskSuspendAll();
+    {
+        /* If this is the first call to malloc then the heap will require
+         * initialisation to setup the free lists. */
+        if( pxEnd == NULL )
+        {
+            prvHeapInit();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* The wanted size must be increased so it can contain the block header
+         * in addition to the requested amount of bytes, then rounded up to a
+         * whole number of granules. */
+        if( ( xWantedSize > 0 ) &&
+            ( ( xWantedSize + xHeapStructSize + heapGRANULARITY_MASK ) > xWantedSize ) ) /* Overflow check */
+        {
+            xBlockSize = ( xWantedSize + xHeapStructSize + heapGRANULARITY_MASK ) & ~heapGRANULARITY_MASK;
+
+            if( xBlockSize < xMinimumBlockSize )
+            {
+                xBlockSize = xMinimumBlockSize;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( ( xBlockSize > 0 ) && ( xBlockSize <= xFreeBytesRemaining ) )
+        {
+            pxBlock = prvFindSuitableBlock( xBlockSize );
+
+            if( pxBlock != NULL )
+            {
+                prvRemoveFreeBlock( pxBlock );
+                pxNextBlock = heapNEXT_PHYSICAL_BLOCK( pxBlock );
+
+                /* If the block is larger than required it can be split into
+                 * two. */
+                if( ( heapBLOCK_SIZE( pxBlock ) - xBlockSize ) >= xMinimumBlockSize )
+                {
+                    /* The remainder starts immediately after the part being
+                     * returned.  The block below it is about to be allocated,
+                     * and the block above it still sees a free block below it,
+                     * so only the remainder's own flags need setting. */
+                    pxNewBlock = ( BlockHeader_t * ) ( ( ( uint8_t * ) pxBlock ) + xBlockSize );
+                    pxNewBlock->xBlockSize = ( heapBLOCK_SIZE( pxBlock ) - xBlockSize ) | heapBLOCK_IS_FREE;
+                    pxNextBlock->pxPreviousPhysicalBlock = pxNewBlock;
+                    pxBlock->xBlockSize = xBlockSize | ( pxBlock->xBlockSize & heapPREVIOUS_BLOCK_IS_FREE );
+
+                    prvInsertFreeBlock( pxNewBlock );
+                }
+                else
+                {
+                    /* Allocating the whole block - the block above no longer
+                     * has a free block below it. */
+                    pxNextBlock->xBlockSize &= ~heapPREVIOUS_BLOCK_IS_FREE;
+                }
+
+                /* The block is being returned - it is allocated and owned by
+                 * the application. */
+                pxBlock->xBlockSize &= ~heapBLOCK_IS_FREE;
+                xFreeBytesRemaining -= heapBLOCK_SIZE( pxBlock );
+
+                if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+                {
+                    xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                /* Return the memory space pointed to - jumping over the part
+                 * of the header that stays in front of an allocated block. */
+                pvReturn = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xHeapStructSize );
+                xNumberOfSuccessfulAllocations++;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( pvReturn == NULL )
+        {
+            xNumberOfFailedAllocations++;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceMALLOC( pvReturn, xWantedSize );
+    }
+    ( void ) xTaskResumeAll();
+
+    #if ( configUSE_MALLOC_FAILED_HOOK == 1 )
+        {
+            if( pvReturn == NULL )
+            {
+                extern void vApplicationMallocFailedHook( void );
+                vApplicationMallocFailedHook();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    #endif /* if ( configUSE_MALLOC_FAILED_HOOK == 1 ) */
+
+    configASSERT( ( ( ( size_t ) pvReturn ) & ( size_t ) portBYTE_ALIGNMENT_MASK ) == 0 );
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void * pv )
+{
+    BlockHeader_t * pxBlock, * pxNeighbour;
+
+    if( pv != NULL )
+    {
+        /* The memory being freed will have the block header immediately before
+         * it.  The void cast is used to prevent compiler warnings. */
+        pxBlock = ( void * ) ( ( ( uint8_t * ) pv ) - xHeapStructSize );
+
+        /* Check the block is actually allocated. */
+        configASSERT( ( pxBlock->xBlockSize & heapBLOCK_IS_FREE ) == 0 );
+
+        if( ( pxBlock->xBlockSize & heapBLOCK_IS_FREE ) == 0 )
+        {
+            vTaskSuspendAll();
+            {
+                xFreeBytesRemaining += heapBLOCK_SIZE( pxBlock );
+                traceFREE( pv, heapBLOCK_SIZE( pxBlock ) );
+                pxBlock->xBlockSize |= heapBLOCK_IS_FREE;
+
+                /* Merge with the block below if it is free.  The merged block
+                 * inherits that block's "previous block is free" flag, which
+                 * will be clear as two free blocks are never left adjacent. */
+                if( ( pxBlock->xBlockSize & heapPREVIOUS_BLOCK_IS_FREE ) != 0 )
+                {
+                    pxNeighbour = pxBlock->pxPreviousPhysicalBlock;
+                    prvRemoveFreeBlock( pxNeighbour );
+                    pxNeighbour->xBlockSize += heapBLOCK_SIZE( pxBlock );
+                    pxBlock = pxNeighbour;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                /* Merge with the block above if it is free. */
+                pxNeighbour = heapNEXT_PHYSICAL_BLOCK( pxBlock );
+
+                if( ( pxNeighbour->xBlockSize & heapBLOCK_IS_FREE ) != 0 )
+                {
+                    prvRemoveFreeBlock( pxNeighbour );
+                    pxBlock->xBlockSize += heapBLOCK_SIZE( pxNeighbour );
+                    pxNeighbour = heapNEXT_PHYSICAL_BLOCK( pxBlock );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                /* Tell the block above that it now has a free block below. */
+                pxNeighbour->pxPreviousPhysicalBlock = pxBlock;
+                pxNeighbour->xBlockSize |= heapPREVIOUS_BLOCK_IS_FREE;
+
+                prvInsertFreeBlock( pxBlock );
+                xNumberOfSuccessfulFrees++;
+            }
+            ( void ) xTaskResumeAll();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize( void )
+{
+    return xFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetMinimumEverFreeHeapSize( void )
+{
+    return xMinimumEverFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+void vPortInitialiseBlocks( void )
+{
+    /* This just exists to keep the linker quiet. */
+}
+/*-----------------------------------------------------------*/
+
+static void prvHeapInit( void ) /* PRIVILEGED_FUNCTION */
+{
+    BlockHeader_t * pxFirstFreeBlock;
+    size_t uxAddress, uxEndAddress;
+
+    /* Ensure the heap starts on a granule boundary, which also satisfies
+     * portBYTE_ALIGNMENT. */
+    uxAddress = ( size_t ) ucHeap;
+    uxAddress += heapGRANULARITY_MASK;
+    uxAddress &= ~heapGRANULARITY_MASK;
+
+    /* pxEnd is placed in the last whole granules of the heap space.  Only its
+     * first two members are ever accessed. */
+    uxEndAddress = ( ( size_t ) ucHeap ) + configTOTAL_HEAP_SIZE;
+    uxEndAddress -= xHeapStructSize;
+    uxEndAddress &= ~heapGRANULARITY_MASK;
+
+    /* To start with there is a single free block that is sized to take up the
+     * entire heap space, minus the space taken by pxEnd. */
+    pxFirstFreeBlock = ( void * ) uxAddress;
+    pxFirstFreeBlock->xBlockSize = ( uxEndAddress - uxAddress ) | heapBLOCK_IS_FREE;
+    pxFirstFreeBlock->pxPreviousPhysicalBlock = NULL;
+
+    pxEnd = ( void * ) uxEndAddress;
+    pxEnd->xBlockSize = heapPREVIOUS_BLOCK_IS_FREE;
+    pxEnd->pxPreviousPhysicalBlock = pxFirstFreeBlock;
+
+    prvInsertFreeBlock( pxFirstFreeBlock );
+
+    /* Only one block exists - and it covers the entire usable heap space. */
+    xMinimumEverFreeBytesRemaining = heapBLOCK_SIZE( pxFirstFreeBlock );
+    xFreeBytesRemaining = heapBLOCK_SIZE( pxFirstFreeBlock );
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvFindLastSet( uint32_t ulValue ) /* PRIVILEGED_FUNCTION */
+{
+    UBaseType_t uxBit = 0;
+
+    configASSERT( ulValue != 0 );
+
+    /* Binary search - five steps for any 32-bit value. */
+    if( ( ulValue & 0xFFFF0000UL ) != 0 )
+    {
+        ulValue >>= 16;
+        uxBit += 16;
+    }
+
+    if( ( ulValue & 0xFF00UL ) != 0 )
+    {
+        ulValue >>= 8;
+        uxBit += 8;
+    }
+
+    if( ( ulValue & 0xF0UL ) != 0 )
+    {
+        ulValue >>= 4;
+        uxBit += 4;
+    }
+
+    if( ( ulValue & 0xCUL ) != 0 )
+    {
+        ulValue >>= 2;
+        uxBit += 2;
+    }
+
+    if( ( ulValue & 0x2UL ) != 0 )
+    {
+        uxBit += 1;
+    }
+
+    return uxBit;
+}
+/*-----------------------------------------------------------*/
+
+static void prvMapSizeToLists( size_t xSize,
+                               UBaseType_t * puxFirstLevel,
+                               UBaseType_t * puxSecondLevel ) /* PRIVILEGED_FUNCTION */
+{
+    UBaseType_t uxMostSignificantBit;
+
+    if( xSize < heapSMALL_BLOCK_SIZE )
+    {
+        /* Small blocks are split linearly, one list per granule. */
+        *puxFirstLevel = 0;
+        *puxSecondLevel = ( UBaseType_t ) ( xSize >> heapGRANULARITY_LOG2 );
+    }
+    else
+    {
+        /* The first level is the power of two range the size falls in, and
+         * the second level is taken from the bits just below the most
+         * significant bit. */
+        uxMostSignificantBit = prvFindLastSet( ( uint32_t ) xSize );
+        *puxSecondLevel = ( UBaseType_t ) ( ( xSize >> ( uxMostSignificantBit - heapSL_INDEX_COUNT_LOG2 ) ) ^ ( ( size_t ) 1 << heapSL_INDEX_COUNT_LOG2 ) );
+        *puxFirstLevel = ( UBaseType_t ) ( uxMostSignificantBit - ( heapFL_INDEX_SHIFT - 1 ) );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static BlockHeader_t * prvFindSuitableBlock( size_t xSize ) /* PRIVILEGED_FUNCTION */
+{
+    UBaseType_t uxFirstLevel, uxSecondLevel;
+    uint32_t ulMap;
+    size_t xRoundUp;
+    BlockHeader_t * pxReturn = NULL;
+
+    /* Round the size up to the start of the next size class so every block in
+     * the list found is big enough, and the list does not need searching. */
+    if( xSize >= heapSMALL_BLOCK_SIZE )
+    {
+        xRoundUp = ( ( size_t ) 1 << ( prvFindLastSet( ( uint32_t ) xSize ) - heapSL_INDEX_COUNT_LOG2 ) ) - ( size_t ) 1;
+
+        if( ( xSize + xRoundUp ) > xSize ) /* Overflow check */
+        {
+            xSize += xRoundUp;
+        }
+        else
+        {
+            xSize = 0;
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if( xSize != 0 )
+    {
+        prvMapSizeToLists( xSize, &uxFirstLevel, &uxSecondLevel );
+
+        if( uxFirstLevel < heapFL_INDEX_COUNT )
+        {
+            /* Any non-empty list in the same first level range at or above
+             * the second level index? */
+            ulMap = ( uint32_t ) ucSecondLevelBitmaps[ uxFirstLevel ] & ( ~( uint32_t ) 0 << uxSecondLevel );
+
+            if( ulMap == 0 )
+            {
+                /* No - take the smallest block from a larger first level
+                 * range, if there is one. */
+                ulMap = ( uxFirstLevel + 1 < 32 ) ? ( ulFirstLevelBitmap & ( ~( uint32_t ) 0 << ( uxFirstLevel + 1 ) ) ) : 0;
+
+                if( ulMap != 0 )
+                {
+                    uxFirstLevel = prvFindLastSet( ulMap & ( ~ulMap + 1 ) );
+                    ulMap = ( uint32_t ) ucSecondLevelBitmaps[ uxFirstLevel ];
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( ulMap != 0 )
+            {
+                /* Lowest set bit - the smallest suitable size class. */
+                uxSecondLevel = prvFindLastSet( ulMap & ( ~ulMap + 1 ) );
+                pxReturn = pxFreeLists[ uxFirstLevel ][ uxSecondLevel ];
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return pxReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInsertFreeBlock( BlockHeader_t * pxBlock ) /* PRIVILEGED_FUNCTION */
+{
+    UBaseType_t uxFirstLevel, uxSecondLevel;
+
+    prvMapSizeToLists( heapBLOCK_SIZE( pxBlock ), &uxFirstLevel, &uxSecondLevel );
+    configASSERT( uxFirstLevel < heapFL_INDEX_COUNT );
+
+    /* Insert at the head of the list and mark the list as not empty. */
+    pxBlock->pxPreviousFreeBlock = NULL;
+    pxBlock->pxNextFreeBlock = pxFreeLists[ uxFirstLevel ][ uxSecondLevel ];
+
+    if( pxBlock->pxNextFreeBlock != NULL )
+    {
+        pxBlock->pxNextFreeBlock->pxPreviousFreeBlock = pxBlock;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    pxFreeLists[ uxFirstLevel ][ uxSecondLevel ] = pxBlock;
+    ucSecondLevelBitmaps[ uxFirstLevel ] |= ( uint8_t ) ( 1U << uxSecondLevel );
+    ulFirstLevelBitmap |= ( uint32_t ) 1 << uxFirstLevel;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRemoveFreeBlock( BlockHeader_t * pxBlock ) /* PRIVILEGED_FUNCTION */
+{
+    UBaseType_t uxFirstLevel, uxSecondLevel;
+
+    prvMapSizeToLists( heapBLOCK_SIZE( pxBlock ), &uxFirstLevel, &uxSecondLevel );
+
+    if( pxBlock->pxNextFreeBlock != NULL )
+    {
+        pxBlock->pxNextFreeBlock->pxPreviousFreeBlock = pxBlock->pxPreviousFreeBlock;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if( pxBlock->pxPreviousFreeBlock != NULL )
+    {
+        pxBlock->pxPreviousFreeBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+    }
+    else
+    {
+        /* The block was at the head of its list.  If the list is now empty
+         * clear its bit, and the first level bit if the whole range is
+         * empty. */
+        pxFreeLists[ uxFirstLevel ][ uxSecondLevel ] = pxBlock->pxNextFreeBlock;
+
+        if( pxBlock->pxNextFreeBlock == NULL )
+        {
+            ucSecondLevelBitmaps[ uxFirstLevel ] &= ( uint8_t ) ~( 1U << uxSecondLevel );
+
+            if( ucSecondLevelBitmaps[ uxFirstLevel ] == 0 )
+            {
+                ulFirstLevelBitmap &= ~( ( uint32_t ) 1 << uxFirstLevel );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetHeapStats( HeapStats_t * pxHeapStats )
+{
+    BlockHeader_t * pxBlock;
+    UBaseType_t uxFirstLevel, uxSecondLevel;
+    size_t xBlocks = 0, xMaxSize = 0, xMinSize = portMAX_DELAY; /* portMAX_DELAY used as a portable way of getting the maximum value. */
+
+    vTaskSuspendAll();
+    {
+        /* Statistics are not time critical, so simply visit every free
+         * list. */
+        for( uxFirstLevel = 0; uxFirstLevel < heapFL_INDEX_COUNT; uxFirstLevel++ )
+        {
+            for( uxSecondLevel = 0; uxSecondLevel < heapSL_INDEX_COUNT; uxSecondLevel++ )
+            {
+                for( pxBlock = pxFreeLists[ uxFirstLevel ][ uxSecondLevel ]; pxBlock != NULL; pxBlock = pxBlock->pxNextFreeBlock )
+                {
+                    xBlocks++;
+
+                    if( heapBLOCK_SIZE( pxBlock ) > xMaxSize )
+                    {
+                        xMaxSize = heapBLOCK_SIZE( pxBlock );
+                    }
+
+                    if( heapBLOCK_SIZE( pxBlock ) < xMinSize )
+                    {
+                        xMinSize = heapBLOCK_SIZE( pxBlock );
+                    }
+                }
+            }
+        }
+    }
+    ( void ) xTaskResumeAll();
+
+    pxHeapStats->xSizeOfLargestFreeBlockInBytes = xMaxSize;
+    pxHeapStats->xSizeOfSmallestFreeBlockInBytes = xMinSize;
+    pxHeapStats->xNumberOfFreeBlocks = xBlocks;
+
+    taskENTER_CRITICAL();
+    {
+        pxHeapStats->xAvailableHeapSpaceInBytes = xFreeBytesRemaining;
+        pxHeapStats->xNumberOfSuccessfulAllocations = xNumberOfSuccessfulAllocations;
+        pxHeapStats->xNumberOfSuccessfulFrees = xNumberOfSuccessfulFrees;
+        pxHeapStats->xMinimumEverFreeBytesRemaining = xMinimumEverFreeBytesRemaining;
+        pxHeapStats->xNumberOfFailedAllocations = xNumberOfFailedAllocations;
+    }
+    taskEXIT_CRITICAL();
+}
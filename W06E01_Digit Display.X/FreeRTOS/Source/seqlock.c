@@ -0,0 +1,376 @@
+/*
+ * FreeRTOS Kernel V10.4.6
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "seqlock.h"
+
+/* Lint e961, e750 and e9021 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021 See comment above. */
+
+typedef struct SeqLockDef_t
+{
+    volatile UBaseType_t uxSequence; /*< Incremented before and after every write, so it is odd while a write is in progress. */
+    volatile uint8_t * pucData;      /*< The snapshot. */
+    size_t xDataSize;                /*< The size of the snapshot in bytes. */
+
+    #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+        uint8_t ucStaticallyAllocated; /*< Set to pdTRUE if the sequence lock is statically allocated to ensure no attempt is made to free the memory. */
+    #endif
+} SeqLock_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Called by both xSeqLockCreate() and xSeqLockCreateStatic() to set up the
+ * structure and clear the snapshot.
+ */
+static void prvInitialiseNewSeqLock( SeqLock_t * pxSeqLock,
+                                     size_t xDataSize,
+                                     uint8_t * pucData ) PRIVILEGED_FUNCTION;
+
+/*
+ * Replaces the snapshot, bracketed by the two sequence increments.  The
+ * caller ensures no reader can run in between - see vSeqLockWrite().
+ */
+static void prvWriteSnapshot( SeqLock_t * pxSeqLock,
+                              const void * pvData ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copies the snapshot into pvBuffer.  The snapshot and the sequence number
+ * are both volatile, so the compiler cannot move the copy out from between
+ * the reads of the sequence number made by the caller.
+ */
+static void prvCopySnapshot( const SeqLock_t * pxSeqLock,
+                             void * pvBuffer ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+    SeqLockHandle_t xSeqLockCreate( size_t xDataSize )
+    {
+        SeqLock_t * pxSeqLock = NULL;
+
+        configASSERT( xDataSize > ( size_t ) 0 );
+
+        /* The structure and the snapshot are allocated in a single call to
+         * pvPortMalloc(), with the snapshot following the structure.  The
+         * snapshot is copied a byte at a time so needs no alignment. */
+        if( ( sizeof( SeqLock_t ) + xDataSize ) > xDataSize )
+        {
+            pxSeqLock = ( SeqLock_t * ) pvPortMalloc( sizeof( SeqLock_t ) + xDataSize ); /*lint !e9087 !e9079 see comment above. */
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( pxSeqLock != NULL )
+        {
+            prvInitialiseNewSeqLock( pxSeqLock, xDataSize, ( ( uint8_t * ) pxSeqLock ) + sizeof( SeqLock_t ) );
+
+            #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+                {
+                    /* Both static and dynamic allocation can be used, so note
+                     * this sequence lock was allocated dynamically in case it is
+                     * later deleted. */
+                    pxSeqLock->ucStaticallyAllocated = pdFALSE;
+                }
+            #endif /* configSUPPORT_STATIC_ALLOCATION */
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxSeqLock;
+    }
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+    SeqLockHandle_t xSeqLockCreateStatic( size_t xDataSize,
+                                          uint8_t * pucDataStorageArea,
+                                          StaticSeqLock_t * pxStaticSeqLock )
+    {
+        SeqLock_t * pxSeqLock = NULL;
+
+        configASSERT( pucDataStorageArea );
+        configASSERT( pxStaticSeqLock );
+        configASSERT( xDataSize > ( size_t ) 0 );
+
+        #if ( configASSERT_DEFINED == 1 )
+            {
+                /* Sanity check that the size of the structure used to declare a
+                 * variable of type StaticSeqLock_t equals the size of the real
+                 * sequence lock structure. */
+                volatile size_t xSize = sizeof( StaticSeqLock_t );
+                configASSERT( xSize == sizeof( SeqLock_t ) );
+            } /*lint !e529 xSize is referenced if configASSERT() is defined. */
+        #endif /* configASSERT_DEFINED */
+
+        if( ( pucDataStorageArea != NULL ) && ( pxStaticSeqLock != NULL ) )
+        {
+            pxSeqLock = ( SeqLock_t * ) pxStaticSeqLock; /*lint !e740 !e9087 StaticSeqLock_t is a pointer to a SeqLock_t, so guaranteed to be aligned and sized correctly (checked by an assert()). */
+            prvInitialiseNewSeqLock( pxSeqLock, xDataSize, pucDataStorageArea );
+
+            #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+                {
+                    /* Both static and dynamic allocation can be used, so note
+                     * that this sequence lock was created statically in case it
+                     * is later deleted. */
+                    pxSeqLock->ucStaticallyAllocated = pdTRUE;
+                }
+            #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxSeqLock;
+    }
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+void vSeqLockDelete( SeqLockHandle_t xSeqLock )
+{
+    SeqLock_t * pxSeqLock = xSeqLock;
+
+    configASSERT( pxSeqLock );
+
+    #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
+        {
+            /* The sequence lock can only have been allocated dynamically - free
+             * it again. */
+            vPortFree( pxSeqLock );
+        }
+    #elif ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+        {
+            /* The sequence lock could have been allocated statically or
+             * dynamically, so check before attempting to free the memory. */
+            if( pxSeqLock->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+            {
+                vPortFree( pxSeqLock );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    #else /* if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) ) */
+        {
+            ( void ) pxSeqLock;
+        }
+    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+}
+/*-----------------------------------------------------------*/
+
+void vSeqLockWrite( SeqLockHandle_t xSeqLock,
+                    const void * pvData )
+{
+    SeqLock_t * const pxSeqLock = xSeqLock;
+
+    configASSERT( pxSeqLock );
+    configASSERT( pvData );
+
+    /* With the scheduler suspended no reading task can run until the write
+     * is complete, so only interrupts can see a write in progress.  Unlike a
+     * critical section this does not delay interrupts. */
+    vTaskSuspendAll();
+    {
+        prvWriteSnapshot( pxSeqLock, pvData );
+    }
+    ( void ) xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+void vSeqLockWriteFromISR( SeqLockHandle_t xSeqLock,
+                           const void * pvData )
+{
+    SeqLock_t * const pxSeqLock = xSeqLock;
+
+    configASSERT( pxSeqLock );
+    configASSERT( pvData );
+
+    /* No task can run until the interrupt returns. */
+    prvWriteSnapshot( pxSeqLock, pvData );
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxSeqLockRead( SeqLockHandle_t xSeqLock,
+                           void * pvBuffer )
+{
+    const SeqLock_t * const pxSeqLock = xSeqLock;
+    UBaseType_t uxSequence;
+
+    configASSERT( pxSeqLock );
+    configASSERT( pvBuffer );
+
+    for( ; ; )
+    {
+        uxSequence = pxSeqLock->uxSequence;
+
+        /* A task never sees a write in progress, as the writer either
+         * suspends the scheduler or is an interrupt.  A write can still
+         * preempt the copy, in which case the sequence number changes. */
+        if( ( uxSequence & ( UBaseType_t ) 1 ) == ( UBaseType_t ) 0 )
+        {
+            prvCopySnapshot( pxSeqLock, pvBuffer );
+
+            if( pxSeqLock->uxSequence == uxSequence )
+            {
+                break;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+    return uxSequence;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xSeqLockReadFromISR( SeqLockHandle_t xSeqLock,
+                                void * pvBuffer,
+                                UBaseType_t * puxSequence )
+{
+    const SeqLock_t * const pxSeqLock = xSeqLock;
+    UBaseType_t uxSequence;
+    BaseType_t xReturn = pdFAIL;
+
+    configASSERT( pxSeqLock );
+    configASSERT( pvBuffer );
+
+    uxSequence = pxSeqLock->uxSequence;
+
+    /* If the interrupt occurred during a write it cannot wait for the write
+     * to complete.  The sequence number can still change during the copy if
+     * the writer is an interrupt that nests above this one. */
+    if( ( uxSequence & ( UBaseType_t ) 1 ) == ( UBaseType_t ) 0 )
+    {
+        prvCopySnapshot( pxSeqLock, pvBuffer );
+
+        if( pxSeqLock->uxSequence == uxSequence )
+        {
+            xReturn = pdPASS;
+
+            if( puxSequence != NULL )
+            {
+                *puxSequence = uxSequence;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewSeqLock( SeqLock_t * pxSeqLock,
+                                     size_t xDataSize,
+                                     uint8_t * pucData )
+{
+    size_t x;
+
+    pxSeqLock->uxSequence = 0;
+    pxSeqLock->pucData = pucData;
+    pxSeqLock->xDataSize = xDataSize;
+
+    for( x = 0; x < xDataSize; x++ )
+    {
+        pxSeqLock->pucData[ x ] = 0;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvWriteSnapshot( SeqLock_t * pxSeqLock,
+                              const void * pvData )
+{
+    const uint8_t * pucSource = ( const uint8_t * ) pvData;
+    size_t x;
+
+    /* A single writer, so the increments need not be atomic.  Readers only
+     * need to see each increment as a whole, which they do as UBaseType_t is
+     * the port's natural word size. */
+    pxSeqLock->uxSequence++;
+
+    for( x = 0; x < pxSeqLock->xDataSize; x++ )
+    {
+        pxSeqLock->pucData[ x ] = pucSource[ x ];
+    }
+
+    pxSeqLock->uxSequence++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCopySnapshot( const SeqLock_t * pxSeqLock,
+                             void * pvBuffer )
+{
+    uint8_t * pucDestination = ( uint8_t * ) pvBuffer;
+    size_t x;
+
+    for( x = 0; x < pxSeqLock->xDataSize; x++ )
+    {
+        pucDestination[ x ] = pxSeqLock->pucData[ x ];
+    }
+}
+/*-----------------------------------------------------------*/
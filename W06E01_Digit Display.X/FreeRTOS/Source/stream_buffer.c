@@ -153,6 +153,11 @@ typedef struct StreamBufferDef_t                 /*lint !e9058 Style convention
     #if ( configUSE_TRACE_FACILITY == 1 )
         UBaseType_t uxStreamBufferNumber; /* Used for tracing purposes. */
     #endif
+
+    #if ( configUSE_STREAM_BUFFER_IDLE_TIMEOUT == 1 )
+        TickType_t xIdleTicks;              /* If not 0, a waiting reader is also unblocked once no data has been written for this many ticks. */
+        volatile TickType_t xLastWriteTick; /* The tick count at the most recent write, used to detect the idle gap. */
+    #endif
 } StreamBuffer_t;
 
 /*
@@ -201,6 +206,38 @@ static size_t prvWriteMessageToBuffer( StreamBuffer_t * const pxStreamBuffer,
                                        size_t xSpace,
                                        size_t xRequiredSpace ) PRIVILEGED_FUNCTION;
 
+/*
+ * Scatter-gather equivalent of prvWriteMessageToBuffer().  Writes the
+ * uxFragmentCount fragments in pxFragments, which total xDataLengthBytes bytes,
+ * into the buffer behind at most one message length prefix, and only moves
+ * xHead once every fragment has been copied.
+ */
+static size_t prvWriteFragmentsToBuffer( StreamBuffer_t * const pxStreamBuffer,
+                                         const StreamBufferFragment_t * pxFragments,
+                                         UBaseType_t uxFragmentCount,
+                                         size_t xDataLengthBytes,
+                                         size_t xSpace,
+                                         size_t xRequiredSpace ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the number of bytes of free space a send of xDataLengthBytes needs
+ * before it can write to the buffer - including the length prefix if the
+ * stream buffer is being used as a message buffer.  *pxTicksToWait is set to
+ * zero if the send can never succeed, so the caller does not block for space
+ * that will never become available.
+ */
+static size_t prvSpaceRequiredToSend( const StreamBuffer_t * const pxStreamBuffer,
+                                      size_t xDataLengthBytes,
+                                      TickType_t * const pxTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * Blocks the calling task for up to xTicksToWait ticks waiting for at least
+ * xRequiredSpace bytes to become free, then returns the space available.
+ */
+static size_t prvWaitForSpaceToSend( StreamBuffer_t * const pxStreamBuffer,
+                                     size_t xRequiredSpace,
+                                     TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
 /*
  * Copies xCount bytes from the pxStreamBuffer's data storage area to pucData.
  * This function does not update the buffer's xTail pointer, so multiple reads
@@ -218,6 +255,41 @@ static size_t prvReadBytesFromBuffer( StreamBuffer_t * pxStreamBuffer,
                                       size_t xCount,
                                       size_t xTail ) PRIVILEGED_FUNCTION;
 
+/*
+ * Called after xBytesWritten bytes have been written to the buffer.  Returns
+ * pdTRUE if a task waiting to receive should be notified - that is, if the
+ * trigger level has been reached or, when an idle timeout is in use, if the
+ * write was the first into an empty buffer and so starts the reader's idle
+ * timer.
+ */
+static BaseType_t prvReceiverShouldBeNotified( const StreamBuffer_t * const pxStreamBuffer,
+                                               size_t xBytesWritten ) PRIVILEGED_FUNCTION;
+
+#if ( configUSE_STREAM_BUFFER_IDLE_TIMEOUT == 1 )
+
+/*
+ * Used by xStreamBufferReceive() when an idle timeout is set.  Blocks until
+ * the trigger level is reached, until data has been present but no more has
+ * arrived for xIdleTicks, or until xTicksToWait expires - whichever happens
+ * first - then returns the number of bytes available.
+ */
+    static size_t prvWaitForTriggerLevelOrIdle( StreamBuffer_t * const pxStreamBuffer,
+                                                TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * Sets xLastWriteTick to xTickCount if a write of xDataLengthBytes with xSpace
+ * bytes free will copy any bytes, the same test prvWriteMessageToBuffer() and
+ * prvWriteFragmentsToBuffer() make.  A send that fails therefore does not
+ * hold off the idle timeout.  Called before the write so the reader never
+ * sees new bytes with a stale write time.
+ */
+    static void prvRecordWriteTick( StreamBuffer_t * const pxStreamBuffer,
+                                    size_t xDataLengthBytes,
+                                    size_t xSpace,
+                                    size_t xRequiredSpace,
+                                    TickType_t xTickCount ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Called by both pxStreamBufferCreate() and pxStreamBufferCreateStatic() to
  * initialise the members of the newly created stream buffer structure.
@@ -424,6 +496,10 @@ BaseType_t xStreamBufferReset( StreamBufferHandle_t xStreamBuffer )
         UBaseType_t uxStreamBufferNumber;
     #endif
 
+    #if ( configUSE_STREAM_BUFFER_IDLE_TIMEOUT == 1 )
+        TickType_t xIdleTicks;
+    #endif
+
     configASSERT( pxStreamBuffer );
 
     #if ( configUSE_TRACE_FACILITY == 1 )
@@ -434,6 +510,13 @@ BaseType_t xStreamBufferReset( StreamBufferHandle_t xStreamBuffer )
         }
     #endif
 
+    #if ( configUSE_STREAM_BUFFER_IDLE_TIMEOUT == 1 )
+        {
+            /* The idle timeout, like the trigger level, survives a reset. */
+            xIdleTicks = pxStreamBuffer->xIdleTicks;
+        }
+    #endif
+
     /* Can only reset a message buffer if there are no tasks blocked on it. */
     taskENTER_CRITICAL();
     {
@@ -454,6 +537,12 @@ BaseType_t xStreamBufferReset( StreamBufferHandle_t xStreamBuffer )
                     }
                 #endif
 
+                #if ( configUSE_STREAM_BUFFER_IDLE_TIMEOUT == 1 )
+                    {
+                        pxStreamBuffer->xIdleTicks = xIdleTicks;
+                    }
+                #endif
+
                 traceSTREAM_BUFFER_RESET( xStreamBuffer );
             }
         }
@@ -494,6 +583,34 @@ BaseType_t xStreamBufferSetTriggerLevel( StreamBufferHandle_t xStreamBuffer,
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_STREAM_BUFFER_IDLE_TIMEOUT == 1 )
+
+    BaseType_t xStreamBufferSetIdleTimeout( StreamBufferHandle_t xStreamBuffer,
+                                            TickType_t xIdleTicks )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+        BaseType_t xReturn;
+
+        configASSERT( pxStreamBuffer );
+
+        /* Message buffers always unblock the reader as soon as a complete
+         * message is available, so an idle gap has no meaning for them. */
+        if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) == ( uint8_t ) 0 )
+        {
+            pxStreamBuffer->xIdleTicks = xIdleTicks;
+            xReturn = pdPASS;
+        }
+        else
+        {
+            xReturn = pdFAIL;
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_STREAM_BUFFER_IDLE_TIMEOUT */
+/*-----------------------------------------------------------*/
+
 size_t xStreamBufferSpacesAvailable( StreamBufferHandle_t xStreamBuffer )
 {
     const StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
@@ -545,14 +662,238 @@ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
                           TickType_t xTicksToWait )
 {
     StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
-    size_t xReturn, xSpace = 0;
+    size_t xReturn, xSpace;
+    size_t xRequiredSpace;
+
+    configASSERT( pvTxData );
+    configASSERT( pxStreamBuffer );
+
+    xRequiredSpace = prvSpaceRequiredToSend( pxStreamBuffer, xDataLengthBytes, &xTicksToWait );
+    xSpace = prvWaitForSpaceToSend( pxStreamBuffer, xRequiredSpace, xTicksToWait );
+
+    #if ( configUSE_STREAM_BUFFER_IDLE_TIMEOUT == 1 )
+        {
+            prvRecordWriteTick( pxStreamBuffer, xDataLengthBytes, xSpace, xRequiredSpace, xTaskGetTickCount() );
+        }
+    #endif
+
+    xReturn = prvWriteMessageToBuffer( pxStreamBuffer, pvTxData, xDataLengthBytes, xSpace, xRequiredSpace );
+
+    if( xReturn > ( size_t ) 0 )
+    {
+        traceSTREAM_BUFFER_SEND( xStreamBuffer, xReturn );
+
+        /* Was a task waiting for the data? */
+        if( prvReceiverShouldBeNotified( pxStreamBuffer, xReturn ) != pdFALSE )
+        {
+            sbSEND_COMPLETED( pxStreamBuffer );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+        traceSTREAM_BUFFER_SEND_FAILED( xStreamBuffer );
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferSendFromISR( StreamBufferHandle_t xStreamBuffer,
+                                 const void * pvTxData,
+                                 size_t xDataLengthBytes,
+                                 BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    size_t xReturn, xSpace;
     size_t xRequiredSpace = xDataLengthBytes;
-    TimeOut_t xTimeOut;
-    size_t xMaxReportedSpace = 0;
 
     configASSERT( pvTxData );
     configASSERT( pxStreamBuffer );
 
+    /* This send function is used to write to both message buffers and stream
+     * buffers.  If this is a message buffer then the space needed must be
+     * increased by the amount of bytes needed to store the length of the
+     * message. */
+    if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+    {
+        xRequiredSpace += sbBYTES_TO_STORE_MESSAGE_LENGTH;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+
+    #if ( configUSE_STREAM_BUFFER_IDLE_TIMEOUT == 1 )
+        {
+            prvRecordWriteTick( pxStreamBuffer, xDataLengthBytes, xSpace, xRequiredSpace, xTaskGetTickCountFromISR() );
+        }
+    #endif
+
+    xReturn = prvWriteMessageToBuffer( pxStreamBuffer, pvTxData, xDataLengthBytes, xSpace, xRequiredSpace );
+
+    if( xReturn > ( size_t ) 0 )
+    {
+        /* Was a task waiting for the data? */
+        if( prvReceiverShouldBeNotified( pxStreamBuffer, xReturn ) != pdFALSE )
+        {
+            sbSEND_COMPLETE_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xReturn );
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferSendFragments( StreamBufferHandle_t xStreamBuffer,
+                                   const StreamBufferFragment_t * pxFragments,
+                                   UBaseType_t uxFragmentCount,
+                                   TickType_t xTicksToWait )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    size_t xReturn, xSpace;
+    size_t xRequiredSpace, xDataLengthBytes = 0;
+    UBaseType_t uxFragment;
+
+    configASSERT( pxFragments );
+    configASSERT( pxStreamBuffer );
+
+    /* The fragments are sent as if they were one contiguous block, so the
+     * space needed is calculated from their combined length. */
+    for( uxFragment = 0; uxFragment < uxFragmentCount; uxFragment++ )
+    {
+        configASSERT( ( pxFragments[ uxFragment ].pvData != NULL ) || ( pxFragments[ uxFragment ].xLength == ( size_t ) 0 ) );
+        xDataLengthBytes += pxFragments[ uxFragment ].xLength;
+
+        /* Overflow? */
+        configASSERT( xDataLengthBytes >= pxFragments[ uxFragment ].xLength );
+    }
+
+    xRequiredSpace = prvSpaceRequiredToSend( pxStreamBuffer, xDataLengthBytes, &xTicksToWait );
+    xSpace = prvWaitForSpaceToSend( pxStreamBuffer, xRequiredSpace, xTicksToWait );
+
+    #if ( configUSE_STREAM_BUFFER_IDLE_TIMEOUT == 1 )
+        {
+            prvRecordWriteTick( pxStreamBuffer, xDataLengthBytes, xSpace, xRequiredSpace, xTaskGetTickCount() );
+        }
+    #endif
+
+    xReturn = prvWriteFragmentsToBuffer( pxStreamBuffer, pxFragments, uxFragmentCount, xDataLengthBytes, xSpace, xRequiredSpace );
+
+    if( xReturn > ( size_t ) 0 )
+    {
+        traceSTREAM_BUFFER_SEND( xStreamBuffer, xReturn );
+
+        /* Was a task waiting for the data?  Only one notification is sent
+         * however many fragments were written. */
+        if( prvReceiverShouldBeNotified( pxStreamBuffer, xReturn ) != pdFALSE )
+        {
+            sbSEND_COMPLETED( pxStreamBuffer );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+        traceSTREAM_BUFFER_SEND_FAILED( xStreamBuffer );
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferSendFragmentsFromISR( StreamBufferHandle_t xStreamBuffer,
+                                          const StreamBufferFragment_t * pxFragments,
+                                          UBaseType_t uxFragmentCount,
+                                          BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    size_t xReturn, xSpace;
+    size_t xRequiredSpace, xDataLengthBytes = 0;
+    UBaseType_t uxFragment;
+
+    configASSERT( pxFragments );
+    configASSERT( pxStreamBuffer );
+
+    for( uxFragment = 0; uxFragment < uxFragmentCount; uxFragment++ )
+    {
+        configASSERT( ( pxFragments[ uxFragment ].pvData != NULL ) || ( pxFragments[ uxFragment ].xLength == ( size_t ) 0 ) );
+        xDataLengthBytes += pxFragments[ uxFragment ].xLength;
+
+        /* Overflow? */
+        configASSERT( xDataLengthBytes >= pxFragments[ uxFragment ].xLength );
+    }
+
+    xRequiredSpace = xDataLengthBytes;
+
+    if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+    {
+        xRequiredSpace += sbBYTES_TO_STORE_MESSAGE_LENGTH;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+
+    #if ( configUSE_STREAM_BUFFER_IDLE_TIMEOUT == 1 )
+        {
+            prvRecordWriteTick( pxStreamBuffer, xDataLengthBytes, xSpace, xRequiredSpace, xTaskGetTickCountFromISR() );
+        }
+    #endif
+
+    xReturn = prvWriteFragmentsToBuffer( pxStreamBuffer, pxFragments, uxFragmentCount, xDataLengthBytes, xSpace, xRequiredSpace );
+
+    if( xReturn > ( size_t ) 0 )
+    {
+        /* Was a task waiting for the data? */
+        if( prvReceiverShouldBeNotified( pxStreamBuffer, xReturn ) != pdFALSE )
+        {
+            sbSEND_COMPLETE_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xReturn );
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvSpaceRequiredToSend( const StreamBuffer_t * const pxStreamBuffer,
+                                      size_t xDataLengthBytes,
+                                      TickType_t * const pxTicksToWait )
+{
+    size_t xRequiredSpace = xDataLengthBytes;
+    size_t xMaxReportedSpace;
+
     /* The maximum amount of space a stream buffer will ever report is its length
      * minus 1. */
     xMaxReportedSpace = pxStreamBuffer->xLength - ( size_t ) 1;
@@ -574,7 +915,7 @@ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
         {
             /* The message would not fit even if the entire buffer was empty,
              * so don't wait for space. */
-            xTicksToWait = ( TickType_t ) 0;
+            *pxTicksToWait = ( TickType_t ) 0;
         }
         else
         {
@@ -596,6 +937,17 @@ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
         }
     }
 
+    return xRequiredSpace;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvWaitForSpaceToSend( StreamBuffer_t * const pxStreamBuffer,
+                                     size_t xRequiredSpace,
+                                     TickType_t xTicksToWait )
+{
+    size_t xSpace = 0;
+    TimeOut_t xTimeOut;
+
     if( xTicksToWait != ( TickType_t ) 0 )
     {
         vTaskSetTimeOutState( &xTimeOut );
@@ -625,7 +977,7 @@ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
             }
             taskEXIT_CRITICAL();
 
-            traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer );
+            traceBLOCKING_ON_STREAM_BUFFER_SEND( pxStreamBuffer );
             ( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
             pxStreamBuffer->xTaskWaitingToSend = NULL;
         } while( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE );
@@ -644,100 +996,70 @@ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
         mtCOVERAGE_TEST_MARKER();
     }
 
-    xReturn = prvWriteMessageToBuffer( pxStreamBuffer, pvTxData, xDataLengthBytes, xSpace, xRequiredSpace );
-
-    if( xReturn > ( size_t ) 0 )
-    {
-        traceSTREAM_BUFFER_SEND( xStreamBuffer, xReturn );
-
-        /* Was a task waiting for the data? */
-        if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
-        {
-            sbSEND_COMPLETED( pxStreamBuffer );
-        }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
-        }
-    }
-    else
-    {
-        mtCOVERAGE_TEST_MARKER();
-        traceSTREAM_BUFFER_SEND_FAILED( xStreamBuffer );
-    }
-
-    return xReturn;
+    return xSpace;
 }
 /*-----------------------------------------------------------*/
 
-size_t xStreamBufferSendFromISR( StreamBufferHandle_t xStreamBuffer,
-                                 const void * pvTxData,
-                                 size_t xDataLengthBytes,
-                                 BaseType_t * const pxHigherPriorityTaskWoken )
+static size_t prvWriteMessageToBuffer( StreamBuffer_t * const pxStreamBuffer,
+                                       const void * pvTxData,
+                                       size_t xDataLengthBytes,
+                                       size_t xSpace,
+                                       size_t xRequiredSpace )
 {
-    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
-    size_t xReturn, xSpace;
-    size_t xRequiredSpace = xDataLengthBytes;
-
-    configASSERT( pvTxData );
-    configASSERT( pxStreamBuffer );
+    size_t xNextHead = pxStreamBuffer->xHead;
 
-    /* This send function is used to write to both message buffers and stream
-     * buffers.  If this is a message buffer then the space needed must be
-     * increased by the amount of bytes needed to store the length of the
-     * message. */
     if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
     {
-        xRequiredSpace += sbBYTES_TO_STORE_MESSAGE_LENGTH;
-    }
-    else
-    {
-        mtCOVERAGE_TEST_MARKER();
-    }
-
-    xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
-    xReturn = prvWriteMessageToBuffer( pxStreamBuffer, pvTxData, xDataLengthBytes, xSpace, xRequiredSpace );
+        /* This is a message buffer, as opposed to a stream buffer. */
 
-    if( xReturn > ( size_t ) 0 )
-    {
-        /* Was a task waiting for the data? */
-        if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+        if( xSpace >= xRequiredSpace )
         {
-            sbSEND_COMPLETE_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+            /* There is enough space to write both the message length and the message
+             * itself into the buffer.  Start by writing the length of the data, the data
+             * itself will be written later in this function. */
+            xNextHead = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) &( xDataLengthBytes ), sbBYTES_TO_STORE_MESSAGE_LENGTH, xNextHead );
         }
         else
         {
-            mtCOVERAGE_TEST_MARKER();
+            /* Not enough space, so do not write data to the buffer. */
+            xDataLengthBytes = 0;
         }
     }
     else
     {
-        mtCOVERAGE_TEST_MARKER();
+        /* This is a stream buffer, as opposed to a message buffer, so writing a
+         * stream of bytes rather than discrete messages.  Plan to write as many
+         * bytes as possible. */
+        xDataLengthBytes = configMIN( xDataLengthBytes, xSpace );
     }
 
-    traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xReturn );
+    if( xDataLengthBytes != ( size_t ) 0 )
+    {
+        /* Write the data to the buffer. */
+        pxStreamBuffer->xHead = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) pvTxData, xDataLengthBytes, xNextHead ); /*lint !e9079 Storage buffer is implemented as uint8_t for ease of sizing, alignment and access. */
+    }
 
-    return xReturn;
+    return xDataLengthBytes;
 }
 /*-----------------------------------------------------------*/
 
-static size_t prvWriteMessageToBuffer( StreamBuffer_t * const pxStreamBuffer,
-                                       const void * pvTxData,
-                                       size_t xDataLengthBytes,
-                                       size_t xSpace,
-                                       size_t xRequiredSpace )
+static size_t prvWriteFragmentsToBuffer( StreamBuffer_t * const pxStreamBuffer,
+                                         const StreamBufferFragment_t * pxFragments,
+                                         UBaseType_t uxFragmentCount,
+                                         size_t xDataLengthBytes,
+                                         size_t xSpace,
+                                         size_t xRequiredSpace )
 {
     size_t xNextHead = pxStreamBuffer->xHead;
+    size_t xBytesToWrite, xFragmentBytes;
+    UBaseType_t uxFragment;
 
     if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
     {
-        /* This is a message buffer, as opposed to a stream buffer. */
-
         if( xSpace >= xRequiredSpace )
         {
-            /* There is enough space to write both the message length and the message
-             * itself into the buffer.  Start by writing the length of the data, the data
-             * itself will be written later in this function. */
+            /* One length prefix covers every fragment, so the reader sees a
+             * single message of the combined length. */
             xNextHead = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) &( xDataLengthBytes ), sbBYTES_TO_STORE_MESSAGE_LENGTH, xNextHead );
         }
         else
@@ -748,16 +1070,32 @@ static size_t prvWriteMessageToBuffer( StreamBuffer_t * const pxStreamBuffer,
     }
     else
     {
-        /* This is a stream buffer, as opposed to a message buffer, so writing a
-         * stream of bytes rather than discrete messages.  Plan to write as many
-         * bytes as possible. */
+        /* Stream buffer - write as many bytes as possible, in fragment
+         * order. */
         xDataLengthBytes = configMIN( xDataLengthBytes, xSpace );
     }
 
+    xBytesToWrite = xDataLengthBytes;
+
+    for( uxFragment = 0; ( uxFragment < uxFragmentCount ) && ( xBytesToWrite > ( size_t ) 0 ); uxFragment++ )
+    {
+        xFragmentBytes = configMIN( pxFragments[ uxFragment ].xLength, xBytesToWrite );
+
+        if( xFragmentBytes != ( size_t ) 0 )
+        {
+            xNextHead = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) pxFragments[ uxFragment ].pvData, xFragmentBytes, xNextHead ); /*lint !e9079 Storage buffer is implemented as uint8_t for ease of sizing, alignment and access. */
+            xBytesToWrite -= xFragmentBytes;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
     if( xDataLengthBytes != ( size_t ) 0 )
     {
-        /* Write the data to the buffer. */
-        pxStreamBuffer->xHead = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) pvTxData, xDataLengthBytes, xNextHead ); /*lint !e9079 Storage buffer is implemented as uint8_t for ease of sizing, alignment and access. */
+        /* Publish every fragment to the reader at once. */
+        pxStreamBuffer->xHead = xNextHead;
     }
 
     return xDataLengthBytes;
@@ -789,6 +1127,15 @@ size_t xStreamBufferReceive( StreamBufferHandle_t xStreamBuffer,
         xBytesToStoreMessageLength = 0;
     }
 
+    #if ( configUSE_STREAM_BUFFER_IDLE_TIMEOUT == 1 )
+        if( ( xTicksToWait != ( TickType_t ) 0 ) && ( pxStreamBuffer->xIdleTicks != ( TickType_t ) 0 ) )
+        {
+            /* Only stream buffers can have an idle timeout, so
+             * xBytesToStoreMessageLength is 0 here. */
+            xBytesAvailable = prvWaitForTriggerLevelOrIdle( pxStreamBuffer, xTicksToWait );
+        }
+        else
+    #endif /* configUSE_STREAM_BUFFER_IDLE_TIMEOUT */
     if( xTicksToWait != ( TickType_t ) 0 )
     {
         /* Checking if there is data and clearing the notification state must be
@@ -1138,6 +1485,165 @@ BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuf
 }
 /*-----------------------------------------------------------*/
 
+static BaseType_t prvReceiverShouldBeNotified( const StreamBuffer_t * const pxStreamBuffer,
+                                               size_t xBytesWritten )
+{
+    size_t xBytesInBuffer;
+    BaseType_t xReturn;
+
+    xBytesInBuffer = prvBytesInBuffer( pxStreamBuffer );
+
+    if( xBytesInBuffer >= pxStreamBuffer->xTriggerLevelBytes )
+    {
+        xReturn = pdTRUE;
+    }
+    else
+    {
+        xReturn = pdFALSE;
+    }
+
+    #if ( configUSE_STREAM_BUFFER_IDLE_TIMEOUT == 1 )
+        {
+            /* A reader using an idle timeout must be told when the first bytes
+             * of a burst arrive so it can start timing the gap that ends the
+             * burst.  Later bytes in the same burst do not notify it. */
+            if( ( pxStreamBuffer->xIdleTicks != ( TickType_t ) 0 ) && ( xBytesInBuffer == xBytesWritten ) )
+            {
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    #else /* if ( configUSE_STREAM_BUFFER_IDLE_TIMEOUT == 1 ) */
+        {
+            ( void ) xBytesWritten;
+        }
+    #endif /* configUSE_STREAM_BUFFER_IDLE_TIMEOUT */
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_STREAM_BUFFER_IDLE_TIMEOUT == 1 )
+
+    static void prvRecordWriteTick( StreamBuffer_t * const pxStreamBuffer,
+                                    size_t xDataLengthBytes,
+                                    size_t xSpace,
+                                    size_t xRequiredSpace,
+                                    TickType_t xTickCount )
+    {
+        BaseType_t xWillWrite;
+
+        if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+        {
+            xWillWrite = ( xSpace >= xRequiredSpace ) ? pdTRUE : pdFALSE;
+        }
+        else
+        {
+            xWillWrite = ( xSpace > ( size_t ) 0 ) ? pdTRUE : pdFALSE;
+        }
+
+        if( ( xWillWrite != pdFALSE ) && ( xDataLengthBytes > ( size_t ) 0 ) )
+        {
+            pxStreamBuffer->xLastWriteTick = xTickCount;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* configUSE_STREAM_BUFFER_IDLE_TIMEOUT */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_STREAM_BUFFER_IDLE_TIMEOUT == 1 )
+
+    static size_t prvWaitForTriggerLevelOrIdle( StreamBuffer_t * const pxStreamBuffer,
+                                                TickType_t xTicksToWait )
+    {
+        size_t xBytesAvailable;
+        TickType_t xTicksToBlock, xTicksSinceLastWrite;
+        TimeOut_t xTimeOut;
+
+        vTaskSetTimeOutState( &xTimeOut );
+
+        for( ; ; )
+        {
+            /* Checking the data and clearing the notification state must be
+             * performed atomically. */
+            taskENTER_CRITICAL();
+            {
+                xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+                if( xBytesAvailable >= pxStreamBuffer->xTriggerLevelBytes )
+                {
+                    /* Enough data to satisfy the trigger level. */
+                    xTicksToBlock = 0;
+                }
+                else if( xBytesAvailable == ( size_t ) 0 )
+                {
+                    /* Nothing yet - the writer will notify this task when the
+                     * first byte arrives. */
+                    xTicksToBlock = xTicksToWait;
+                }
+                else
+                {
+                    /* Part of a burst is present.  Wait for either the
+                     * trigger level or the remainder of the idle gap. */
+                    xTicksSinceLastWrite = xTaskGetTickCount() - pxStreamBuffer->xLastWriteTick;
+
+                    if( xTicksSinceLastWrite >= pxStreamBuffer->xIdleTicks )
+                    {
+                        xTicksToBlock = 0;
+                    }
+                    else
+                    {
+                        xTicksToBlock = configMIN( xTicksToWait, pxStreamBuffer->xIdleTicks - xTicksSinceLastWrite );
+                    }
+                }
+
+                if( xTicksToBlock != ( TickType_t ) 0 )
+                {
+                    /* Clear notification state as going to wait for data. */
+                    ( void ) xTaskNotifyStateClear( NULL );
+
+                    /* Should only be one reader. */
+                    configASSERT( pxStreamBuffer->xTaskWaitingToReceive == NULL );
+                    pxStreamBuffer->xTaskWaitingToReceive = xTaskGetCurrentTaskHandle();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            if( xTicksToBlock == ( TickType_t ) 0 )
+            {
+                break;
+            }
+
+            traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( pxStreamBuffer );
+            ( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToBlock );
+            pxStreamBuffer->xTaskWaitingToReceive = NULL;
+
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+            {
+                /* The overall block time has expired, so return whatever has
+                 * arrived. */
+                xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+                break;
+            }
+        }
+
+        return xBytesAvailable;
+    }
+
+#endif /* configUSE_STREAM_BUFFER_IDLE_TIMEOUT */
+/*-----------------------------------------------------------*/
+
 static size_t prvWriteBytesToBuffer( StreamBuffer_t * const pxStreamBuffer,
                                      const uint8_t * pucData,
                                      size_t xCount,
@@ -3297,6 +3297,63 @@ void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem,
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_EVENT_GROUP_DIRECT_FROM_ISR == 1 )
+
+    BaseType_t xTaskRemoveFromUnorderedEventListFromISR( ListItem_t * pxEventListItem,
+                                                         const TickType_t xItemValue )
+    {
+        TCB_t * pxUnblockedTCB;
+        BaseType_t xReturn;
+
+        /* THIS FUNCTION MUST BE CALLED FROM A CRITICAL SECTION.  It is used by
+         * the event flags implementation, which only calls it when no task is
+         * accessing the event list. */
+
+        /* Store the new item value in the event list. */
+        listSET_LIST_ITEM_VALUE( pxEventListItem, xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+
+        pxUnblockedTCB = listGET_LIST_ITEM_OWNER( pxEventListItem ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+        configASSERT( pxUnblockedTCB );
+        listREMOVE_ITEM( pxEventListItem );
+
+        if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+        {
+            listREMOVE_ITEM( &( pxUnblockedTCB->xStateListItem ) );
+            prvAddTaskToReadyList( pxUnblockedTCB );
+
+            #if ( configUSE_TICKLESS_IDLE != 0 )
+                {
+                    /* See xTaskRemoveFromEventList(). */
+                    prvResetNextTaskUnblockTime();
+                }
+            #endif
+        }
+        else
+        {
+            /* The delayed and ready lists cannot be accessed, so hold this task
+             * pending until the scheduler is resumed.  The item value is kept. */
+            listINSERT_END( &( xPendingReadyList ), pxEventListItem );
+        }
+
+        if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+        {
+            xReturn = pdTRUE;
+
+            /* Mark that a yield is pending in case the user is not using the
+             * "xHigherPriorityTaskWoken" parameter to an ISR safe FreeRTOS function. */
+            xYieldPending = pdTRUE;
+        }
+        else
+        {
+            xReturn = pdFALSE;
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_EVENT_GROUP_DIRECT_FROM_ISR */
+/*-----------------------------------------------------------*/
+
 void vTaskSetTimeOutState( TimeOut_t * const pxTimeOut )
 {
     configASSERT( pxTimeOut );
@@ -3551,6 +3608,8 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
                 }
             }
         #endif /* configUSE_TICKLESS_IDLE */
+
+        portIDLE_TASK_HOOK();
     }
 }
 /*-----------------------------------------------------------*/
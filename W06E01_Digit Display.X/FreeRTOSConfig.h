@@ -45,7 +45,7 @@ For other frequency values, update clock_config.h with your own settings. */
 #define configTOTAL_HEAP_SIZE 0x1000
 #define configAPPLICATION_ALLOCATED_HEAP 0
 /* Hook function related definitions. */
-#define configUSE_IDLE_HOOK 0
+#define configUSE_IDLE_HOOK 1
 #define configUSE_TICK_HOOK 0
 #define configCHECK_FOR_STACK_OVERFLOW 0
 #define configUSE_MALLOC_FAILED_HOOK 0
@@ -10,18 +10,35 @@
  * seven segment display. Otherwise letter E is displayed. Serail terminal
  * also tells, if a character is accepted or rejected.
  * 
+ * Characters are received in the USART0 RXC interrupt into a stream buffer.
+ * All tasks block while there is nothing to do, so the CPU idles between
+ * characters. Idle hook counts idle loop passes, idle time is printed every
+ * IDLE_REPORT_INTERVAL_S seconds. 100 % is the pass count of a fully idle
+ * CPU, measured at startup before the other tasks are created.
+ * 
  * Created on November 29, 2021, 14:20
  */
 
 
 #include <avr/io.h>
+#include <avr/interrupt.h>
 #include "FreeRTOS.h"
 // Copied from course material
 #include "clock_config.h"   
 #include "task.h"
 #include "queue.h"
+#include "semphr.h"
+#include "stream_buffer.h"
 // Used to send strings to serial terminal
 #include <string.h>         
+#include <stdio.h>
+
+#include "segdisplay.h"
+
+// Seconds between idle time reports, 0 disables the reports
+#define IDLE_REPORT_INTERVAL_S 10
+// Milliseconds of idle loop passes counted at startup for 100 %
+#define IDLE_CALIBRATION_MS 1000
 
 // Setting macro to apply BAUD RATE
 // Copied from Microchip's Getting Started with USART
@@ -33,23 +50,12 @@
 static QueueHandle_t number_queue;
 // Queue for USART messages
 static QueueHandle_t message_queue;
-
-// Seven sgement digits 0-9, letter E and blank.
-const uint8_t digit[] =
-{
-    0b00111111,     // 0
-    0b00000110,
-    0b01011011,
-    0b01001111,
-    0b01100110,
-    0b01101101,     // 5
-    0b01111101,
-    0b00000111,
-    0b01111111,
-    0b01101111,     // 9
-    0b01111001,     // E
-    0b00000000      // blank
-};
+// Characters from the USART0 receive interrupt
+static StreamBufferHandle_t rx_stream;
+// Serialises the strings sent to the serial terminal
+static SemaphoreHandle_t usart_mutex;
+// Idle loop passes, counted by the idle hook
+static volatile uint32_t idle_counter;
 
 // Function to initialize queues
 void queue_init(void)
@@ -58,20 +64,31 @@ void queue_init(void)
     const uint8_t number_queue_len = 10;
     const uint8_t message_queue_len = 10;
     
+    // Setting size of the receive stream buffer
+    const uint8_t rx_stream_len = 16;
+    
     // Create queues, and set their size to size of uint8_t (1 byte)
     number_queue = xQueueCreate(number_queue_len, sizeof(uint8_t));
     message_queue = xQueueCreate(message_queue_len, sizeof(uint8_t));
+    // Receiver wakes up on every character
+    rx_stream = xStreamBufferCreate(rx_stream_len, 1);
+    usart_mutex = xSemaphoreCreateMutex();
 }
 
-// Copied from Microchip's Getting Started with USART
-// Used to read serial terminal commands
-uint8_t USART0_read(void)
+// Puts received characters to the stream buffer
+ISR(USART0_RXC_vect)
 {
-    while (!(USART0.STATUS & USART_RXCIF_bm))
+    BaseType_t woken = pdFALSE;
+    // Reading RXDATAL clears the interrupt flag
+    char c = USART0.RXDATAL;
+    
+    // Character is dropped if the buffer is full
+    xStreamBufferSendFromISR(rx_stream, &c, 1, &woken);
+    // Switch to the receiver right away if it has higher priority
+    if(woken == pdTRUE)
     {
-        ;
+        portYIELD_FROM_ISR();
     }
-    return USART0.RXDATAL;
 }
 
 // Copied from Microchip's Getting Started with USART
@@ -107,6 +124,14 @@ void USART0_init(void)
     USART0.BAUD = (uint16_t)USART0_BAUD_RATE(9600);
     // Enable receiver and transmitter
     USART0.CTRLB |= (USART_RXEN_bm) | (USART_TXEN_bm);
+    // Enable receive complete interrupt
+    USART0.CTRLA |= USART_RXCIE_bm;
+}
+
+// Counts idle loop passes, runs whenever no other task is ready
+void vApplicationIdleHook(void)
+{
+    idle_counter++;
 }
 
 // Task method to send messages to serial terminal
@@ -117,9 +142,11 @@ void message_send(void* parameter)
     // This task will run indefinitely
     for(;;)
     {  
-        // Checking if there is a message in the queue
-        if (xQueueReceive(message_queue, (void *)&rcv_msg, 0) == pdTRUE) 
+        // Waiting for a message in the queue
+        if (xQueueReceive(message_queue, (void *)&rcv_msg, portMAX_DELAY)
+            == pdTRUE) 
         {
+            xSemaphoreTake(usart_mutex, portMAX_DELAY);
             // Cheking if received message is number 0-9
             if(rcv_msg >= '0' && rcv_msg <= '9')
             {
@@ -131,6 +158,7 @@ void message_send(void* parameter)
                 // Sending error message, because message was not a digit
                 USART0_sendString("Error! Not a valid digit\r\n");
             }
+            xSemaphoreGive(usart_mutex);
         }
     }
     // Above loop will not end, but vTaskDelete is used to delete 
@@ -146,8 +174,8 @@ void message_receive(void* parameter)
     // This task will run indefinitely
     for(;;)
     {
-        // Reading serial terminal and save received command to variable
-        msg = USART0_read();
+        // Waiting for a character from the receive interrupt
+        xStreamBufferReceive(rx_stream, &msg, 1, portMAX_DELAY);
         // Send message to number queue
         xQueueSend(number_queue, (void *)&msg, 10);
         // Send message to msg queue
@@ -161,99 +189,45 @@ void message_receive(void* parameter)
 // Task method which handles displayed numbers
 void seven_segment_numbers(void* parameter)
 {
-    // Set PF5 (on-board LED) as output.
-    // Drives the 7-segment grounding transistor.
-    PORTF.DIRSET = PIN5_bm;
-    // Set PF5 HIGH to ground the 7-segment display
-    // (and turn off the on-board LED)
-    PORTF.OUTSET = PIN5_bm;
-    
-    // Set PORTC (seven segment display) as output
-    PORTC.DIRSET = 0xFF;
-    
     // Create variable to hold received message from number_queue
     char rcv_msg;
-    // Array index to set number to seven segment display
-    // Default 11 to display blank
-    uint8_t index = 11;
     // This task will run indefinitely
     for(;;)
     {
-        // Checking if there is a character in the queue
-        if (xQueueReceive(number_queue, (void *)&rcv_msg, 0) == pdTRUE) 
+        // Waiting for a character in the queue
+        if (xQueueReceive(number_queue, (void *)&rcv_msg, portMAX_DELAY)
+            == pdTRUE) 
         {
-            // Switch-case to display number if received character is a number
-            // Otherwise displays a letter E
-            switch(rcv_msg)
+            // Display number if received character is a number
+            // Otherwise displays a letter E. Display driver writes the
+            // segments straight to the pins.
+            if(rcv_msg >= '0' && rcv_msg <= '9')
+            {
+                seg_set_char(rcv_msg);
+            }
+            else
             {
-                case '0':
-                    index = 0;
-                    break;
-                
-                case '1':
-                    index = 1;
-                    break;
-                
-                case '2':
-                    index = 2;
-                    break;
-                
-                case '3':
-                    index = 3;
-                    break;
-                
-                case '4':
-                    index = 4;
-                    break;
-                
-                case '5':
-                    index = 5;
-                    break;
-                
-                case '6':
-                    index = 6;
-                    break;
-                
-                case '7':
-                    index = 7;
-                    break;
-                
-                case '8':
-                    index = 8;
-                    break;
-                
-                case '9':
-                    index = 9;
-                    break;
-                // If non of comparison above is true, then display letter E
-                default:
-                    index = 10;
-                    break;
-            };
+                seg_set_char('E');
+            }
         }
-        // Display digit on the seven segment display
-        VPORTC.OUT = digit[index];
     }
     // Above loop will not end, but vTaskDelete is used to delete 
     // a finished task.
     vTaskDelete(NULL);
 }
 
-
-int main(void)
+// Creates the tasks that handle the characters
+void tasks_create(void)
 {
-    // Call queue_init to intialize both queues
-    queue_init();
-    // Call USART0_init to initialize USART communication
-    USART0_init();
-    
+    // Tasks block on their queues, so they run above idle priority
+    // and idle task gets all time that is left
     // Create a new task for seven_segment_numbers
     xTaskCreate(
         seven_segment_numbers,
         "number",
         configMINIMAL_STACK_SIZE,
         NULL,
-        tskIDLE_PRIORITY,
+        tskIDLE_PRIORITY + 1,
         NULL
     );
     // Create a new task for message_send
@@ -262,7 +236,7 @@ int main(void)
         "send",
         configMINIMAL_STACK_SIZE,
         NULL,
-        tskIDLE_PRIORITY,
+        tskIDLE_PRIORITY + 1,
         NULL
     );    
     // Create a new task for message_receive
@@ -271,9 +245,83 @@ int main(void)
         "receive",
         configMINIMAL_STACK_SIZE,
         NULL,
-        tskIDLE_PRIORITY,
+        tskIDLE_PRIORITY + 1,
         NULL
     ); 
+}
+
+#if IDLE_REPORT_INTERVAL_S > 0
+// Task method that prints share of time spent in the idle task
+void idle_report(void* parameter)
+{
+    TickType_t last_wake;
+    uint32_t last_count;
+    // Idle loop passes of a fully idle CPU in an interval, stands for 100 %
+    uint32_t idle_count;
+    char report[40];
+    
+    // Only this task and the idle task exist, so the idle task gets all
+    // the time this task sleeps, except for the interrupts
+    last_count = idle_counter;
+    vTaskDelay(pdMS_TO_TICKS(IDLE_CALIBRATION_MS));
+    idle_count = (idle_counter - last_count) *
+                 (IDLE_REPORT_INTERVAL_S * 1000UL / IDLE_CALIBRATION_MS);
+    if(idle_count == 0)
+    {
+        idle_count = 1;
+    }
+    tasks_create();
+    
+    last_wake = xTaskGetTickCount();
+    last_count = idle_counter;
+    // This task will run indefinitely
+    for(;;)
+    {
+        vTaskDelayUntil(&last_wake,
+                        pdMS_TO_TICKS(IDLE_REPORT_INTERVAL_S * 1000UL));
+        uint32_t count = idle_counter;
+        uint32_t passes = count - last_count;
+        uint32_t percent = passes * 100 / idle_count;
+        last_count = count;
+        // Counts differ a little from one interval to the next
+        if(percent > 100)
+        {
+            percent = 100;
+        }
+        snprintf(report, sizeof(report), "IDLE: %u %% (%lu passes)\r\n",
+                 (unsigned int)percent,
+                 (unsigned long)passes);
+        xSemaphoreTake(usart_mutex, portMAX_DELAY);
+        USART0_sendString(report);
+        xSemaphoreGive(usart_mutex);
+    }
+}
+#endif
+
+
+int main(void)
+{
+    // Call queue_init to intialize both queues
+    queue_init();
+    // Call USART0_init to initialize USART communication
+    USART0_init();
+    // Initialize seven segment display, blank until first character
+    seg_init();
+    
+#if IDLE_REPORT_INTERVAL_S > 0
+    // Create a new task for idle_report, snprintf needs more stack.
+    // It measures a fully idle CPU first and then creates the other tasks.
+    xTaskCreate(
+        idle_report,
+        "report",
+        configMINIMAL_STACK_SIZE * 2,
+        NULL,
+        tskIDLE_PRIORITY + 1,
+        NULL
+    );
+#else
+    tasks_create();
+#endif
     // Start the scheduler
     vTaskStartScheduler();
     // Scheduler will not return
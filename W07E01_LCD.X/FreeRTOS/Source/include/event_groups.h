@@ -511,6 +511,14 @@ EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup,
  * context of the timer task - where a scheduler lock is used in place of a
  * critical section.
  *
+ * If configUSE_EVENT_GROUP_DIRECT_FROM_ISR is set to 1 in FreeRTOSConfig.h
+ * then the bits are set, and the waiting tasks unblocked, in the interrupt
+ * itself when no more than configEVENT_GROUP_ISR_MAX_WAITERS tasks have to be
+ * tested.  If a task is accessing the event group at the time the set is
+ * completed by that task as soon as it is done.  Larger sets are still sent to
+ * the timer task.  *pxHigherPriorityTaskWoken is then also set to pdTRUE if
+ * an unblocked task has a priority above that of the interrupted task.
+ *
  * @param xEventGroup The event group in which the bits are to be set.
  *
  * @param uxBitsToSet A bitwise value that indicates the bit or bits to set.
@@ -567,7 +575,7 @@ EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup,
  * \defgroup xEventGroupSetBitsFromISR xEventGroupSetBitsFromISR
  * \ingroup EventGroup
  */
-#if ( configUSE_TRACE_FACILITY == 1 )
+#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( configUSE_EVENT_GROUP_DIRECT_FROM_ISR == 1 ) )
     BaseType_t xEventGroupSetBitsFromISR( EventGroupHandle_t xEventGroup,
                                           const EventBits_t uxBitsToSet,
                                           BaseType_t * pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
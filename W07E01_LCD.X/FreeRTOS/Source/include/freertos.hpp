@@ -0,0 +1,404 @@
+/*
+ * FreeRTOS Kernel V10.4.6
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Typed C++ wrappers for queues, software timers and tasks.  Every object
+ * holds its own control block and storage and is created in its constructor
+ * through the xQueueCreateStatic(), xTimerCreateStatic() and
+ * xTaskCreateStatic() API functions, so nothing is taken from the FreeRTOS
+ * heap and the sizes are fixed at compile time:
+ *
+ * @code{cpp}
+ * freertos::Queue< ADC_result_t, 1 > xLcdData;
+ * freertos::Timer< pdMS_TO_TICKS( 200 ), true, vScrollCallback > xScroll( "Scroll" );
+ * freertos::Task< configMINIMAL_STACK_SIZE, 1, vDisplayTask > xDisplay( "display" );
+ * @endcode
+ *
+ * The callback of a timer and the function of a task are template arguments
+ * that are passed to the kernel unchanged, and the handle of an object is the
+ * address of its control block, which is what the static create functions
+ * return anyway.  All the member functions are inline calls of the C API, so
+ * the wrappers generate no more code and use no more RAM than the C calls they
+ * replace.  Stack depths, priorities, queue lengths and timer periods are
+ * checked against FreeRTOSConfig.h with static_assert.
+ *
+ * Objects at file scope are created before main() runs, which is allowed as
+ * the scheduler does not need to be running to create a queue, a timer or a
+ * task.  The objects cannot be copied.  The destructors delete the kernel
+ * objects with vQueueDelete(), xTimerDelete() and vTaskDelete(), so objects
+ * with automatic storage or created with new can be destroyed like any other
+ * C++ object, as long as:
+ *
+ * - no task is blocked on a queue that is destroyed (as for vQueueDelete());
+ * - a timer is not destroyed from a timer callback, and is only destroyed
+ *   before the scheduler starts if it is never started - the timer task must
+ *   process the delete command while the object still exists, which ~Timer()
+ *   waits for when the scheduler is running, blocked on a task notification
+ *   at freertosTIMER_DELETE_NOTIFY_INDEX.  A Timer that is destroyed needs
+ *   INCLUDE_xTimerPendFunctionCall, INCLUDE_xTaskGetSchedulerState and
+ *   INCLUDE_xTaskGetCurrentTaskHandle set to 1 and
+ *   configTASK_NOTIFICATION_ARRAY_ENTRIES of at least 2, which static_assert
+ *   checks;
+ * - a task does not destroy its own Task object.
+ *
+ * Remember a Task holds its whole stack, which is usually too big for the
+ * stack of the task creating it.
+ *
+ * configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h, and
+ * the application must then provide vApplicationGetIdleTaskMemory() (and
+ * vApplicationGetTimerTaskMemory() if configUSE_TIMERS is 1).  Needs C++11.
+ */
+
+#ifndef FREERTOS_HPP
+#define FREERTOS_HPP
+
+#ifndef __cplusplus
+    #error "freertos.hpp can only be included from C++ source files"
+#endif
+
+#include "FreeRTOS.h"
+#include "queue.h"
+#include "task.h"
+
+#if ( configUSE_TIMERS == 1 )
+    #include "timers.h"
+
+/* The notification index ~Timer() waits on.  The application must not use
+ * it, so configTASK_NOTIFICATION_ARRAY_ENTRIES must be at least 2 for a Timer
+ * to be destroyed. */
+    #ifndef freertosTIMER_DELETE_NOTIFY_INDEX
+        #define freertosTIMER_DELETE_NOTIFY_INDEX    ( configTASK_NOTIFICATION_ARRAY_ENTRIES - 1 )
+    #endif
+#endif
+
+#if ( configSUPPORT_STATIC_ALLOCATION != 1 )
+    #error "freertos.hpp allocates statically, set configSUPPORT_STATIC_ALLOCATION to 1 in FreeRTOSConfig.h"
+#endif
+
+namespace freertos
+{
+/*-----------------------------------------------------------*/
+
+/**
+ * A queue of uxLength items of type T.  Items are copied in and out of the
+ * queue byte by byte, so T must be trivially copyable.
+ */
+    template< typename T, UBaseType_t uxLength >
+    class Queue
+    {
+        static_assert( uxLength > 0, "a queue must hold at least one item" );
+        static_assert( __is_trivially_copyable( T ), "queue items are copied with memcpy()" );
+
+        public:
+            Queue()
+            {
+                ( void ) xQueueCreateStatic( uxLength, sizeof( T ), ucStorage, &xQueue );
+            }
+
+            ~Queue()
+            {
+                vQueueDelete( handle() );
+            }
+
+            Queue( const Queue & ) = delete;
+            Queue & operator=( const Queue & ) = delete;
+
+            QueueHandle_t handle()
+            {
+                return reinterpret_cast< QueueHandle_t >( &xQueue );
+            }
+
+            bool send( const T & xItem,
+                       TickType_t xTicksToWait = 0 )
+            {
+                return xQueueSendToBack( handle(), &xItem, xTicksToWait ) == pdPASS;
+            }
+
+            bool sendToFront( const T & xItem,
+                              TickType_t xTicksToWait = 0 )
+            {
+                return xQueueSendToFront( handle(), &xItem, xTicksToWait ) == pdPASS;
+            }
+
+            bool sendFromISR( const T & xItem,
+                              BaseType_t * pxHigherPriorityTaskWoken )
+            {
+                return xQueueSendToBackFromISR( handle(), &xItem, pxHigherPriorityTaskWoken ) == pdPASS;
+            }
+
+            /* Only available for queues of one item, like xQueueOverwrite(). */
+            void overwrite( const T & xItem )
+            {
+                static_assert( uxLength == 1, "overwrite() needs a queue of one item" );
+                ( void ) xQueueOverwrite( handle(), &xItem );
+            }
+
+            void overwriteFromISR( const T & xItem,
+                                   BaseType_t * pxHigherPriorityTaskWoken )
+            {
+                static_assert( uxLength == 1, "overwriteFromISR() needs a queue of one item" );
+                ( void ) xQueueOverwriteFromISR( handle(), &xItem, pxHigherPriorityTaskWoken );
+            }
+
+            bool receive( T & xItem,
+                          TickType_t xTicksToWait = portMAX_DELAY )
+            {
+                return xQueueReceive( handle(), &xItem, xTicksToWait ) == pdPASS;
+            }
+
+            bool receiveFromISR( T & xItem,
+                                 BaseType_t * pxHigherPriorityTaskWoken )
+            {
+                return xQueueReceiveFromISR( handle(), &xItem, pxHigherPriorityTaskWoken ) == pdPASS;
+            }
+
+            bool peek( T & xItem,
+                       TickType_t xTicksToWait = 0 )
+            {
+                return xQueuePeek( handle(), &xItem, xTicksToWait ) == pdPASS;
+            }
+
+            UBaseType_t waiting()
+            {
+                return uxQueueMessagesWaiting( handle() );
+            }
+
+            UBaseType_t spaces()
+            {
+                return uxQueueSpacesAvailable( handle() );
+            }
+
+            void reset()
+            {
+                ( void ) xQueueReset( handle() );
+            }
+
+        private:
+            /* The handle is the address of the control block. */
+            StaticQueue_t xQueue;
+            uint8_t ucStorage[ uxLength * sizeof( T ) ];
+    };
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMERS == 1 )
+
+/**
+ * A software timer that calls pxCallback from the timer task every
+ * xPeriod ticks, or once after xPeriod ticks if xAutoReload is false.  The
+ * timer is created dormant, start() starts it.
+ */
+        template< TickType_t xPeriod, bool xAutoReload, TimerCallbackFunction_t pxCallback >
+        class Timer
+        {
+            static_assert( xPeriod > 0, "the period of a timer must be at least one tick" );
+            static_assert( pxCallback != nullptr, "a timer needs a callback" );
+
+            public:
+                explicit Timer( const char * pcName,
+                                void * pvTimerID = nullptr )
+                {
+                    ( void ) xTimerCreateStatic( pcName, xPeriod, xAutoReload ? pdTRUE : pdFALSE,
+                                                 pvTimerID, pxCallback, &xTimer );
+                }
+
+                ~Timer()
+                {
+                    /* Without these the destructor cannot wait for the timer
+                     * task, which would then use the storage after it has
+                     * gone.  The conditions depend on xPeriod so that only a
+                     * destroyed Timer needs them. */
+                    static_assert( ( xPeriod > 0 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) &&
+                                   ( INCLUDE_xTaskGetSchedulerState == 1 ) && ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ),
+                                   "~Timer() needs INCLUDE_xTimerPendFunctionCall, INCLUDE_xTaskGetSchedulerState and INCLUDE_xTaskGetCurrentTaskHandle set to 1" );
+                    static_assert( ( xPeriod > 0 ) && ( configUSE_TASK_NOTIFICATIONS == 1 ) &&
+                                   ( freertosTIMER_DELETE_NOTIFY_INDEX > 0 ) &&
+                                   ( freertosTIMER_DELETE_NOTIFY_INDEX < configTASK_NOTIFICATION_ARRAY_ENTRIES ),
+                                   "~Timer() needs task notifications and a notification index of its own, see freertosTIMER_DELETE_NOTIFY_INDEX" );
+
+                    ( void ) xTimerDelete( handle(), portMAX_DELAY );
+
+                    #if ( ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( INCLUDE_xTaskGetSchedulerState == 1 ) && ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) && ( configUSE_TASK_NOTIFICATIONS == 1 ) )
+                        {
+                            /* The timer task removes the timer from its lists
+                             * when it processes the delete command, so the
+                             * timer must not go away before that.  Commands
+                             * are processed in order - block until a function
+                             * call pended after the delete command notifies
+                             * this task. */
+                            if( ( xTaskGetSchedulerState() == taskSCHEDULER_RUNNING ) &&
+                                ( xTaskGetCurrentTaskHandle() != xTimerGetTimerDaemonTaskHandle() ) &&
+                                ( xTimerPendFunctionCall( prvNotifyProcessed, xTaskGetCurrentTaskHandle(), 0, portMAX_DELAY ) == pdPASS ) )
+                            {
+                                ( void ) ulTaskNotifyTakeIndexed( freertosTIMER_DELETE_NOTIFY_INDEX, pdTRUE, portMAX_DELAY );
+                            }
+                        }
+                    #endif
+                }
+
+                Timer( const Timer & ) = delete;
+                Timer & operator=( const Timer & ) = delete;
+
+                TimerHandle_t handle()
+                {
+                    return reinterpret_cast< TimerHandle_t >( &xTimer );
+                }
+
+                bool start( TickType_t xTicksToWait = 0 )
+                {
+                    return xTimerStart( handle(), xTicksToWait ) == pdPASS;
+                }
+
+                bool stop( TickType_t xTicksToWait = 0 )
+                {
+                    return xTimerStop( handle(), xTicksToWait ) == pdPASS;
+                }
+
+                bool reset( TickType_t xTicksToWait = 0 )
+                {
+                    return xTimerReset( handle(), xTicksToWait ) == pdPASS;
+                }
+
+                bool startFromISR( BaseType_t * pxHigherPriorityTaskWoken )
+                {
+                    return xTimerStartFromISR( handle(), pxHigherPriorityTaskWoken ) == pdPASS;
+                }
+
+                bool stopFromISR( BaseType_t * pxHigherPriorityTaskWoken )
+                {
+                    return xTimerStopFromISR( handle(), pxHigherPriorityTaskWoken ) == pdPASS;
+                }
+
+                bool resetFromISR( BaseType_t * pxHigherPriorityTaskWoken )
+                {
+                    return xTimerResetFromISR( handle(), pxHigherPriorityTaskWoken ) == pdPASS;
+                }
+
+                bool isActive()
+                {
+                    return xTimerIsTimerActive( handle() ) != pdFALSE;
+                }
+
+            private:
+                #if ( configUSE_TASK_NOTIFICATIONS == 1 )
+                    static void prvNotifyProcessed( void * pvTask,
+                                                    uint32_t ulUnused )
+                    {
+                        ( void ) ulUnused;
+                        ( void ) xTaskNotifyGiveIndexed( static_cast< TaskHandle_t >( pvTask ), freertosTIMER_DELETE_NOTIFY_INDEX );
+                    }
+                #endif
+
+                /* The handle is the address of the control block. */
+                StaticTimer_t xTimer;
+        };
+
+    #endif /* configUSE_TIMERS */
+/*-----------------------------------------------------------*/
+
+/**
+ * A task running pxTaskCode at uxPriority with a stack of uxStackDepth
+ * words.  The task is created in the constructor and starts running when
+ * the scheduler is started, or at once if it is running already.  Like any
+ * task, pxTaskCode must never return.
+ */
+    template< configSTACK_DEPTH_TYPE uxStackDepth, UBaseType_t uxPriority, TaskFunction_t pxTaskCode >
+    class Task
+    {
+        static_assert( uxStackDepth >= configMINIMAL_STACK_SIZE, "the stack is smaller than configMINIMAL_STACK_SIZE" );
+        static_assert( uxPriority < configMAX_PRIORITIES, "the priority must be below configMAX_PRIORITIES" );
+        static_assert( pxTaskCode != nullptr, "a task needs a function to run" );
+
+        public:
+            explicit Task( const char * pcName,
+                           void * pvParameters = nullptr )
+            {
+                ( void ) xTaskCreateStatic( pxTaskCode, pcName, uxStackDepth, pvParameters,
+                                            uxPriority, xStack, &xTask );
+            }
+
+            #if ( INCLUDE_vTaskDelete == 1 )
+                ~Task()
+                {
+                    vTaskDelete( handle() );
+                }
+            #endif
+
+            Task( const Task & ) = delete;
+            Task & operator=( const Task & ) = delete;
+
+            TaskHandle_t handle()
+            {
+                return reinterpret_cast< TaskHandle_t >( &xTask );
+            }
+
+            #if ( configUSE_TASK_NOTIFICATIONS == 1 )
+                void notifyGive()
+                {
+                    ( void ) xTaskNotifyGive( handle() );
+                }
+
+                void notifyGiveFromISR( BaseType_t * pxHigherPriorityTaskWoken )
+                {
+                    vTaskNotifyGiveFromISR( handle(), pxHigherPriorityTaskWoken );
+                }
+
+                bool notify( uint32_t ulValue,
+                             eNotifyAction eAction )
+                {
+                    return xTaskNotify( handle(), ulValue, eAction ) == pdPASS;
+                }
+
+                bool notifyFromISR( uint32_t ulValue,
+                                    eNotifyAction eAction,
+                                    BaseType_t * pxHigherPriorityTaskWoken )
+                {
+                    return xTaskNotifyFromISR( handle(), ulValue, eAction, pxHigherPriorityTaskWoken ) == pdPASS;
+                }
+            #endif /* configUSE_TASK_NOTIFICATIONS */
+
+            #if ( INCLUDE_vTaskSuspend == 1 )
+                void suspend()
+                {
+                    vTaskSuspend( handle() );
+                }
+
+                void resume()
+                {
+                    vTaskResume( handle() );
+                }
+            #endif /* INCLUDE_vTaskSuspend */
+
+        private:
+            /* The handle is the address of the control block. */
+            StaticTask_t xTask;
+            StackType_t xStack[ uxStackDepth ];
+    };
+/*-----------------------------------------------------------*/
+} /* namespace freertos */
+
+#endif /* FREERTOS_HPP */
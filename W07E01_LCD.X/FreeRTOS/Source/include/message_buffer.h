@@ -417,6 +417,50 @@ typedef void * MessageBufferHandle_t;
 #define xMessageBufferSendFromISR( xMessageBuffer, pvTxData, xDataLengthBytes, pxHigherPriorityTaskWoken ) \
     xStreamBufferSendFromISR( ( StreamBufferHandle_t ) xMessageBuffer, pvTxData, xDataLengthBytes, pxHigherPriorityTaskWoken )
 
+/**
+ * message_buffer.h
+ *
+ * @code{c}
+ * size_t xMessageBufferSendFragments( MessageBufferHandle_t xMessageBuffer,
+ *                                  const StreamBufferFragment_t *pxFragments,
+ *                                  UBaseType_t uxFragmentCount,
+ *                                  TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Sends a discrete message built from several discontiguous fragments.  The
+ * fragments are copied, in order, into the message buffer behind a single
+ * length prefix, so the receiver reads them back as one message of the
+ * combined length.  Either the whole message is written or nothing is, and a
+ * task waiting to receive is unblocked at most once.  See
+ * xStreamBufferSendFragments().
+ *
+ * @return The total length of the fragments if the message was written,
+ * otherwise 0.
+ *
+ * \defgroup xMessageBufferSendFragments xMessageBufferSendFragments
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferSendFragments( xMessageBuffer, pxFragments, uxFragmentCount, xTicksToWait ) \
+    xStreamBufferSendFragments( ( StreamBufferHandle_t ) xMessageBuffer, pxFragments, uxFragmentCount, xTicksToWait )
+
+/**
+ * message_buffer.h
+ *
+ * @code{c}
+ * size_t xMessageBufferSendFragmentsFromISR( MessageBufferHandle_t xMessageBuffer,
+ *                                         const StreamBufferFragment_t *pxFragments,
+ *                                         UBaseType_t uxFragmentCount,
+ *                                         BaseType_t *pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * Interrupt safe version of xMessageBufferSendFragments().
+ *
+ * \defgroup xMessageBufferSendFragmentsFromISR xMessageBufferSendFragmentsFromISR
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferSendFragmentsFromISR( xMessageBuffer, pxFragments, uxFragmentCount, pxHigherPriorityTaskWoken ) \
+    xStreamBufferSendFragmentsFromISR( ( StreamBufferHandle_t ) xMessageBuffer, pxFragments, uxFragmentCount, pxHigherPriorityTaskWoken )
+
 /**
  * message_buffer.h
  *
@@ -71,6 +71,18 @@
 struct StreamBufferDef_t;
 typedef struct StreamBufferDef_t * StreamBufferHandle_t;
 
+/**
+ * Describes one contiguous fragment of the data passed to
+ * xStreamBufferSendFragments() and xStreamBufferSendFragmentsFromISR().  A
+ * message built from a header, a payload and a CRC can be described as three
+ * fragments rather than being assembled in a temporary buffer first.
+ */
+typedef struct xSTREAM_BUFFER_FRAGMENT
+{
+    const void * pvData; /* The start of the fragment. */
+    size_t xLength;      /* The number of bytes in the fragment. */
+} StreamBufferFragment_t;
+
 
 /**
  * stream_buffer.h
@@ -419,6 +431,98 @@ size_t xStreamBufferSendFromISR( StreamBufferHandle_t xStreamBuffer,
                                  size_t xDataLengthBytes,
                                  BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferSendFragments( StreamBufferHandle_t xStreamBuffer,
+ *                                 const StreamBufferFragment_t *pxFragments,
+ *                                 UBaseType_t uxFragmentCount,
+ *                                 TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Scatter-gather version of xStreamBufferSend().  The uxFragmentCount
+ * fragments described by the pxFragments array are copied, in order, into the
+ * stream buffer as if they had been concatenated into a single buffer and
+ * passed to xStreamBufferSend().  No temporary copy of the concatenated data is
+ * made, so the calling task does not need the stack space to assemble it.
+ *
+ * The head of the buffer is only updated once all the fragments have been
+ * copied, so the reader never observes a partially written set of fragments,
+ * and a task waiting to receive is notified at most once.  If the stream
+ * buffer is being used as a message buffer then all the fragments are written
+ * as one message with a single length prefix - either the whole message is
+ * written or nothing is.
+ *
+ * The same single writer restriction documented for xStreamBufferSend()
+ * applies.
+ *
+ * @param xStreamBuffer The handle of the stream buffer to which the fragments
+ * are being sent.
+ *
+ * @param pxFragments An array of fragment descriptors.  Fragments with a zero
+ * xLength are skipped.
+ *
+ * @param uxFragmentCount The number of entries in the pxFragments array.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in the
+ * Blocked state to wait for enough space to hold the sum of the fragment
+ * lengths.  See xStreamBufferSend().
+ *
+ * @return The number of bytes written to the stream buffer.  Message buffer
+ * writes return either the total length of the fragments or 0.  Stream buffer
+ * writes that time out still write as many bytes as possible, taken from the
+ * start of the first fragment onwards.
+ *
+ * Example use:
+ * @code{c}
+ * void vSendFrame( StreamBufferHandle_t xStreamBuffer, const uint8_t *pucPayload, size_t xPayloadLength )
+ * {
+ * uint8_t ucHeader[ 2 ] = { 0xA5, ( uint8_t ) xPayloadLength };
+ * uint16_t usCRC = usCalculateCRC( pucPayload, xPayloadLength );
+ * StreamBufferFragment_t xFragments[ 3 ];
+ *
+ *  xFragments[ 0 ].pvData = ucHeader;
+ *  xFragments[ 0 ].xLength = sizeof( ucHeader );
+ *  xFragments[ 1 ].pvData = pucPayload;
+ *  xFragments[ 1 ].xLength = xPayloadLength;
+ *  xFragments[ 2 ].pvData = &usCRC;
+ *  xFragments[ 2 ].xLength = sizeof( usCRC );
+ *
+ *  xStreamBufferSendFragments( xStreamBuffer, xFragments, 3, pdMS_TO_TICKS( 100 ) );
+ * }
+ * @endcode
+ * \defgroup xStreamBufferSendFragments xStreamBufferSendFragments
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferSendFragments( StreamBufferHandle_t xStreamBuffer,
+                                   const StreamBufferFragment_t * pxFragments,
+                                   UBaseType_t uxFragmentCount,
+                                   TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferSendFragmentsFromISR( StreamBufferHandle_t xStreamBuffer,
+ *                                        const StreamBufferFragment_t *pxFragments,
+ *                                        UBaseType_t uxFragmentCount,
+ *                                        BaseType_t *pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * Interrupt safe version of xStreamBufferSendFragments().  See
+ * xStreamBufferSendFromISR() for a description of pxHigherPriorityTaskWoken.
+ *
+ * @return The number of bytes actually written to the stream buffer.
+ *
+ * \defgroup xStreamBufferSendFragmentsFromISR xStreamBufferSendFragmentsFromISR
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferSendFragmentsFromISR( StreamBufferHandle_t xStreamBuffer,
+                                          const StreamBufferFragment_t * pxFragments,
+                                          UBaseType_t uxFragmentCount,
+                                          BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
 /**
  * stream_buffer.h
  *
@@ -759,6 +863,43 @@ size_t xStreamBufferBytesAvailable( StreamBufferHandle_t xStreamBuffer ) PRIVILE
 BaseType_t xStreamBufferSetTriggerLevel( StreamBufferHandle_t xStreamBuffer,
                                          size_t xTriggerLevel ) PRIVILEGED_FUNCTION;
 
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * BaseType_t xStreamBufferSetIdleTimeout( StreamBufferHandle_t xStreamBuffer, TickType_t xIdleTicks );
+ * @endcode
+ *
+ * By default a task blocked on an empty stream buffer is unblocked when the
+ * trigger level is reached or its block time expires.  Setting a non-zero idle
+ * timeout adds a third condition: once data has arrived, the task is also
+ * unblocked if no further data is written for xIdleTicks ticks.  This lets a
+ * serial receiver use a trigger level of one frame and still collect a short
+ * or partial frame promptly, without waking for every received byte.
+ *
+ * While an idle timeout is set, a blocking xStreamBufferReceive() does not
+ * return as soon as any data is present - it waits for the trigger level, the
+ * idle gap, or the end of its block time.  The writer notifies the reader at
+ * most once for the first bytes of a burst, and then again when the trigger
+ * level is reached.
+ *
+ * configUSE_STREAM_BUFFER_IDLE_TIMEOUT must be set to 1 in FreeRTOSConfig.h for
+ * xStreamBufferSetIdleTimeout() to be available.
+ *
+ * @param xStreamBuffer The handle of the stream buffer being updated.
+ *
+ * @param xIdleTicks The gap, in ticks, after the most recent write that ends a
+ * burst.  0 disables the idle timeout.
+ *
+ * @return pdPASS if the idle timeout was set.  pdFAIL if xStreamBuffer is a
+ * message buffer, which has no use for an idle timeout.
+ *
+ * \defgroup xStreamBufferSetIdleTimeout xStreamBufferSetIdleTimeout
+ * \ingroup StreamBufferManagement
+ */
+BaseType_t xStreamBufferSetIdleTimeout( StreamBufferHandle_t xStreamBuffer,
+                                        TickType_t xIdleTicks ) PRIVILEGED_FUNCTION;
+
 /**
  * stream_buffer.h
  *
@@ -2997,6 +2997,20 @@ BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList ) PRIVILEG
 void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem,
                                         const TickType_t xItemValue ) PRIVILEGED_FUNCTION;
 
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
+ * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE EVENT BITS MODULE.
+ *
+ * A version of vTaskRemoveFromUnorderedEventList() that is called from an
+ * interrupt, or a critical section, rather than with the scheduler suspended.
+ * Used when configUSE_EVENT_GROUP_DIRECT_FROM_ISR is set to 1.
+ *
+ * @return pdTRUE if the task being removed has a higher priority than the task
+ * that was interrupted, otherwise pdFALSE.
+ */
+BaseType_t xTaskRemoveFromUnorderedEventListFromISR( ListItem_t * pxEventListItem,
+                                                     const TickType_t xItemValue ) PRIVILEGED_FUNCTION;
+
 /*
  * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS ONLY
  * INTENDED FOR USE WHEN IMPLEMENTING A PORT OF THE SCHEDULER AND IS
@@ -0,0 +1,616 @@
+/*
+ * FreeRTOS Kernel V10.4.6
+ * Copyright (C) 2020 Cambridge Consultants Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*-----------------------------------------------------------
+ * Implementation of functions defined in portable.h for the Posix port,
+ * fiber variant.
+ *
+ * All tasks run on the thread that starts the scheduler.  Each task is a
+ * fiber that executes on its FreeRTOS stack, so a task needs no more stack
+ * than it uses and the number of tasks is only limited by the heap.  The
+ * fiber is set up once with makecontext() and tasks are then switched with
+ * _setjmp()/_longjmp(), which save and restore a handful of registers
+ * without any system call.
+ *
+ * Interrupts are emulated with a flag instead of the signal mask, so
+ * critical sections do not enter the kernel either.  The timer interrupt
+ * uses SIGALRM.  If it arrives while interrupts are disabled it is marked
+ * pending and handled when they are enabled again.  Ticks that are pending
+ * at the same time are handled as one, like SIGALRM signals that are not
+ * queued in the pthread variant.  The handler switches tasks directly, so a
+ * task that never calls the kernel is still preempted.
+ *
+ * With configUSE_VIRTUAL_TIME set to 1 there is no SIGALRM.  The tick is
+ * raised by vPortConsumeVirtualTime() when the time a task lets pass
+ * reaches it, and an idle task that finds all other tasks blocked skips
+ * ahead to the next wake-up with the tickless idle hooks.  A context
+ * switch, a critical section (so most kernel calls) and an iteration of the
+ * idle task loop take configVIRTUAL_TIME_KERNEL_NS.  Tasks that only call
+ * the kernel do not stop the time, and the tick can preempt a task when it
+ * leaves the kernel, like a pending interrupt on the hardware.
+ *
+ * The signal handler runs on the stack of the interrupted task, so every
+ * stack needs room for a signal frame (a few kilobytes, depending on the
+ * CPU) on top of what the task itself uses.
+ *
+ * LIMITATION - the C library.  Without virtual time the SIGALRM handler
+ * can switch tasks while a task is inside any C library function.  All tasks
+ * run on the same thread, and the C library locks belong to the thread, not
+ * to the task:
+ *
+ * - the stdio locks are recursive, so a second task that enters printf()
+ *   and friends on the same FILE gets the lock that the first task still
+ *   holds, and both work on the buffer at the same time;
+ * - malloc(), free() and other functions with non-recursive locks deadlock
+ *   the whole process when a second task calls them while the first holds
+ *   the lock.
+ *
+ * Call such functions from a single task only, or serialize them with a
+ * FreeRTOS mutex, or call them with the scheduler suspended.  A critical
+ * section defers the tick too, but should not be held for a C library call.
+ * pvPortMalloc() does not use malloc().  With configUSE_VIRTUAL_TIME set to 1
+ * the tick only interrupts a task in vPortConsumeVirtualTime() and when it
+ * leaves a critical section, never inside the C library, so the limitation
+ * does not apply.
+ *
+ * A debugger sees only one thread, the task that is running.
+ *----------------------------------------------------------*/
+
+/* _longjmp() to another stack fails the checks of the fortified version. */
+#undef _FORTIFY_SOURCE
+
+#include <errno.h>
+#include <pthread.h>
+#include <setjmp.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <sys/times.h>
+#include <ucontext.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+/*-----------------------------------------------------------*/
+
+typedef struct FIBER
+{
+    jmp_buf xContext;
+    pdTASK_CODE pxCode;
+    void *pvParams;
+} Fiber_t;
+
+/*
+ * The additional per-fiber data is stored at the beginning of the
+ * task's stack.
+ */
+static inline Fiber_t *prvGetFiberFromTask(TaskHandle_t xTask)
+{
+StackType_t *pxTopOfStack = *(StackType_t **)xTask;
+
+    return (Fiber_t *)(pxTopOfStack + 1);
+}
+
+/*-----------------------------------------------------------*/
+
+static volatile sig_atomic_t xInterruptsEnabled = pdFALSE;
+static volatile sig_atomic_t xTickPending = pdFALSE;
+/* Interrupts stay disabled until the first task runs, whatever critical
+   sections the kernel leaves before. */
+static volatile portBASE_TYPE uxCriticalNesting = 0xaaaaaaaa;
+static jmp_buf xSchedulerContext;
+/* The fiber being set up by pxPortInitialiseStack(). */
+static Fiber_t *pxNewFiber;
+static ucontext_t *pxNewFiberCreator;
+
+#if ( configUSE_VIRTUAL_TIME == 1 )
+#define portTICK_NANOSECONDS ( ( uint64_t ) portTICK_RATE_MICROSECONDS * 1000 )
+
+static uint64_t ullVirtualTime;
+static uint64_t ullNextTickTime = portTICK_NANOSECONDS;
+#endif
+/*-----------------------------------------------------------*/
+
+static void prvSetupTimerInterrupt( void );
+static void prvFiberEntry( void );
+static void prvSwitchFiber( Fiber_t *pxFiberToResume,
+                            Fiber_t *pxFiberToSuspend );
+static void prvServiceTick( void );
+#if ( configUSE_VIRTUAL_TIME == 1 )
+static void prvSetVirtualTime( uint64_t ullNow );
+#else
+static void vPortSystemTickHandler( int sig );
+#endif
+/*-----------------------------------------------------------*/
+
+static void prvFatalError( const char *pcCall, int iErrno )
+{
+    fprintf( stderr, "%s: %s\n", pcCall, strerror( iErrno ) );
+    abort();
+}
+
+/*
+ * See header file for description.
+ */
+portSTACK_TYPE *pxPortInitialiseStack( portSTACK_TYPE *pxTopOfStack,
+                                       portSTACK_TYPE *pxEndOfStack,
+                                       pdTASK_CODE pxCode, void *pvParameters )
+{
+Fiber_t *fiber;
+ucontext_t xCreator;
+ucontext_t xStart;
+
+    /*
+     * Store the additional fiber data at the start of the stack.
+     */
+    fiber = (Fiber_t *)(pxTopOfStack + 1) - 1;
+    pxTopOfStack = (portSTACK_TYPE *)fiber - 1;
+
+    fiber->pxCode = pxCode;
+    fiber->pvParams = pvParameters;
+
+    if ( getcontext( &xStart ) )
+    {
+        prvFatalError( "getcontext", errno );
+    }
+    xStart.uc_stack.ss_sp = pxEndOfStack;
+    xStart.uc_stack.ss_size = (pxTopOfStack + 1 - pxEndOfStack) * sizeof(*pxTopOfStack);
+    xStart.uc_link = NULL;
+    makecontext( &xStart, prvFiberEntry, 0 );
+
+    /* Run the fiber up to the point where it waits to be switched to. */
+    vPortEnterCritical();
+
+    pxNewFiber = fiber;
+    pxNewFiberCreator = &xCreator;
+    if ( swapcontext( &xCreator, &xStart ) )
+    {
+        prvFatalError( "swapcontext", errno );
+    }
+
+    vPortExitCritical();
+
+    return pxTopOfStack;
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * See header file for description.
+ */
+portBASE_TYPE xPortStartScheduler( void )
+{
+Fiber_t *pxFirstFiber = prvGetFiberFromTask( xTaskGetCurrentTaskHandle() );
+
+    /* Start the timer that generates the tick ISR(SIGALRM).
+       Interrupts are disabled here already. */
+    prvSetupTimerInterrupt();
+
+    /* Start the first task, vPortEndScheduler() returns here. */
+    if ( _setjmp( xSchedulerContext ) == 0 )
+    {
+        _longjmp( pxFirstFiber->xContext, 1 );
+    }
+
+    return 0;
+}
+/*-----------------------------------------------------------*/
+
+void vPortEndScheduler( void )
+{
+#if ( configUSE_VIRTUAL_TIME == 0 )
+struct itimerval itimer;
+struct sigaction sigtick;
+
+    /* Stop the timer and ignore any pending SIGALRMs. */
+    itimer.it_value.tv_sec = 0;
+    itimer.it_value.tv_usec = 0;
+
+    itimer.it_interval.tv_sec = 0;
+    itimer.it_interval.tv_usec = 0;
+    (void)setitimer( ITIMER_REAL, &itimer, NULL );
+
+    sigtick.sa_flags = 0;
+    sigtick.sa_handler = SIG_IGN;
+    sigemptyset( &sigtick.sa_mask );
+    sigaction( SIGALRM, &sigtick, NULL );
+#endif
+
+    xInterruptsEnabled = pdFALSE;
+    xTickPending = pdFALSE;
+
+    /* The stacks of the tasks are freed with the tasks. */
+    _longjmp( xSchedulerContext, 1 );
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnterCritical( void )
+{
+    if ( uxCriticalNesting == 0 )
+    {
+        vPortDisableInterrupts();
+    }
+    uxCriticalNesting++;
+}
+/*-----------------------------------------------------------*/
+
+void vPortExitCritical( void )
+{
+    uxCriticalNesting--;
+
+    /* If we have reached 0 then re-enable the interrupts. */
+    if( uxCriticalNesting == 0 )
+    {
+#if ( configUSE_VIRTUAL_TIME == 1 )
+        /* Stands for the time of the kernel call, a tick falling into it
+           interrupts the task when it leaves the kernel. */
+        vPortConsumeVirtualTime( configVIRTUAL_TIME_KERNEL_NS );
+#endif
+        vPortEnableInterrupts();
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vPortYieldFromISR( void )
+{
+Fiber_t *xFiberToSuspend;
+Fiber_t *xFiberToResume;
+
+    xFiberToSuspend = prvGetFiberFromTask( xTaskGetCurrentTaskHandle() );
+
+    vTaskSwitchContext();
+
+    xFiberToResume = prvGetFiberFromTask( xTaskGetCurrentTaskHandle() );
+
+    prvSwitchFiber( xFiberToResume, xFiberToSuspend );
+}
+/*-----------------------------------------------------------*/
+
+void vPortYield( void )
+{
+    vPortEnterCritical();
+
+    vPortYieldFromISR();
+
+    vPortExitCritical();
+}
+/*-----------------------------------------------------------*/
+
+void vPortDisableInterrupts( void )
+{
+    xInterruptsEnabled = pdFALSE;
+
+    /* The kernel data must not be accessed before this point. */
+    __atomic_signal_fence( __ATOMIC_SEQ_CST );
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnableInterrupts( void )
+{
+    /* ...or after this point. */
+    __atomic_signal_fence( __ATOMIC_SEQ_CST );
+
+    xInterruptsEnabled = pdTRUE;
+
+    /* Handle a tick that arrived while interrupts were disabled.  A tick
+       arriving from here on is handled by the signal handler. */
+    if ( xTickPending != pdFALSE )
+    {
+        prvServiceTick();
+    }
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xPortSetInterruptMask( void )
+{
+portBASE_TYPE xWasEnabled = xInterruptsEnabled;
+
+    /* Also called from tasks, interrupts are disabled in ISRs already. */
+    vPortDisableInterrupts();
+
+    return xWasEnabled;
+}
+/*-----------------------------------------------------------*/
+
+void vPortClearInterruptMask( portBASE_TYPE xMask )
+{
+    if ( xMask != pdFALSE )
+    {
+        vPortEnableInterrupts();
+    }
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Setup the systick timer to generate the tick interrupts at the required
+ * frequency.
+ */
+void prvSetupTimerInterrupt( void )
+{
+#if ( configUSE_VIRTUAL_TIME == 1 )
+    /* Ticks that passed before the scheduler started are not counted. */
+    xTickPending = pdFALSE;
+    ullNextTickTime = ullVirtualTime + portTICK_NANOSECONDS;
+#else
+struct sigaction sigtick;
+struct itimerval itimer;
+sigset_t xSignals;
+int iRet;
+
+    /*
+     * The handler can switch to another task before it returns, and that
+     * task must still get the next tick.  So SIGALRM is not blocked while
+     * the handler runs, nested ticks are deferred by xInterruptsEnabled.
+     */
+    sigtick.sa_flags = SA_NODEFER | SA_RESTART;
+    sigtick.sa_handler = vPortSystemTickHandler;
+    sigemptyset( &sigtick.sa_mask );
+
+    iRet = sigaction( SIGALRM, &sigtick, NULL );
+    if ( iRet )
+    {
+        prvFatalError( "sigaction", errno );
+    }
+
+    sigemptyset( &xSignals );
+    sigaddset( &xSignals, SIGALRM );
+    iRet = pthread_sigmask( SIG_UNBLOCK, &xSignals, NULL );
+    if ( iRet )
+    {
+        prvFatalError( "pthread_sigmask", iRet );
+    }
+
+    /* Initialise the structure with the current timer information. */
+    iRet = getitimer( ITIMER_REAL, &itimer );
+    if ( iRet )
+    {
+        prvFatalError( "getitimer", errno );
+    }
+
+    /* Set the interval between timer events. */
+    itimer.it_interval.tv_sec = 0;
+    itimer.it_interval.tv_usec = portTICK_RATE_MICROSECONDS;
+
+    /* Set the current count-down. */
+    itimer.it_value.tv_sec = 0;
+    itimer.it_value.tv_usec = portTICK_RATE_MICROSECONDS;
+
+    /* Set-up the timer interrupt. */
+    iRet = setitimer( ITIMER_REAL, &itimer, NULL );
+    if ( iRet )
+    {
+        prvFatalError( "setitimer", errno );
+    }
+#endif
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_VIRTUAL_TIME == 1 )
+
+static void prvSetVirtualTime( uint64_t ullNow )
+{
+    ullVirtualTime = ullNow;
+
+    #if ( configUSE_VIRTUAL_TIME_HOOK == 1 )
+    {
+        extern void vApplicationVirtualTimeHook( uint64_t ullNow );
+
+        vApplicationVirtualTimeHook( ullNow );
+    }
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+uint64_t ullPortGetVirtualTime( void )
+{
+    return ullVirtualTime;
+}
+/*-----------------------------------------------------------*/
+
+void vPortConsumeVirtualTime( uint64_t ullNanoseconds )
+{
+    while ( ullVirtualTime + ullNanoseconds >= ullNextTickTime )
+    {
+        /* The tick interrupts the task here.  Other tasks may run and let
+           time pass before the rest of the time passes in this one. */
+        ullNanoseconds -= ullNextTickTime - ullVirtualTime;
+        prvSetVirtualTime( ullNextTickTime );
+        ullNextTickTime += portTICK_NANOSECONDS;
+
+        xTickPending = pdTRUE;
+        if ( xInterruptsEnabled != pdFALSE )
+        {
+            prvServiceTick();
+        }
+    }
+
+    if ( ullNanoseconds > 0 )
+    {
+        prvSetVirtualTime( ullVirtualTime + ullNanoseconds );
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime )
+{
+    /* Called by the idle task with the scheduler suspended. */
+    vPortDisableInterrupts();
+
+    /* Nothing can unblock a task while the time stands still, but the
+       kernel may have readied one since the idle task looked. */
+    if ( eTaskConfirmSleepModeStatus() != eAbortSleep )
+    {
+        /* Skip to the tick that unblocks the first task, which is handled
+           when interrupts are enabled again. */
+        vTaskStepTick( xExpectedIdleTime - 1 );
+        ullNextTickTime += ( uint64_t ) ( xExpectedIdleTime - 1 ) * portTICK_NANOSECONDS;
+        prvSetVirtualTime( ullNextTickTime );
+        ullNextTickTime += portTICK_NANOSECONDS;
+        xTickPending = pdTRUE;
+    }
+
+    vPortEnableInterrupts();
+}
+/*-----------------------------------------------------------*/
+
+#else /* configUSE_VIRTUAL_TIME */
+
+static void vPortSystemTickHandler( int sig )
+{
+int iSavedErrno = errno;
+
+    xTickPending = pdTRUE;
+
+    if ( xInterruptsEnabled != pdFALSE )
+    {
+        prvServiceTick();
+    }
+
+    errno = iSavedErrno;
+}
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_VIRTUAL_TIME */
+
+static void prvServiceTick( void )
+{
+#if ( configUSE_PREEMPTION == 1 )
+Fiber_t *pxFiberToSuspend;
+Fiber_t *pxFiberToResume;
+#endif
+
+    /* Called with interrupts enabled, from the signal handler or when
+       interrupts are enabled with a tick pending. */
+    do
+    {
+        vPortDisableInterrupts();
+        xTickPending = pdFALSE;
+        uxCriticalNesting++;
+
+#if ( configUSE_PREEMPTION == 1 )
+        pxFiberToSuspend = prvGetFiberFromTask( xTaskGetCurrentTaskHandle() );
+#endif
+
+        xTaskIncrementTick();
+
+#if ( configUSE_PREEMPTION == 1 )
+        /* Select Next Task. */
+        vTaskSwitchContext();
+
+        pxFiberToResume = prvGetFiberFromTask( xTaskGetCurrentTaskHandle() );
+
+        prvSwitchFiber( pxFiberToResume, pxFiberToSuspend );
+#endif
+
+        uxCriticalNesting--;
+        __atomic_signal_fence( __ATOMIC_SEQ_CST );
+        xInterruptsEnabled = pdTRUE;
+    } while ( xTickPending != pdFALSE );
+}
+/*-----------------------------------------------------------*/
+
+static void prvFiberEntry( void )
+{
+Fiber_t *pxFiber = pxNewFiber;
+
+    /* Return to pxPortInitialiseStack(), the first switch to the task
+       continues from here. */
+    if ( _setjmp( pxFiber->xContext ) == 0 )
+    {
+        setcontext( pxNewFiberCreator );
+        prvFatalError( "setcontext", errno );
+    }
+
+    /* Resumed for the first time, enables interrupts. */
+    uxCriticalNesting = 0;
+    vPortEnableInterrupts();
+
+    /* Call the task's entry point. */
+    pxFiber->pxCode( pxFiber->pvParams );
+
+    /* A function that implements a task must not exit or attempt to return to
+    * its caller as there is nothing to return to. If a task wants to exit it
+    * should instead call vTaskDelete( NULL ). Artificially force an assert()
+    * to be triggered if configASSERT() is defined, so application writers can
+        * catch the error. */
+    configASSERT( pdFALSE );
+
+    /* The fiber has no context to return to. */
+    fprintf( stderr, "task returned from its function\n" );
+    abort();
+}
+/*-----------------------------------------------------------*/
+
+static void prvSwitchFiber( Fiber_t *pxFiberToResume,
+                            Fiber_t *pxFiberToSuspend )
+{
+BaseType_t uxSavedCriticalNesting;
+
+    if ( pxFiberToSuspend != pxFiberToResume )
+    {
+        /*
+         * Switch tasks.
+         *
+         * The critical section nesting is per-task, so save it on the
+         * stack of the current (suspending fiber), restoring it when
+         * we switch back to this task.  A deleted task is never switched
+         * back to, its stack is freed by the idle task.
+         */
+        uxSavedCriticalNesting = uxCriticalNesting;
+
+#if ( configUSE_VIRTUAL_TIME == 1 )
+        /* Interrupts are disabled, a tick falling into the switch is
+           handled when the next task enables them. */
+        vPortConsumeVirtualTime( configVIRTUAL_TIME_KERNEL_NS );
+#endif
+
+        if ( _setjmp( pxFiberToSuspend->xContext ) == 0 )
+        {
+            _longjmp( pxFiberToResume->xContext, 1 );
+        }
+
+        uxCriticalNesting = uxSavedCriticalNesting;
+    }
+}
+/*-----------------------------------------------------------*/
+
+unsigned long ulPortGetRunTime( void )
+{
+#if ( configUSE_VIRTUAL_TIME == 1 )
+    /* In the 10 ms units of times(). */
+    return ( unsigned long ) ( ullVirtualTime / 10000000 );
+#else
+struct tms xTimes;
+
+    times( &xTimes );
+
+    return ( unsigned long ) xTimes.tms_utime;
+#endif
+}
+/*-----------------------------------------------------------*/
@@ -40,6 +40,9 @@
 /* Start tasks with interrupts enables. */
 #define portFLAGS_INT_ENABLED    ( ( StackType_t ) 0x80 )
 
+/* Marker of a full frame, see portSAVE_CONTEXT() in portmacro.h. */
+#define portFRAME_FULL           ( ( StackType_t ) 0x01 )
+
 /*-----------------------------------------------------------*/
 
 /* We require the address of the pxCurrentTCB variable, but don't want to know
@@ -115,6 +118,10 @@ StackType_t * pxPortInitialiseStack( StackType_t * pxTopOfStack,
     /* Leave register R26 - R31 untouched */
     pxTopOfStack -= 7;
 
+    /* The parameter is in r24/r25, which only a full frame restores. */
+    *pxTopOfStack = portFRAME_FULL;
+    pxTopOfStack--;
+
     /*lint +e950 +e611 +e923 */
 
     return pxTopOfStack;
@@ -146,12 +153,13 @@ void vPortEndScheduler( void )
 
 /*
  * Manual context switch.  The first thing we do is save the registers so we
- * can use a naked attribute.
+ * can use a naked attribute.  Called from C, so only the registers a call
+ * must preserve are saved.
  */
 void vPortYield( void ) __attribute__( ( naked ) );
 void vPortYield( void )
 {
-    portSAVE_CONTEXT();
+    portSAVE_CALL_CONTEXT();
     vTaskSwitchContext();
     portRESTORE_CONTEXT();
     asm volatile ( "ret" );
@@ -165,35 +173,13 @@ void vPortYield( void )
 void vPortYieldFromISR( void ) __attribute__( ( naked ) );
 void vPortYieldFromISR( void )
 {
-    portSAVE_CONTEXT();
+    portSAVE_CALL_CONTEXT();
     vTaskSwitchContext();
     portRESTORE_CONTEXT();
     asm volatile ( "reti" );
 }
 /*-----------------------------------------------------------*/
 
-/*
- * Context switch function used by the tick.  This must be identical to
- * vPortYield() from the call to vTaskSwitchContext() onwards.  The only
- * difference from vPortYield() is the tick count is incremented as the
- * call comes from the tick ISR.
- */
-void vPortYieldFromTick( void ) __attribute__( ( naked ) );
-void vPortYieldFromTick( void )
-{
-    portSAVE_CONTEXT();
-
-    if( xTaskIncrementTick() != pdFALSE )
-    {
-        vTaskSwitchContext();
-    }
-
-    portRESTORE_CONTEXT();
-
-    asm volatile ( "reti" );
-}
-/*-----------------------------------------------------------*/
-
 /*
  * Setup timer to generate a tick interrupt.
  */
@@ -211,15 +197,24 @@ static void prvSetupTimerInterrupt( void )
 
 /*
  * Tick ISR for preemptive scheduler.  We can use a naked attribute as
- * the context is saved at the start of vPortYieldFromTick().  The tick
- * count is incremented after the context is saved.
+ * the context is saved first, in place rather than in a called function
+ * so the frame holds no extra return address.  The tick count is
+ * incremented after the context is saved.
  */
     ISR( TICK_INT_vect, ISR_NAKED )
     {
-        /* Clear tick interrupt flag. */
-        CLR_INT( INT_FLAGS, INT_MASK );
+        portSAVE_CONTEXT();
+
+        /* Clear tick interrupt flag.  The tick cannot interrupt itself
+         * before reti, so the flag can wait until the registers are free. */
+        INT_FLAGS = INT_MASK;
+
+        if( xTaskIncrementTick() != pdFALSE )
+        {
+            vTaskSwitchContext();
+        }
 
-        vPortYieldFromTick();
+        portRESTORE_CONTEXT();
 
         asm volatile ( "reti" );
     }
@@ -237,6 +232,54 @@ static void prvSetupTimerInterrupt( void )
         xTaskIncrementTick();
     }
 #endif /* if configUSE_PREEMPTION == 1 */
+/*-----------------------------------------------------------*/
+
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+
+/* The upper 16 bits of the run time stats clock. */
+    static volatile uint16_t usRunTimeCounterHigh = 0;
+
+    void vPortConfigureTimerForRunTimeStats( void )
+    {
+        usRunTimeCounterHigh = 0;
+        STATS_init();
+    }
+/*-----------------------------------------------------------*/
+
+    uint32_t ulPortGetRunTimeCounterValue( void )
+    {
+        uint16_t usHigh, usLow;
+
+        /* Called by the kernel on every context switch, usually with
+         * interrupts already disabled, so the overflow interrupt cannot run
+         * between reading the two halves.  An overflow that has happened but
+         * not yet been counted is detected from the interrupt flag, in which
+         * case the count is read again as it may have been read before it
+         * wrapped. */
+        portENTER_CRITICAL();
+        {
+            usHigh = usRunTimeCounterHigh;
+            usLow = STATS_TMR_READ();
+
+            if( STATS_OVF_PENDING() )
+            {
+                usLow = STATS_TMR_READ();
+                usHigh++;
+            }
+        }
+        portEXIT_CRITICAL();
+
+        return ( ( uint32_t ) usHigh << 16 ) | usLow;
+    }
+/*-----------------------------------------------------------*/
+
+    ISR( STATS_INT_vect )
+    {
+        STATS_TMR.INTFLAGS = TCB_CAPT_bm;
+        usRunTimeCounterHigh++;
+    }
+
+#endif /* if ( configGENERATE_RUN_TIME_STATS == 1 ) */
 
 #if (configUSE_TICKLESS_IDLE == 1)
 
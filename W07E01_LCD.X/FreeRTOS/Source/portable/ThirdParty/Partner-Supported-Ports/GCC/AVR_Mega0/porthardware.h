@@ -155,6 +155,52 @@
     #error Invalid timer setting.
 #endif /* if ( configUSE_TIMER_INSTANCE == 0 ) */
 
+/*-----------------------------------------------------------*/
+
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+
+/* The run time stats clock is a second TCB free running from CLK_PER / 2.  Its
+ * 16-bit count is extended to 32 bits in software by counting overflows, which
+ * happen every 65536 counts. */
+    #ifndef configRUN_TIME_STATS_TIMER_INSTANCE
+        #define configRUN_TIME_STATS_TIMER_INSTANCE    1
+    #endif
+
+    #if ( configRUN_TIME_STATS_TIMER_INSTANCE == configUSE_TIMER_INSTANCE )
+        #error The run time stats timer must not be the tick timer.
+    #endif
+
+    #if ( configRUN_TIME_STATS_TIMER_INSTANCE == 0 )
+        #define STATS_TMR         TCB0
+        #define STATS_INT_vect    TCB0_INT_vect
+    #elif ( configRUN_TIME_STATS_TIMER_INSTANCE == 1 )
+        #define STATS_TMR         TCB1
+        #define STATS_INT_vect    TCB1_INT_vect
+    #elif ( configRUN_TIME_STATS_TIMER_INSTANCE == 2 )
+        #define STATS_TMR         TCB2
+        #define STATS_INT_vect    TCB2_INT_vect
+    #elif ( configRUN_TIME_STATS_TIMER_INSTANCE == 3 )
+        #define STATS_TMR         TCB3
+        #define STATS_INT_vect    TCB3_INT_vect
+    #else
+        #error Invalid run time stats timer setting.
+    #endif
+
+    #define STATS_init()                                          \
+    {                                                             \
+        STATS_TMR.CTRLA = 0x00;                                   \
+        STATS_TMR.CTRLB = TCB_CNTMODE_INT_gc;                     \
+        STATS_TMR.CCMP = 0xFFFF;                                  \
+        STATS_TMR.CNT = 0;                                        \
+        STATS_TMR.INTFLAGS = TCB_CAPT_bm;                         \
+        STATS_TMR.INTCTRL = TCB_CAPT_bm;                          \
+        STATS_TMR.CTRLA = TCB_CLKSEL_CLKDIV2_gc | TCB_ENABLE_bm;  \
+    }
+    #define STATS_TMR_READ()        STATS_TMR.CNT
+    #define STATS_OVF_PENDING()     ( STATS_TMR.INTFLAGS & TCB_CAPT_bm )
+
+#endif /* if ( configGENERATE_RUN_TIME_STATS == 1 ) */
+
 
 #if ( configUSE_TICKLESS_IDLE == 1 )
 
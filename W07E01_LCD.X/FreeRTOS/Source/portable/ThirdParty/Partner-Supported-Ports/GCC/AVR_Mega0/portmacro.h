@@ -118,6 +118,20 @@ extern void vPortSuppressTicksAndSleep(TickType_t xExpectedIdleTime);
 #define configPOST_PWR_DOWN_PROCESSING()
 #endif
 
+/* Run time stats clock, see configRUN_TIME_STATS_TIMER_INSTANCE in
+ * porthardware.h. */
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+    #ifndef portCONFIGURE_TIMER_FOR_RUN_TIME_STATS
+        extern void vPortConfigureTimerForRunTimeStats( void );
+        #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()    vPortConfigureTimerForRunTimeStats()
+    #endif
+
+    #if !defined( portGET_RUN_TIME_COUNTER_VALUE ) && !defined( portALT_GET_RUN_TIME_COUNTER_VALUE )
+        extern uint32_t ulPortGetRunTimeCounterValue( void );
+        #define portGET_RUN_TIME_COUNTER_VALUE()    ulPortGetRunTimeCounterValue()
+    #endif
+#endif
+
 /*-----------------------------------------------------------*/
 
 /* Helper macros for portSAVE_CONTEXT/ portRESTORE_CONTEXT - common support for Mega-0 and AVR-Dx families */
@@ -128,17 +142,52 @@ extern void vPortSuppressTicksAndSleep(TickType_t xExpectedIdleTime);
     asm volatile("in    r0, __RAMPZ__           \n\t" \
                  "push  r0                      \n\t");
 
-#define portRESTORE_RAMPZ()                           \
-    asm volatile("pop   r0                      \n\t" \
-                 "out   __RAMPZ__, r0           \n\t");
+/* A string, spliced into the single asm statement of portRESTORE_CONTEXT() */
+#define portRESTORE_RAMPZ_ASM                         \
+                 "pop   r0                      \n\t" \
+                 "out   __RAMPZ__, r0           \n\t"
 
 #else
 
 #define portSAVE_RAMPZ()
-#define portRESTORE_RAMPZ()
+#define portRESTORE_RAMPZ_ASM
 
 #endif
 
+/* A task's context is saved in one of two frames, told apart by a marker byte
+ * pushed last, just below the saved stack pointer:
+ *
+ * - The full frame is saved by an interrupt, which can preempt the task
+ *   anywhere, so it holds r0, SREG, [RAMPZ], r1 - r31 and the marker 1.
+ *
+ * - The call frame is saved by vPortYield() and vPortYieldFromISR().  They
+ *   are called from C, so by the avr-gcc ABI r0, r18 - r27, r30 and r31 are
+ *   free to clobber and r1 is zero.  RAMPZ is not preserved across calls
+ *   either.  The frame holds SREG, r2 - r17, r28, r29 and the marker 0.
+ *
+ * portRESTORE_CONTEXT() pops whichever frame the next task has.  The full
+ * frame takes 34 bytes and the call frame 20.  Saving every register on every
+ * switch, as the port used to, took 33 bytes, so a task blocked in a kernel
+ * call now keeps 13 bytes less on its stack.
+ *
+ * Cycles on the AVRxt core of the Mega-0 family, without RAMPZ, computed
+ * from the instruction timings, not measured:
+ *
+ *                           save    restore
+ *   full frame               48       85
+ *   call frame               32       56
+ *
+ * Cycles the port adds to a switch, counting everything but the bodies of the
+ * kernel functions it calls.  The tick counts start with the interrupt
+ * response and the vector jump.
+ *
+ *                                   two frames   full frame only
+ *   taskYIELD() to a yielded task      102           139
+ *   taskYIELD() to a preempted task    131           143
+ *   tick to a yielded task             131           158
+ *   tick to a preempted task           160           162
+ *   tick without a switch              153           155 */
+
 /* Macro to save all the general purpose registers, the save the stack pointer
  * into the TCB.
 
@@ -192,6 +241,8 @@ extern void vPortSuppressTicksAndSleep(TickType_t xExpectedIdleTime);
                      "push  r29                     \n\t"   \
                      "push  r30                     \n\t"   \
                      "push  r31                     \n\t"   \
+                     "ldi   r16, 1                  \n\t"   \
+                     "push  r16                     \n\t"   \
                      "lds   r26, pxCurrentTCB       \n\t"   \
                      "lds   r27, pxCurrentTCB + 1   \n\t"   \
                      "in    r0, __SP_L__            \n\t"   \
@@ -200,8 +251,45 @@ extern void vPortSuppressTicksAndSleep(TickType_t xExpectedIdleTime);
                      "st    x+, r0                  \n\t"); \
     }
 
-/* Opposite to portSAVE_CONTEXT().  Interrupts will have been disabled during
- * the context save so we can write to the stack pointer. */
+/* Saves the call frame.  Only for the naked functions called from C, where
+ * r0, r26 and r27 are free and r1 is already zero. */
+#define portSAVE_CALL_CONTEXT()                             \
+    {                                                       \
+        asm volatile("in    r0, __SREG__            \n\t"   \
+                     "cli                           \n\t"   \
+                     "push  r0                      \n\t"   \
+                     "push  r2                      \n\t"   \
+                     "push  r3                      \n\t"   \
+                     "push  r4                      \n\t"   \
+                     "push  r5                      \n\t"   \
+                     "push  r6                      \n\t"   \
+                     "push  r7                      \n\t"   \
+                     "push  r8                      \n\t"   \
+                     "push  r9                      \n\t"   \
+                     "push  r10                     \n\t"   \
+                     "push  r11                     \n\t"   \
+                     "push  r12                     \n\t"   \
+                     "push  r13                     \n\t"   \
+                     "push  r14                     \n\t"   \
+                     "push  r15                     \n\t"   \
+                     "push  r16                     \n\t"   \
+                     "push  r17                     \n\t"   \
+                     "push  r28                     \n\t"   \
+                     "push  r29                     \n\t"   \
+                     "push  r1                      \n\t"   \
+                     "lds   r26, pxCurrentTCB       \n\t"   \
+                     "lds   r27, pxCurrentTCB + 1   \n\t"   \
+                     "in    r0, __SP_L__            \n\t"   \
+                     "st    x+, r0                  \n\t"   \
+                     "in    r0, __SP_H__            \n\t"   \
+                     "st    x+, r0                  \n\t"); \
+    }
+
+/* Opposite to portSAVE_CONTEXT() and portSAVE_CALL_CONTEXT(), the marker
+ * selects the frame.  The test, both pop sequences and their local labels are
+ * in one asm statement, the compiler may place code between two statements.
+ * Interrupts will have been disabled during the context save so we can write
+ * to the stack pointer. */
 #define portRESTORE_CONTEXT()                               \
     {                                                       \
         asm volatile("lds   r26, pxCurrentTCB       \n\t"   \
@@ -210,6 +298,9 @@ extern void vPortSuppressTicksAndSleep(TickType_t xExpectedIdleTime);
                      "out   __SP_L__, r28           \n\t"   \
                      "ld    r29, x+                 \n\t"   \
                      "out   __SP_H__, r29           \n\t"   \
+                     "pop   r0                      \n\t"   \
+                     "tst   r0                      \n\t"   \
+                     "breq  1f                      \n\t"   \
                      "pop   r31                     \n\t"   \
                      "pop   r30                     \n\t"   \
                      "pop   r29                     \n\t"   \
@@ -240,11 +331,34 @@ extern void vPortSuppressTicksAndSleep(TickType_t xExpectedIdleTime);
                      "pop   r4                      \n\t"   \
                      "pop   r3                      \n\t"   \
                      "pop   r2                      \n\t"   \
-                     "pop   r1                      \n\t"); \
-        portRESTORE_RAMPZ();                                \
-        asm volatile("pop   r0                      \n\t"   \
+                     "pop   r1                      \n\t"   \
+                     portRESTORE_RAMPZ_ASM                  \
+                     "pop   r0                      \n\t"   \
+                     "out   __SREG__, r0            \n\t"   \
+                     "pop   r0                      \n\t"   \
+                     "rjmp  2f                      \n\t"   \
+                     "1:                            \n\t"   \
+                     "pop   r29                     \n\t"   \
+                     "pop   r28                     \n\t"   \
+                     "pop   r17                     \n\t"   \
+                     "pop   r16                     \n\t"   \
+                     "pop   r15                     \n\t"   \
+                     "pop   r14                     \n\t"   \
+                     "pop   r13                     \n\t"   \
+                     "pop   r12                     \n\t"   \
+                     "pop   r11                     \n\t"   \
+                     "pop   r10                     \n\t"   \
+                     "pop   r9                      \n\t"   \
+                     "pop   r8                      \n\t"   \
+                     "pop   r7                      \n\t"   \
+                     "pop   r6                      \n\t"   \
+                     "pop   r5                      \n\t"   \
+                     "pop   r4                      \n\t"   \
+                     "pop   r3                      \n\t"   \
+                     "pop   r2                      \n\t"   \
+                     "pop   r0                      \n\t"   \
                      "out   __SREG__, r0            \n\t"   \
-                     "pop   r0                      \n\t"); \
+                     "2:                            \n\t"); \
     }
 /*-----------------------------------------------------------*/
 
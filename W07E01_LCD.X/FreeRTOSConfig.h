@@ -44,15 +44,44 @@ For other frequency values, update clock_config.h with your own settings. */
 #define configSUPPORT_DYNAMIC_ALLOCATION 1
 #define configTOTAL_HEAP_SIZE 0x1000
 #define configAPPLICATION_ALLOCATED_HEAP 0
+/*
+* 1 turns the diagnostics on USART0 on: heap, run time and ADC statistics and
+* the kernel trace, with the run time stats clock and trace facility they
+* need. Off in the firmware, where they would fill the serial terminal with
+* binary frames and block USART0. Set it on the compiler command line so
+* every file sees the same value, the host simulation builds with 1.
+*/
+#ifndef APP_DIAGNOSTICS
+#define APP_DIAGNOSTICS 0
+#endif
+/*
+* 1 builds the display refresh, serial telemetry and LED rule as co-routines
+* instead of tasks, see main.c. The idle hook schedules them.
+*/
+#ifndef APP_CO_ROUTINES
+#define APP_CO_ROUTINES 0
+#endif
 /* Hook function related definitions. */
-#define configUSE_IDLE_HOOK 0
+#define configUSE_IDLE_HOOK APP_CO_ROUTINES
 #define configUSE_TICK_HOOK 0
 #define configCHECK_FOR_STACK_OVERFLOW 0
 #define configUSE_MALLOC_FAILED_HOOK 0
 #define configUSE_DAEMON_TASK_STARTUP_HOOK 0
-/* Run time and task stats gathering related definitions. */
-#define configGENERATE_RUN_TIME_STATS 0
-#define configUSE_TRACE_FACILITY 0
+/* Run time and task stats gathering related definitions, for the
+* diagnostics only. */
+#define configGENERATE_RUN_TIME_STATS APP_DIAGNOSTICS
+#define configUSE_TRACE_FACILITY APP_DIAGNOSTICS
+/*
+* Run time stats clock, a free running TCB at CLK_PER / 2.
+* Must differ from configUSE_TIMER_INSTANCE, TCB3 is the backlight PWM.
+* Timer instance | Value
+* ----------------|---------
+* TCB0 | 0
+* TCB1 | 1
+* TCB2 | 2
+* TCB3 | 3
+*/
+#define configRUN_TIME_STATS_TIMER_INSTANCE 1
 #define configUSE_STATS_FORMATTING_FUNCTIONS 0
 /* Co-routine related definitions. */
 #define configUSE_CO_ROUTINES 1
@@ -97,4 +126,6 @@ For other frequency values, update clock_config.h with your own settings. */
  (uint32_t)1000))
 #define recmuRECURSIVE_MUTEX_TEST_TASK_STACK_SIZE \
  ( configMINIMAL_STACK_SIZE * 2 )
+/* Kernel trace recorder, defines the trace macros. */
+#include "tracerecorder.h"
 #endif /* FREERTOSCONFIG_H */
\ No newline at end of file
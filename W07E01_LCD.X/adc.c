@@ -11,37 +11,69 @@
 
 
 #include <avr/io.h>
+#include <stdio.h> // To use printf function
 // FreeRTOS
 #include "FreeRTOS.h"
+#include "task.h" // For the tick count
 // Include adc.h for use E.g. ADC_result_t struct
 #include "adc.h"
-// Convert function that does ADC converts, takes muxpos as parameter
-uint16_t adc_convert(register8_t muxpos)
+#include "adcsched.h" // Conversion scheduler
+
+// All inputs use the internal reference (2.5v), so REFSEL is written once
+static const adc_channel_t adc_channels[] =
+{
+    [ADC_LDR] = { ADC_MUXPOS_AIN8_gc, ADC_REFSEL_INTREF_gc, 0 },
+    [ADC_NTC] = { ADC_MUXPOS_AIN9_gc, ADC_REFSEL_INTREF_gc, 0 },
+    [ADC_POT] = { ADC_MUXPOS_AIN14_gc, ADC_REFSEL_INTREF_gc, 0 }
+};
+
+#if ADC_STATS_INTERVAL_S > 0
+// Conversions per second in the last window
+static uint16_t adc_throughput;
+static TickType_t adc_window_start;
+#endif
+
+void adc_convert(uint8_t mask)
 {
-        // Clear REFSEL
-        ADC0.CTRLC &= ~ADC_REFSEL_VDDREF_gc;
-        // Set muxpos to parameter value
-        ADC0.MUXPOS = muxpos;
-        // Use internal reference voltage (2.5v)
-        ADC0.CTRLC |= ADC_REFSEL_INTREF_gc;
-        // Start conversion
-        ADC0.COMMAND = ADC_STCONV_bm;
-        // Wait for ADC0.INTFLAGS to get set
-        while (!(ADC0.INTFLAGS & ADC_RESRDY_bm));
-        // Return read value
-        return ADC0.RES;
+    adc_sched_request(mask);
+    adc_sched_run();
+
+#if ADC_STATS_INTERVAL_S > 0
+    TickType_t now = xTaskGetTickCount();
+    TickType_t elapsed = now - adc_window_start;
+
+    // Windows of at least a second, the conversion counter is 16 bits
+    if(elapsed >= pdMS_TO_TICKS(1000))
+    {
+        taskENTER_CRITICAL();
+        adc_throughput = adc_sched_throughput(
+            (uint16_t)(elapsed * 1000UL / configTICK_RATE_HZ));
+        taskEXIT_CRITICAL();
+        adc_window_start = now;
+    }
+#endif
 }
-// Function which reads LDR, NCT and POT, and returns struct
-ADC_result_t adc_read(void)
+
+uint16_t adc_value(uint8_t channel)
 {
-    ADC_result_t adc_result;
-    
-    adc_result.ldr = adc_convert(ADC_MUXPOS_AIN8_gc);
-    adc_result.ntc = adc_convert(ADC_MUXPOS_AIN9_gc);
-    adc_result.pot = adc_convert(ADC_MUXPOS_AIN14_gc);
-    
-    return adc_result;
+    return adc_sched_result(channel);
+}
+
+#if ADC_STATS_INTERVAL_S > 0
+void adc_stats_print(void)
+{
+    uint16_t throughput;
+    uint16_t reference_changes;
+
+    // adc_convert() may update them in between
+    taskENTER_CRITICAL();
+    throughput = adc_throughput;
+    reference_changes = adc_sched_reference_changes();
+    taskEXIT_CRITICAL();
+    printf("ADC: %u conversions/s, %u reference changes\r\n", throughput,
+           reference_changes);
 }
+#endif
 
 void adc_init(void)
 {
@@ -52,6 +84,8 @@ void adc_init(void)
     PORTE.PIN0CTRL = PORT_ISC_INPUT_DISABLE_gc;
     // Set prescaler of 16
     ADC0.CTRLC |= ADC_PRESC_DIV16_gc;
+    // Scheduler sets the reference and the settling delay
+    adc_sched_init(adc_channels, sizeof(adc_channels) / sizeof(adc_channels[0]));
     // Enable ADC
     ADC0.CTRLA |= ADC_ENABLE_bm;
     // Set internal reference voltage to 2.5V
@@ -10,11 +10,24 @@
 #ifndef ADC_H
 #define	ADC_H
 
-// To use SemaphoreHandle_t
-#include "semphr.h" 
+// Seconds between ADC throughput reports on USART0, 0 disables them.
+// Only with APP_DIAGNOSTICS by default, see FreeRTOSConfig.h
+#ifndef ADC_STATS_INTERVAL_S
+#if APP_DIAGNOSTICS == 1
+#define ADC_STATS_INTERVAL_S 5
+#else
+#define ADC_STATS_INTERVAL_S 0
+#endif
+#endif
+
+#include <stdint.h>
+
+// Channel numbers, bit n of a mask is channel n
+#define ADC_LDR 0
+#define ADC_NTC 1
+#define ADC_POT 2
+#define ADC_CHANNELS 3
 
-// Declare mutex for accessing adc reading
-SemaphoreHandle_t mutex;
 // Declare ADC initialize function
 void adc_init(void);
 // Struc for ADC readings
@@ -23,7 +36,12 @@ typedef struct {
     uint16_t ntc;
     uint16_t pot;
 }ADC_result_t;
-// Declare ADC read fucntion, returns struct
-ADC_result_t adc_read(void);
+// Converts the channels in the mask. Only the sampler task converts, the
+// other tasks read its values, see sampler.h
+void adc_convert(uint8_t mask);
+// Last converted value of a channel
+uint16_t adc_value(uint8_t channel);
+// Prints the conversions per second and the reference changes
+void adc_stats_print(void);
 
 #endif	/* ADC_H */
\ No newline at end of file
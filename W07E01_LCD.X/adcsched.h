@@ -0,0 +1,60 @@
+/*
+ * File:   adcsched.h
+ * Author: Nevil Sandaradura
+ * Email: npsand@utu.fi
+ * Device:  ATmega4809 Curiosity Nano
+ *
+ * ADC0 conversion scheduler. The application describes its channels once,
+ * then requests conversions by channel mask. Pending conversions run
+ * grouped by reference and sample length, starting with the configuration
+ * the ADC already has, and a register is only written when its value
+ * changes. The reference settles (ADC_SCHED_SETTLE_gc) only when REFSEL
+ * changes to the internal reference, so a reference change per group
+ * costs one settling delay instead of one per conversion.
+ *
+ * The scheduler owns MUXPOS, SAMPCTRL and the REFSEL bits of CTRLC. The
+ * caller serializes the calls and stops free-running conversions before
+ * adc_sched_run().
+ *
+ * Same file in every project that uses the scheduler.
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef ADCSCHED_H
+#define	ADCSCHED_H
+
+#include <stdint.h>
+
+// Channels in a mask
+#define ADC_SCHED_CHANNELS_MAX 8
+// Initialization delay after enabling the ADC or changing to the internal
+// reference
+#define ADC_SCHED_SETTLE_gc ADC_INITDLY_DLY32_gc
+
+typedef struct
+{
+    uint8_t muxpos;     // ADC_MUXPOS_xxx_gc
+    uint8_t refsel;     // ADC_REFSEL_xxx_gc
+    uint8_t samplen;    // Extra ADC clock cycles to sample, 0-31
+} adc_channel_t;
+
+// Declaring functions
+// Takes the channel table, index in the table is the channel number. The
+// table must stay valid, the ADC must be disabled
+void adc_sched_init(const adc_channel_t *channels, uint8_t count);
+// Adds conversions, bit n is channel n
+void adc_sched_request(uint8_t mask);
+// Converts the pending channels, returns the mask of converted channels
+uint8_t adc_sched_run(void);
+// Result of the last conversion of a channel
+uint16_t adc_sched_result(uint8_t channel);
+// Sets up a channel without converting, for free-running conversions
+void adc_sched_select(uint8_t channel);
+// Conversions per second since the previous call, elapsed_ms is the time
+// since then
+uint16_t adc_sched_throughput(uint16_t elapsed_ms);
+// REFSEL changes since adc_sched_init()
+uint16_t adc_sched_reference_changes(void);
+
+#endif	/* ADCSCHED_H */
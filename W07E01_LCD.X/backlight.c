@@ -13,9 +13,11 @@
 #include <avr/io.h>
 // FreeRTOS
 #include "FreeRTOS.h"
+#include "task.h" // For the notifications
 #include "timers.h" // To use timers
 // Needs to read POT adc value
 #include "adc.h"
+#include "sampler.h" // Published LDR and POT values
 
 // Flag to check if backlight is on
 uint8_t g_backlight_on = 1;
@@ -33,8 +35,8 @@ void backlight_task(void *param)
 {
     // Declare variable for adc results
     ADC_result_t adc_result;
-    // Potentiometer value on last iteration
-    uint16_t pot_last = 0;
+    // Channels that changed
+    uint32_t changed;
     // Declare timer
     TimerHandle_t timeout = xTimerCreate
       ( "timeout",
@@ -43,14 +45,24 @@ void backlight_task(void *param)
         ( void * ) 4,
         timeout_callback);
 
+    // Runs until the POT is turned
+    xTimerStart(timeout, portMAX_DELAY);
     for(;;)
     {
-        // Take mutex to read ADC
-        xSemaphoreTake(mutex, 100);
-        // Save ADC value
-        adc_result = adc_read();
-        // Free mutex
-        xSemaphoreGive(mutex);
+        // Sleep until the sampler publishes a new LDR or POT value
+        xTaskNotifyWait(0, SAMPLER_ALL_BITS, &changed, portMAX_DELAY);
+        sampler_read(&adc_result);
+        // Turning the POT switches the backlight on for another 10 s
+        if(changed & SAMPLER_BIT(ADC_POT))
+        {
+            // Set backlight flag to 1, because backlight is on
+            g_backlight_on = 1;
+            // Starts the timer again, also when it has expired
+            xTimerReset(timeout, portMAX_DELAY);
+        }
+        // The timeout must not switch it off between the check and the
+        // write
+        taskENTER_CRITICAL();
         // Check ig backlight is on
         if(g_backlight_on == 1)
         {
@@ -58,31 +70,7 @@ void backlight_task(void *param)
             // multiply by value 60 seems good
             TCB3.CCMP = adc_result.ldr * 60;
         }
-        // Check if duty cycle is zero and pot value is same as last
-        // iteration
-        if(TCB3.CCMP == 0 && pot_last != adc_result.pot)
-        {
-            // Set backlight flag to 1, because backlight is on
-            g_backlight_on = 1;
-        }
-        // Check if pot value is same as last iteration
-        if(pot_last == adc_result.pot)
-        {
-            // Start the timer if it is not started yet
-            if(xTimerIsTimerActive(timeout) == pdFALSE)
-            {
-                xTimerStart(timeout, 0);
-            }
-        }
-        else{
-            // Stop the timer if it is started
-            if(xTimerIsTimerActive(timeout) == pdTRUE)
-            {
-                xTimerStop(timeout,0);
-            }
-            // Save the pot value for the next iteration
-            pot_last = adc_result.pot;
-        }
+        taskEXIT_CRITICAL();
     }
     // This task run infinitely
     vTaskDelete(NULL);
@@ -0,0 +1,86 @@
+/*
+ * File:   FreeRTOSConfig.h
+ * Author: Nevil Sandaradura
+ * Email: npsand@utu.fi
+ * Device:  Linux host
+ *
+ * Kernel configuration of the micro-benchmarks, run on the Posix port.
+ * Everything the benchmarks measure is enabled, nothing that would add
+ * work to the measured paths (trace macros, stack checking) is.
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef FREERTOSCONFIG_H
+#define FREERTOSCONFIG_H
+
+#define configUSE_PREEMPTION 1
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION 0
+#define configCPU_CLOCK_HZ 1000000000
+#define configTICK_RATE_HZ 1000
+#define configMAX_PRIORITIES 6
+// Tasks run in pthreads (or fibers with PORT=Posix_Fiber) on their FreeRTOS
+// stacks, which must be at least PTHREAD_STACK_MIN and big enough for the
+// host C library
+#define configMINIMAL_STACK_SIZE ((unsigned short)8192)
+#define configMAX_TASK_NAME_LEN 8
+#define configUSE_16_BIT_TICKS 0
+#define configIDLE_SHOULD_YIELD 1
+#define configUSE_TASK_NOTIFICATIONS 1
+#define configUSE_MUTEXES 1
+#define configUSE_RECURSIVE_MUTEXES 1
+#define configUSE_COUNTING_SEMAPHORES 1
+#define configQUEUE_REGISTRY_SIZE 0
+#define configUSE_QUEUE_SETS 0
+#define configUSE_TIME_SLICING 1
+#define configUSE_NEWLIB_REENTRANT 0
+// The Posix port still uses the old type names
+#define configENABLE_BACKWARD_COMPATIBILITY 1
+// For the idle timeout checks
+#define configUSE_STREAM_BUFFER_IDLE_TIMEOUT 1
+
+// For the C++ wrappers in freertos.hpp, see hppchecks.cpp. ~Timer() waits
+// on the last notification index
+#define configSUPPORT_STATIC_ALLOCATION 1
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES 2
+#define configSUPPORT_DYNAMIC_ALLOCATION 1
+#define configTOTAL_HEAP_SIZE ((size_t)(4 * 1024 * 1024))
+
+#define configUSE_IDLE_HOOK 0
+// Stands in for an interrupt in the latency benchmarks
+#define configUSE_TICK_HOOK 1
+#define configCHECK_FOR_STACK_OVERFLOW 0
+#define configUSE_MALLOC_FAILED_HOOK 0
+#define configUSE_DAEMON_TASK_STARTUP_HOOK 0
+#define configGENERATE_RUN_TIME_STATS 0
+#define configUSE_TRACE_FACILITY 0
+#define configUSE_STATS_FORMATTING_FUNCTIONS 0
+#define configUSE_CO_ROUTINES 0
+
+#define configUSE_TIMERS 1
+#define configTIMER_TASK_PRIORITY (configMAX_PRIORITIES - 1)
+#define configTIMER_QUEUE_LENGTH 10
+#define configTIMER_TASK_STACK_DEPTH configMINIMAL_STACK_SIZE
+
+#define INCLUDE_vTaskPrioritySet 1
+#define INCLUDE_uxTaskPriorityGet 1
+#define INCLUDE_vTaskDelete 1
+#define INCLUDE_vTaskSuspend 1
+#define INCLUDE_vTaskDelayUntil 1
+#define INCLUDE_vTaskDelay 1
+#define INCLUDE_xTaskGetSchedulerState 1
+#define INCLUDE_xTaskGetCurrentTaskHandle 1
+#define INCLUDE_xTaskGetIdleTaskHandle 0
+#define INCLUDE_eTaskGetState 1
+#define INCLUDE_xTimerPendFunctionCall 1
+#define INCLUDE_xEventGroupSetBitFromISR 1
+
+// Report the failed assertion and stop the benchmarks
+void bench_assert(const char *file, int line);
+#define configASSERT(x) \
+    if((x) == 0) \
+    { \
+        bench_assert(__FILE__, __LINE__); \
+    }
+
+#endif /* FREERTOSCONFIG_H */
@@ -0,0 +1,82 @@
+/*
+ * File:   bench.h
+ * Author: Nevil Sandaradura
+ * Email: npsand@utu.fi
+ * Device:  Linux host
+ *
+ * Kernel micro-benchmarks. A benchmark runs its operation a given number
+ * of times from the benchmark task and returns the nanoseconds per
+ * operation. Helper tasks are created with bench_task_create() and
+ * deleted by bench_cleanup() after every round.
+ *
+ * Checks are functional tests of kernel features that the benchmarks do
+ * not exercise. A check runs once from the same task, with the same
+ * helpers, and returns the number of expectations that failed.
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef BENCH_H
+#define	BENCH_H
+
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+// Priorities relative to the benchmark task
+#define BENCH_PRIORITY_LOW 1
+#define BENCH_PRIORITY 2
+#define BENCH_PRIORITY_HIGH 3
+
+typedef struct
+{
+    const char *name;
+    const char *operation;      // What one operation is, for the CSV
+    uint32_t iterations;        // Operations per round
+    uint32_t bytes;             // Bytes moved per operation, 0 if none
+    double (*run)(uint32_t iterations);
+} benchmark_t;
+
+extern const benchmark_t bench_kernel[];
+
+typedef struct
+{
+    const char *name;
+    const char *feature;        // What the check covers
+    unsigned (*run)(void);
+} bench_check_t;
+
+extern const bench_check_t bench_checks[];
+// Checks of the C++ wrappers, hppchecks.cpp
+extern const bench_check_t bench_hpp_checks[];
+
+// Counts a failed expectation in the variable failures of the check
+#define BENCH_EXPECT(x) \
+    (failures += bench_expect((x) != 0, #x, __FILE__, __LINE__))
+
+// The task running the benchmarks
+extern TaskHandle_t bench_task;
+// Called from the tick interrupt when set, for benchmarks that need an ISR
+extern void (*volatile bench_tick_hook)(void);
+
+// Monotonic time in nanoseconds
+uint64_t bench_now_ns(void);
+// Creates a helper task that is deleted by bench_cleanup()
+TaskHandle_t bench_task_create(TaskFunction_t code, void *param,
+                               UBaseType_t priority);
+// Deletes the helper tasks and lets the idle task free them
+void bench_cleanup(void);
+// Prints a failed expectation, returns 1 if it failed and 0 if not
+unsigned bench_expect(int ok, const char *expression, const char *file,
+                      int line);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* BENCH_H */
@@ -0,0 +1,635 @@
+/*
+ * File:   benchmarks.c
+ * Author: Nevil Sandaradura
+ * Email: npsand@utu.fi
+ * Device:  Linux host
+ *
+ * Kernel micro-benchmarks. Times are what the operation costs on the
+ * Posix port, where a context switch is a pthread hand-over, so compare
+ * them with each other and with earlier runs, not with the AVR.
+ *
+ * Created on October 19, 2026
+ */
+
+#include <stdint.h>
+#include <string.h>
+// FreeRTOS
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "event_groups.h"
+#include "stream_buffer.h"
+#include "message_buffer.h"
+#include "timers.h"
+#include "seqlock.h"
+
+#include "bench.h"
+
+#define BENCH_QUEUE_LENGTH 64
+#define BENCH_BUFFER_SIZE 1024
+#define BENCH_CHUNK_SIZE 64
+#define BENCH_EVENT_BIT 0x01
+// Bits the waiters of the waiter count benchmarks wait for
+#define BENCH_WAITER_BITS 8
+
+// Same layout as the LCD project's ADC_result_t
+typedef struct
+{
+    uint16_t ldr;
+    uint16_t ntc;
+    uint16_t pot;
+} snapshot_t;
+
+// Objects shared by the benchmark task and its helpers
+static QueueHandle_t queue_a;
+static QueueHandle_t queue_b;
+static SemaphoreHandle_t semaphore;
+static StreamBufferHandle_t buffer;
+static EventGroupHandle_t event_group;
+static volatile uint32_t bytes_expected;
+static volatile uint32_t bytes_received;
+static SeqLockHandle_t seqlock;
+static snapshot_t shared_snapshot;
+static volatile uint64_t isr_time;
+static volatile uint32_t isr_sets;
+static uint64_t latency_total;
+
+/*-----------------------------------------------------------*/
+// Helper tasks
+
+static void yield_task(void *param)
+{
+    for(;;)
+    {
+        taskYIELD();
+    }
+}
+
+static void queue_receiver_task(void *param)
+{
+    uint32_t value;
+
+    for(;;)
+    {
+        xQueueReceive(queue_a, &value, portMAX_DELAY);
+    }
+}
+
+static void queue_echo_task(void *param)
+{
+    uint32_t value;
+
+    for(;;)
+    {
+        xQueueReceive(queue_a, &value, portMAX_DELAY);
+        xQueueSend(queue_b, &value, portMAX_DELAY);
+    }
+}
+
+static void mutex_holder_task(void *param)
+{
+    for(;;)
+    {
+        xSemaphoreTake(semaphore, portMAX_DELAY);
+        // The benchmark task preempts and blocks on the mutex, which
+        // raises this task to its priority until the give
+        xTaskNotifyGive(bench_task);
+        xSemaphoreGive(semaphore);
+    }
+}
+
+static void semaphore_waiter_task(void *param)
+{
+    for(;;)
+    {
+        xSemaphoreTake(semaphore, portMAX_DELAY);
+    }
+}
+
+static void notify_waiter_task(void *param)
+{
+    for(;;)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    }
+}
+
+static void buffer_reader_task(void *param)
+{
+    uint8_t data[BENCH_BUFFER_SIZE];
+    // Message buffers return one message per call, stream buffers as
+    // much as there is
+    size_t size = param != NULL ? BENCH_CHUNK_SIZE : sizeof(data);
+
+    for(;;)
+    {
+        bytes_received += xStreamBufferReceive(buffer, data, size,
+                                               portMAX_DELAY);
+        if(bytes_received >= bytes_expected)
+        {
+            xTaskNotifyGive(bench_task);
+        }
+    }
+}
+
+static void event_waiter_task(void *param)
+{
+    for(;;)
+    {
+        xEventGroupWaitBits(event_group, BENCH_EVENT_BIT, pdTRUE, pdFALSE,
+                            portMAX_DELAY);
+    }
+}
+
+// Waits for a bit that is never set
+static void event_idle_waiter_task(void *param)
+{
+    for(;;)
+    {
+        xEventGroupWaitBits(event_group, (EventBits_t)(uintptr_t)param, pdTRUE,
+                            pdTRUE, portMAX_DELAY);
+    }
+}
+
+// Measures from the tick interrupt setting the bit to this task running
+static void event_latency_task(void *param)
+{
+    for(;;)
+    {
+        xEventGroupWaitBits(event_group, BENCH_EVENT_BIT, pdTRUE, pdFALSE,
+                            portMAX_DELAY);
+        latency_total += bench_now_ns() - isr_time;
+        if(--isr_sets == 0)
+        {
+            bench_tick_hook = NULL;
+            xTaskNotifyGive(bench_task);
+        }
+    }
+}
+
+static void event_set_from_isr(void)
+{
+    // The Posix tick handler switches context after the hook, the yield
+    // is picked up from xYieldPending
+    isr_time = bench_now_ns();
+    xEventGroupSetBitsFromISR(event_group, BENCH_EVENT_BIT, NULL);
+}
+
+static void pended_notify(void *param1, uint32_t param2)
+{
+    xTaskNotifyGive(bench_task);
+}
+
+static void timer_callback(TimerHandle_t timer)
+{
+}
+
+/*-----------------------------------------------------------*/
+// Benchmarks
+
+// Two tasks of the same priority yielding to each other
+static double bench_context_switch(uint32_t iterations)
+{
+    uint64_t start;
+
+    bench_task_create(yield_task, NULL, BENCH_PRIORITY);
+    taskYIELD();
+    start = bench_now_ns();
+    for(uint32_t i = 0; i < iterations; i++)
+    {
+        taskYIELD();
+    }
+    start = bench_now_ns() - start;
+    bench_cleanup();
+    // Every yield switches to the other task and back
+    return start / (2.0 * iterations);
+}
+
+// Send or receive without blocking, the other half is not timed
+static double queue_no_block(uint32_t iterations, uint8_t time_send)
+{
+    uint64_t elapsed = 0;
+    uint32_t value = 0;
+    uint32_t done = 0;
+
+    queue_a = xQueueCreate(BENCH_QUEUE_LENGTH, sizeof(uint32_t));
+    while(done < iterations)
+    {
+        uint32_t batch = iterations - done < BENCH_QUEUE_LENGTH ?
+                         iterations - done : BENCH_QUEUE_LENGTH;
+        uint64_t start = bench_now_ns();
+
+        for(uint32_t i = 0; i < batch; i++)
+        {
+            xQueueSend(queue_a, &value, 0);
+        }
+        if(time_send)
+        {
+            elapsed += bench_now_ns() - start;
+        }
+        start = bench_now_ns();
+        for(uint32_t i = 0; i < batch; i++)
+        {
+            xQueueReceive(queue_a, &value, 0);
+        }
+        if(!time_send)
+        {
+            elapsed += bench_now_ns() - start;
+        }
+        done += batch;
+    }
+    vQueueDelete(queue_a);
+    return (double)elapsed / iterations;
+}
+
+static double bench_queue_send(uint32_t iterations)
+{
+    return queue_no_block(iterations, 1);
+}
+
+static double bench_queue_receive(uint32_t iterations)
+{
+    return queue_no_block(iterations, 0);
+}
+
+// Every send unblocks a higher priority receiver, which runs at once
+static double bench_queue_send_wake(uint32_t iterations)
+{
+    uint64_t start;
+
+    queue_a = xQueueCreate(1, sizeof(uint32_t));
+    bench_task_create(queue_receiver_task, NULL, BENCH_PRIORITY_HIGH);
+    start = bench_now_ns();
+    for(uint32_t i = 0; i < iterations; i++)
+    {
+        xQueueSend(queue_a, &i, portMAX_DELAY);
+    }
+    start = bench_now_ns() - start;
+    bench_cleanup();
+    vQueueDelete(queue_a);
+    return (double)start / iterations;
+}
+
+// Message to an echo task and back, both sides block on receive
+static double bench_queue_round_trip(uint32_t iterations)
+{
+    uint64_t start;
+    uint32_t value;
+
+    queue_a = xQueueCreate(1, sizeof(uint32_t));
+    queue_b = xQueueCreate(1, sizeof(uint32_t));
+    bench_task_create(queue_echo_task, NULL, BENCH_PRIORITY);
+    start = bench_now_ns();
+    for(uint32_t i = 0; i < iterations; i++)
+    {
+        xQueueSend(queue_a, &i, portMAX_DELAY);
+        xQueueReceive(queue_b, &value, portMAX_DELAY);
+    }
+    start = bench_now_ns() - start;
+    bench_cleanup();
+    vQueueDelete(queue_a);
+    vQueueDelete(queue_b);
+    return (double)start / iterations;
+}
+
+static double bench_mutex(uint32_t iterations)
+{
+    uint64_t start;
+
+    semaphore = xSemaphoreCreateMutex();
+    start = bench_now_ns();
+    for(uint32_t i = 0; i < iterations; i++)
+    {
+        xSemaphoreTake(semaphore, portMAX_DELAY);
+        xSemaphoreGive(semaphore);
+    }
+    start = bench_now_ns() - start;
+    vSemaphoreDelete(semaphore);
+    return (double)start / iterations;
+}
+
+// Copy of a snapshot guarded by a mutex, as the LCD project reads the ADC
+static double bench_mutex_snapshot(uint32_t iterations)
+{
+    volatile snapshot_t copy;
+    uint64_t start;
+
+    semaphore = xSemaphoreCreateMutex();
+    start = bench_now_ns();
+    for(uint32_t i = 0; i < iterations; i++)
+    {
+        xSemaphoreTake(semaphore, portMAX_DELAY);
+        copy = shared_snapshot;
+        xSemaphoreGive(semaphore);
+    }
+    start = bench_now_ns() - start;
+    vSemaphoreDelete(semaphore);
+    (void)copy;
+    return (double)start / iterations;
+}
+
+static double bench_seqlock_read(uint32_t iterations)
+{
+    snapshot_t copy;
+    uint64_t start;
+
+    seqlock = xSeqLockCreate(sizeof(snapshot_t));
+    start = bench_now_ns();
+    for(uint32_t i = 0; i < iterations; i++)
+    {
+        uxSeqLockRead(seqlock, &copy);
+    }
+    start = bench_now_ns() - start;
+    vSeqLockDelete(seqlock);
+    return (double)start / iterations;
+}
+
+static double bench_seqlock_write(uint32_t iterations)
+{
+    snapshot_t snapshot = { 0 };
+    uint64_t start;
+
+    seqlock = xSeqLockCreate(sizeof(snapshot_t));
+    start = bench_now_ns();
+    for(uint32_t i = 0; i < iterations; i++)
+    {
+        snapshot.pot = i;
+        vSeqLockWrite(seqlock, &snapshot);
+    }
+    start = bench_now_ns() - start;
+    vSeqLockDelete(seqlock);
+    return (double)start / iterations;
+}
+
+// Take of a mutex held by a lower priority task, which inherits the
+// priority of this task until it gives the mutex
+static double bench_mutex_inheritance(uint32_t iterations)
+{
+    uint64_t start;
+
+    semaphore = xSemaphoreCreateMutex();
+    bench_task_create(mutex_holder_task, NULL, BENCH_PRIORITY_LOW);
+    start = bench_now_ns();
+    for(uint32_t i = 0; i < iterations; i++)
+    {
+        // Runs the holder until it has the mutex
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        xSemaphoreTake(semaphore, portMAX_DELAY);
+        xSemaphoreGive(semaphore);
+    }
+    start = bench_now_ns() - start;
+    bench_cleanup();
+    vSemaphoreDelete(semaphore);
+    return (double)start / iterations;
+}
+
+// Give that wakes a higher priority task blocked on the semaphore
+static double bench_semaphore_signal(uint32_t iterations)
+{
+    uint64_t start;
+
+    semaphore = xSemaphoreCreateBinary();
+    bench_task_create(semaphore_waiter_task, NULL, BENCH_PRIORITY_HIGH);
+    start = bench_now_ns();
+    for(uint32_t i = 0; i < iterations; i++)
+    {
+        xSemaphoreGive(semaphore);
+    }
+    start = bench_now_ns() - start;
+    bench_cleanup();
+    vSemaphoreDelete(semaphore);
+    return (double)start / iterations;
+}
+
+// Same as bench_semaphore_signal with a direct task notification
+static double bench_notify_signal(uint32_t iterations)
+{
+    TaskHandle_t waiter;
+    uint64_t start;
+
+    waiter = bench_task_create(notify_waiter_task, NULL,
+                               BENCH_PRIORITY_HIGH);
+    start = bench_now_ns();
+    for(uint32_t i = 0; i < iterations; i++)
+    {
+        xTaskNotifyGive(waiter);
+    }
+    start = bench_now_ns() - start;
+    bench_cleanup();
+    return (double)start / iterations;
+}
+
+// Writes chunks into a buffer drained by a lower priority reader, which
+// runs whenever the buffer is full
+static double buffer_throughput(uint32_t iterations, uint8_t message)
+{
+    uint8_t chunk[BENCH_CHUNK_SIZE];
+    uint64_t start;
+
+    memset(chunk, 0x55, sizeof(chunk));
+    buffer = message ? xMessageBufferCreate(BENCH_BUFFER_SIZE) :
+                       xStreamBufferCreate(BENCH_BUFFER_SIZE, 1);
+    bytes_received = 0;
+    bytes_expected = iterations * BENCH_CHUNK_SIZE;
+    bench_task_create(buffer_reader_task, message ? buffer : NULL,
+                      BENCH_PRIORITY_LOW);
+    start = bench_now_ns();
+    for(uint32_t i = 0; i < iterations; i++)
+    {
+        xStreamBufferSend(buffer, chunk, sizeof(chunk), portMAX_DELAY);
+    }
+    // Wait for the reader to empty the buffer
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    start = bench_now_ns() - start;
+    bench_cleanup();
+    vStreamBufferDelete(buffer);
+    return (double)start / iterations;
+}
+
+static double bench_stream_buffer(uint32_t iterations)
+{
+    return buffer_throughput(iterations, 0);
+}
+
+static double bench_message_buffer(uint32_t iterations)
+{
+    return buffer_throughput(iterations, 1);
+}
+
+// Set with nobody waiting
+static double bench_event_group_set(uint32_t iterations)
+{
+    uint64_t start;
+
+    event_group = xEventGroupCreate();
+    start = bench_now_ns();
+    for(uint32_t i = 0; i < iterations; i++)
+    {
+        xEventGroupSetBits(event_group, BENCH_EVENT_BIT);
+    }
+    start = bench_now_ns() - start;
+    vEventGroupDelete(event_group);
+    return (double)start / iterations;
+}
+
+// Set that releases a higher priority task waiting for the bit
+static double bench_event_group_set_wake(uint32_t iterations)
+{
+    uint64_t start;
+
+    event_group = xEventGroupCreate();
+    bench_task_create(event_waiter_task, NULL, BENCH_PRIORITY_HIGH);
+    start = bench_now_ns();
+    for(uint32_t i = 0; i < iterations; i++)
+    {
+        xEventGroupSetBits(event_group, BENCH_EVENT_BIT);
+    }
+    start = bench_now_ns() - start;
+    bench_cleanup();
+    vEventGroupDelete(event_group);
+    return (double)start / iterations;
+}
+
+// Set with tasks blocked on the group waiting for other bits, which the
+// set has to pass over
+static double event_group_set_waiters(uint32_t iterations, uint8_t waiters)
+{
+    uint64_t start;
+
+    event_group = xEventGroupCreate();
+    for(uint8_t i = 0; i < waiters; i++)
+    {
+        EventBits_t bits = BENCH_EVENT_BIT << (1 + i % BENCH_WAITER_BITS);
+
+        // Higher priority, so the waiter blocks before this returns
+        bench_task_create(event_idle_waiter_task, (void *)(uintptr_t)bits,
+                          BENCH_PRIORITY_HIGH);
+    }
+    start = bench_now_ns();
+    for(uint32_t i = 0; i < iterations; i++)
+    {
+        xEventGroupSetBits(event_group, BENCH_EVENT_BIT);
+    }
+    start = bench_now_ns() - start;
+    bench_cleanup();
+    vEventGroupDelete(event_group);
+    return (double)start / iterations;
+}
+
+static double bench_event_group_set_1(uint32_t iterations)
+{
+    return event_group_set_waiters(iterations, 1);
+}
+
+static double bench_event_group_set_8(uint32_t iterations)
+{
+    return event_group_set_waiters(iterations, 8);
+}
+
+static double bench_event_group_set_32(uint32_t iterations)
+{
+    return event_group_set_waiters(iterations, 32);
+}
+
+// Bit set from the tick interrupt releasing a waiting task, one set per
+// tick. Deferred through the timer task unless the kernel is built with
+// configUSE_EVENT_GROUP_DIRECT_FROM_ISR.
+static double bench_event_group_isr_latency(uint32_t iterations)
+{
+    event_group = xEventGroupCreate();
+    latency_total = 0;
+    isr_sets = iterations;
+    bench_task_create(event_latency_task, NULL, BENCH_PRIORITY_HIGH);
+    bench_tick_hook = event_set_from_isr;
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    bench_cleanup();
+    vEventGroupDelete(event_group);
+    return (double)latency_total / iterations;
+}
+
+// Timer command processed by the higher priority daemon before the
+// send returns
+static double bench_timer_command(uint32_t iterations)
+{
+    TimerHandle_t timer;
+    uint64_t start;
+
+    timer = xTimerCreate("bench", pdMS_TO_TICKS(1000), pdFALSE, NULL,
+                         timer_callback);
+    start = bench_now_ns();
+    for(uint32_t i = 0; i < iterations; i += 2)
+    {
+        xTimerStart(timer, portMAX_DELAY);
+        xTimerStop(timer, portMAX_DELAY);
+    }
+    start = bench_now_ns() - start;
+    xTimerDelete(timer, portMAX_DELAY);
+    return (double)start / iterations;
+}
+
+// Function pended to the daemon, which notifies this task back
+static double bench_timer_round_trip(uint32_t iterations)
+{
+    uint64_t start;
+
+    start = bench_now_ns();
+    for(uint32_t i = 0; i < iterations; i++)
+    {
+        xTimerPendFunctionCall(pended_notify, NULL, 0, portMAX_DELAY);
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    }
+    start = bench_now_ns() - start;
+    return (double)start / iterations;
+}
+
+/*-----------------------------------------------------------*/
+
+const benchmark_t bench_kernel[] =
+{
+    { "context_switch", "taskYIELD switch between two tasks",
+      20000, 0, bench_context_switch },
+    { "queue_send", "xQueueSend no wait not full",
+      200000, 0, bench_queue_send },
+    { "queue_receive", "xQueueReceive no wait not empty",
+      200000, 0, bench_queue_receive },
+    { "queue_send_wake", "xQueueSend waking a higher priority receiver",
+      10000, 0, bench_queue_send_wake },
+    { "queue_round_trip", "xQueueSend and blocking xQueueReceive via echo task",
+      10000, 0, bench_queue_round_trip },
+    { "mutex", "xSemaphoreTake and xSemaphoreGive uncontended",
+      200000, 0, bench_mutex },
+    { "mutex_inheritance", "mutex take from lower priority holder and give",
+      5000, 0, bench_mutex_inheritance },
+    { "mutex_snapshot", "6 byte snapshot copied under a mutex",
+      200000, 0, bench_mutex_snapshot },
+    { "seqlock_read", "6 byte snapshot read from a sequence lock",
+      200000, 0, bench_seqlock_read },
+    { "seqlock_write", "6 byte snapshot written to a sequence lock",
+      200000, 0, bench_seqlock_write },
+    { "semaphore_signal", "binary semaphore give waking a task",
+      10000, 0, bench_semaphore_signal },
+    { "notify_signal", "xTaskNotifyGive waking a task",
+      10000, 0, bench_notify_signal },
+    { "stream_buffer", "64 byte stream buffer send with reader",
+      50000, BENCH_CHUNK_SIZE, bench_stream_buffer },
+    { "message_buffer", "64 byte message buffer send with reader",
+      50000, BENCH_CHUNK_SIZE, bench_message_buffer },
+    { "event_group_set", "xEventGroupSetBits without waiters",
+      200000, 0, bench_event_group_set },
+    { "event_group_set_wake", "xEventGroupSetBits releasing a task",
+      10000, 0, bench_event_group_set_wake },
+    { "event_group_set_1", "xEventGroupSetBits with 1 task waiting for other bits",
+      200000, 0, bench_event_group_set_1 },
+    { "event_group_set_8", "xEventGroupSetBits with 8 tasks waiting for other bits",
+      200000, 0, bench_event_group_set_8 },
+    { "event_group_set_32", "xEventGroupSetBits with 32 tasks waiting for other bits",
+      200000, 0, bench_event_group_set_32 },
+    { "event_group_isr_latency", "xEventGroupSetBitsFromISR to the waiting task running",
+      250, 0, bench_event_group_isr_latency },
+    { "timer_command", "timer start or stop processed by the daemon",
+      10000, 0, bench_timer_command },
+    { "timer_round_trip", "xTimerPendFunctionCall notifying back",
+      10000, 0, bench_timer_round_trip },
+    { NULL, NULL, 0, 0, NULL }
+};
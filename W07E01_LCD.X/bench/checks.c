@@ -0,0 +1,542 @@
+/*
+ * File:   checks.c
+ * Author: Nevil Sandaradura
+ * Email: npsand@utu.fi
+ * Device:  Linux host
+ *
+ * Functional checks of the kernel additions, run with kernelbench -c
+ * (make check). Waits are in real ticks of the Posix port, so the time
+ * limits leave room for a loaded host.
+ *
+ * Created on October 19, 2026
+ */
+
+#include <stdint.h>
+#include <string.h>
+// FreeRTOS
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stream_buffer.h"
+#include "message_buffer.h"
+#include "mempool.h"
+
+#include "bench.h"
+
+#define CHECK_BUFFER_SIZE 64
+// Slack for a task that should have run already
+#define CHECK_SLACK_TICKS 50
+// Idle gap and trigger level of the idle timeout checks
+#define CHECK_IDLE_TICKS 10
+#define CHECK_TRIGGER_LEVEL 32
+// Larger than any hole the task stacks leave in the heap, so the heap checks
+// allocate from the largest free block, see check_heap_begin()
+#define CHECK_HEAP_BLOCK_SIZE ((size_t)256 * 1024)
+#define CHECK_HEAP_BLOCKS 8
+#define CHECK_POOL_BLOCKS 4
+#define CHECK_POOL_BLOCK_SIZE 24
+
+static StreamBufferHandle_t check_buffer;
+static const uint8_t check_header[] = { 0xA5, 0x07 };
+static const uint8_t check_payload[] = "payload";
+static const uint8_t check_crc[] = { 0x12, 0x34 };
+// One message in three fragments and an empty one
+static const StreamBufferFragment_t check_fragments[] =
+{
+    { check_header, sizeof(check_header) },
+    { check_payload, sizeof(check_payload) },
+    { NULL, 0 },
+    { check_crc, sizeof(check_crc) }
+};
+#define CHECK_FRAGMENT_COUNT \
+    (sizeof(check_fragments) / sizeof(check_fragments[0]))
+#define CHECK_MESSAGE_LENGTH \
+    (sizeof(check_header) + sizeof(check_payload) + sizeof(check_crc))
+static volatile size_t check_isr_sent;
+static MemoryPoolHandle_t check_pool;
+static void *check_pool_block;
+static void * volatile check_pool_isr_block;
+
+/*-----------------------------------------------------------*/
+// Helpers
+
+// Whether data is the fragments one after another
+static int check_is_message(const uint8_t *data)
+{
+    return memcmp(data, check_header, sizeof(check_header)) == 0 &&
+           memcmp(data + sizeof(check_header), check_payload,
+                  sizeof(check_payload)) == 0 &&
+           memcmp(data + sizeof(check_header) + sizeof(check_payload),
+                  check_crc, sizeof(check_crc)) == 0;
+}
+
+// Sends the fragments once from the tick interrupt
+static void check_fragments_from_isr(void)
+{
+    bench_tick_hook = NULL;
+    check_isr_sent = xStreamBufferSendFragmentsFromISR(check_buffer,
+                                                       check_fragments,
+                                                       CHECK_FRAGMENT_COUNT,
+                                                       NULL);
+}
+
+// Sends nothing every tick, a send that writes no bytes
+static void check_empty_sender_task(void *param)
+{
+    for(;;)
+    {
+        xStreamBufferSend(check_buffer, check_payload, 0, 0);
+        vTaskDelay(1);
+    }
+}
+
+// Writes a few bytes, less than the trigger level, and returns how many
+// ticks the receive took to return them
+static TickType_t check_idle_receive(unsigned *failures)
+{
+    uint8_t data[CHECK_BUFFER_SIZE];
+    TickType_t start;
+
+    xStreamBufferSend(check_buffer, check_header, sizeof(check_header), 0);
+    start = xTaskGetTickCount();
+    if(xStreamBufferReceive(check_buffer, data, sizeof(data), 1000) !=
+       sizeof(check_header))
+    {
+        (*failures)++;
+    }
+    return xTaskGetTickCount() - start;
+}
+
+// Stops the other tasks from allocating and returns the heap statistics.
+// The blocks the checks allocate come from the largest free block, as
+// the holes are all smaller
+static void check_heap_begin(HeapStats_t *stats, unsigned *failures)
+{
+    vTaskSuspendAll();
+    vPortGetHeapStats(stats);
+    if(stats->xAvailableHeapSpaceInBytes -
+       stats->xSizeOfLargestFreeBlockInBytes >= CHECK_HEAP_BLOCK_SIZE ||
+       stats->xSizeOfLargestFreeBlockInBytes <
+       (CHECK_HEAP_BLOCKS + 1) * (CHECK_HEAP_BLOCK_SIZE + 64)) // + headers
+    {
+        (*failures)++;
+    }
+}
+
+// Frees check_pool_block after a few ticks
+static void check_pool_free_task(void *param)
+{
+    vTaskDelay(5);
+    vMemoryPoolFree(check_pool, check_pool_block);
+    vTaskSuspend(NULL);
+}
+
+// Tries to allocate from the empty pool and frees the task's block, once
+// from the tick interrupt
+static void check_pool_free_from_isr(void)
+{
+    bench_tick_hook = NULL;
+    check_pool_isr_block = pvMemoryPoolAllocFromISR(check_pool);
+    vMemoryPoolFreeFromISR(check_pool, check_pool_block, NULL);
+}
+
+// Allocates once from the tick interrupt
+static void check_pool_alloc_from_isr(void)
+{
+    bench_tick_hook = NULL;
+    check_pool_isr_block = pvMemoryPoolAllocFromISR(check_pool);
+}
+
+/*-----------------------------------------------------------*/
+// Checks
+
+// The fragments of a message get one length prefix and are received as
+// one message
+static unsigned check_fragment_message(void)
+{
+    uint8_t data[CHECK_BUFFER_SIZE];
+    unsigned failures = 0;
+
+    check_buffer = xMessageBufferCreate(CHECK_BUFFER_SIZE);
+    BENCH_EXPECT(xMessageBufferSendFragments(check_buffer, check_fragments,
+                                             CHECK_FRAGMENT_COUNT, 0) ==
+                 CHECK_MESSAGE_LENGTH);
+    BENCH_EXPECT(xStreamBufferBytesAvailable(check_buffer) ==
+                 CHECK_MESSAGE_LENGTH + sizeof(size_t));
+    BENCH_EXPECT(xStreamBufferNextMessageLengthBytes(check_buffer) ==
+                 CHECK_MESSAGE_LENGTH);
+    memset(data, 0, sizeof(data));
+    BENCH_EXPECT(xMessageBufferReceive(check_buffer, data, sizeof(data), 0) ==
+                 CHECK_MESSAGE_LENGTH);
+    BENCH_EXPECT(check_is_message(data));
+    BENCH_EXPECT(xMessageBufferIsEmpty(check_buffer) == pdTRUE);
+    vMessageBufferDelete(check_buffer);
+    return failures;
+}
+
+// A stream buffer takes what fits, in fragment order. A message buffer
+// takes nothing, after waiting for space, or at once if the message can
+// never fit
+static unsigned check_fragment_partial(void)
+{
+    uint8_t data[CHECK_BUFFER_SIZE];
+    unsigned failures = 0;
+    TickType_t start;
+    TickType_t elapsed;
+
+    // Room for the header and 3 bytes of the payload
+    check_buffer = xStreamBufferCreate(sizeof(check_header) + 3, 1);
+    BENCH_EXPECT(xStreamBufferSendFragments(check_buffer, check_fragments,
+                                            CHECK_FRAGMENT_COUNT, 0) ==
+                 sizeof(check_header) + 3);
+    BENCH_EXPECT(xStreamBufferReceive(check_buffer, data, sizeof(data), 0) ==
+                 sizeof(check_header) + 3);
+    BENCH_EXPECT(memcmp(data, check_header, sizeof(check_header)) == 0);
+    BENCH_EXPECT(memcmp(data + sizeof(check_header), check_payload, 3) == 0);
+    vStreamBufferDelete(check_buffer);
+
+    // Room for one message, the second waits and times out
+    check_buffer = xMessageBufferCreate(CHECK_MESSAGE_LENGTH + sizeof(size_t));
+    BENCH_EXPECT(xMessageBufferSendFragments(check_buffer, check_fragments,
+                                             CHECK_FRAGMENT_COUNT, 0) ==
+                 CHECK_MESSAGE_LENGTH);
+    start = xTaskGetTickCount();
+    BENCH_EXPECT(xMessageBufferSendFragments(check_buffer, check_fragments,
+                                             CHECK_FRAGMENT_COUNT, 20) == 0);
+    elapsed = xTaskGetTickCount() - start;
+    BENCH_EXPECT(elapsed >= 20);
+    BENCH_EXPECT(elapsed < 20 + CHECK_SLACK_TICKS);
+    // The first message is intact
+    BENCH_EXPECT(xMessageBufferReceive(check_buffer, data, sizeof(data), 0) ==
+                 CHECK_MESSAGE_LENGTH);
+    BENCH_EXPECT(check_is_message(data));
+    vMessageBufferDelete(check_buffer);
+
+    // Never fits, must not wait
+    check_buffer = xMessageBufferCreate(CHECK_MESSAGE_LENGTH);
+    start = xTaskGetTickCount();
+    BENCH_EXPECT(xMessageBufferSendFragments(check_buffer, check_fragments,
+                                             CHECK_FRAGMENT_COUNT, 1000) == 0);
+    BENCH_EXPECT(xTaskGetTickCount() - start < CHECK_SLACK_TICKS);
+    vMessageBufferDelete(check_buffer);
+    return failures;
+}
+
+// Fragments sent from an interrupt wake the blocked receiver with the
+// whole message
+static unsigned check_fragment_isr(void)
+{
+    uint8_t data[CHECK_BUFFER_SIZE];
+    unsigned failures = 0;
+
+    check_buffer = xMessageBufferCreate(CHECK_BUFFER_SIZE);
+    check_isr_sent = 0;
+    bench_tick_hook = check_fragments_from_isr;
+    memset(data, 0, sizeof(data));
+    BENCH_EXPECT(xMessageBufferReceive(check_buffer, data, sizeof(data),
+                                       CHECK_SLACK_TICKS) ==
+                 CHECK_MESSAGE_LENGTH);
+    BENCH_EXPECT(check_isr_sent == CHECK_MESSAGE_LENGTH);
+    BENCH_EXPECT(check_is_message(data));
+    bench_tick_hook = NULL;
+    vMessageBufferDelete(check_buffer);
+    return failures;
+}
+
+// Bytes below the trigger level are returned once no more have arrived
+// for the idle gap
+static unsigned check_idle_timeout(void)
+{
+    unsigned failures = 0;
+    TickType_t elapsed;
+
+    check_buffer = xStreamBufferCreate(CHECK_BUFFER_SIZE, CHECK_TRIGGER_LEVEL);
+    BENCH_EXPECT(xStreamBufferSetIdleTimeout(check_buffer, CHECK_IDLE_TICKS) ==
+                 pdPASS);
+    elapsed = check_idle_receive(&failures);
+    BENCH_EXPECT(elapsed >= CHECK_IDLE_TICKS - 1);
+    BENCH_EXPECT(elapsed < CHECK_IDLE_TICKS + CHECK_SLACK_TICKS);
+    vStreamBufferDelete(check_buffer);
+
+    // Message buffers return whole messages, they have no idle gap
+    check_buffer = xMessageBufferCreate(CHECK_BUFFER_SIZE);
+    BENCH_EXPECT(xStreamBufferSetIdleTimeout(check_buffer, CHECK_IDLE_TICKS) ==
+                 pdFAIL);
+    vMessageBufferDelete(check_buffer);
+    return failures;
+}
+
+// Sends that write nothing do not hold the idle gap off
+static unsigned check_idle_failed_send(void)
+{
+    unsigned failures = 0;
+    TickType_t elapsed;
+
+    check_buffer = xStreamBufferCreate(CHECK_BUFFER_SIZE, CHECK_TRIGGER_LEVEL);
+    xStreamBufferSetIdleTimeout(check_buffer, CHECK_IDLE_TICKS);
+    bench_task_create(check_empty_sender_task, NULL, BENCH_PRIORITY_HIGH);
+    elapsed = check_idle_receive(&failures);
+    BENCH_EXPECT(elapsed < CHECK_IDLE_TICKS + CHECK_SLACK_TICKS);
+    bench_cleanup();
+    vStreamBufferDelete(check_buffer);
+    return failures;
+}
+
+// An allocation takes at least its size and a free gives all of it back
+static unsigned check_heap_alloc_free(void)
+{
+    unsigned failures = 0;
+    HeapStats_t start;
+    HeapStats_t stats;
+    void *block;
+
+    check_heap_begin(&start, &failures);
+    block = pvPortMalloc(CHECK_HEAP_BLOCK_SIZE);
+    vPortGetHeapStats(&stats);
+    BENCH_EXPECT(block != NULL);
+    BENCH_EXPECT(((size_t)block & portBYTE_ALIGNMENT_MASK) == 0);
+    BENCH_EXPECT(stats.xAvailableHeapSpaceInBytes <=
+                 start.xAvailableHeapSpaceInBytes - CHECK_HEAP_BLOCK_SIZE);
+    BENCH_EXPECT(stats.xNumberOfSuccessfulAllocations ==
+                 start.xNumberOfSuccessfulAllocations + 1);
+    BENCH_EXPECT(stats.xMinimumEverFreeBytesRemaining <=
+                 stats.xAvailableHeapSpaceInBytes);
+    memset(block, 0x5A, CHECK_HEAP_BLOCK_SIZE);
+    vPortFree(block);
+    vPortGetHeapStats(&stats);
+    BENCH_EXPECT(stats.xAvailableHeapSpaceInBytes ==
+                 start.xAvailableHeapSpaceInBytes);
+    BENCH_EXPECT(stats.xSizeOfLargestFreeBlockInBytes ==
+                 start.xSizeOfLargestFreeBlockInBytes);
+    BENCH_EXPECT(stats.xNumberOfFreeBlocks == start.xNumberOfFreeBlocks);
+    BENCH_EXPECT(stats.xNumberOfSuccessfulFrees ==
+                 start.xNumberOfSuccessfulFrees + 1);
+
+    // More than is free fails and is counted
+    BENCH_EXPECT(pvPortMalloc(start.xAvailableHeapSpaceInBytes) == NULL);
+    vPortGetHeapStats(&stats);
+    BENCH_EXPECT(stats.xNumberOfFailedAllocations ==
+                 start.xNumberOfFailedAllocations + 1);
+    xTaskResumeAll();
+    return failures;
+}
+
+// A smaller allocation splits a hole, freed neighbours merge into one
+// block
+static unsigned check_heap_split_merge(void)
+{
+    unsigned failures = 0;
+    HeapStats_t start;
+    HeapStats_t stats;
+    uint8_t *block[4];
+    uint8_t *half;
+
+    check_heap_begin(&start, &failures);
+    for(int i = 0; i < 4; i++)
+    {
+        block[i] = pvPortMalloc(CHECK_HEAP_BLOCK_SIZE);
+    }
+    BENCH_EXPECT(block[0] != NULL && block[1] != NULL && block[2] != NULL &&
+                 block[3] != NULL);
+
+    // Split the first block's hole, the rest of it stays free
+    vPortFree(block[0]);
+    half = pvPortMalloc(CHECK_HEAP_BLOCK_SIZE / 2);
+    BENCH_EXPECT(half == block[0]);
+    vPortGetHeapStats(&stats);
+    BENCH_EXPECT(stats.xNumberOfFreeBlocks == start.xNumberOfFreeBlocks + 1);
+    vPortFree(half);
+    vPortGetHeapStats(&stats);
+    BENCH_EXPECT(stats.xNumberOfFreeBlocks == start.xNumberOfFreeBlocks + 1);
+
+    // Two holes, then the block between them joins them
+    vPortFree(block[2]);
+    vPortGetHeapStats(&stats);
+    BENCH_EXPECT(stats.xNumberOfFreeBlocks == start.xNumberOfFreeBlocks + 2);
+    vPortFree(block[1]);
+    vPortGetHeapStats(&stats);
+    BENCH_EXPECT(stats.xNumberOfFreeBlocks == start.xNumberOfFreeBlocks + 1);
+    BENCH_EXPECT(stats.xSizeOfLargestFreeBlockInBytes <
+                 start.xSizeOfLargestFreeBlockInBytes);
+    // The last one merges everything back into the largest free block
+    vPortFree(block[3]);
+    vPortGetHeapStats(&stats);
+    BENCH_EXPECT(stats.xNumberOfFreeBlocks == start.xNumberOfFreeBlocks);
+    BENCH_EXPECT(stats.xSizeOfLargestFreeBlockInBytes ==
+                 start.xSizeOfLargestFreeBlockInBytes);
+    BENCH_EXPECT(stats.xAvailableHeapSpaceInBytes ==
+                 start.xAvailableHeapSpaceInBytes);
+    xTaskResumeAll();
+    return failures;
+}
+
+// Freeing every other block leaves holes that do not merge, and
+// allocations larger than the holes do not use them
+static unsigned check_heap_fragmentation(void)
+{
+    unsigned failures = 0;
+    HeapStats_t start;
+    HeapStats_t stats;
+    uint8_t *block[CHECK_HEAP_BLOCKS];
+    uint8_t *large;
+
+    check_heap_begin(&start, &failures);
+    for(int i = 0; i < CHECK_HEAP_BLOCKS; i++)
+    {
+        block[i] = pvPortMalloc(CHECK_HEAP_BLOCK_SIZE);
+        BENCH_EXPECT(block[i] != NULL);
+    }
+    for(int i = 0; i < CHECK_HEAP_BLOCKS; i += 2)
+    {
+        vPortFree(block[i]);
+    }
+    vPortGetHeapStats(&stats);
+    BENCH_EXPECT(stats.xNumberOfFreeBlocks ==
+                 start.xNumberOfFreeBlocks + CHECK_HEAP_BLOCKS / 2);
+    BENCH_EXPECT(stats.xAvailableHeapSpaceInBytes -
+                 stats.xSizeOfLargestFreeBlockInBytes >=
+                 CHECK_HEAP_BLOCKS / 2 * CHECK_HEAP_BLOCK_SIZE);
+
+    // Twice the hole size comes from above the last block
+    large = pvPortMalloc(2 * CHECK_HEAP_BLOCK_SIZE);
+    BENCH_EXPECT(large > block[CHECK_HEAP_BLOCKS - 1]);
+    vPortFree(large);
+
+    for(int i = 1; i < CHECK_HEAP_BLOCKS; i += 2)
+    {
+        vPortFree(block[i]);
+    }
+    vPortGetHeapStats(&stats);
+    BENCH_EXPECT(stats.xNumberOfFreeBlocks == start.xNumberOfFreeBlocks);
+    BENCH_EXPECT(stats.xSizeOfLargestFreeBlockInBytes ==
+                 start.xSizeOfLargestFreeBlockInBytes);
+    xTaskResumeAll();
+    return failures;
+}
+
+// Every block once, aligned, and the counts follow
+static unsigned check_pool_alloc_free(void)
+{
+    unsigned failures = 0;
+    uint8_t *block[CHECK_POOL_BLOCKS];
+
+    check_pool = xMemoryPoolCreate(CHECK_POOL_BLOCKS, CHECK_POOL_BLOCK_SIZE);
+    BENCH_EXPECT(check_pool != NULL);
+    BENCH_EXPECT(xMemoryPoolGetBlockSize(check_pool) ==
+                 mpoolBLOCK_SIZE(CHECK_POOL_BLOCK_SIZE));
+    for(int i = 0; i < CHECK_POOL_BLOCKS; i++)
+    {
+        block[i] = pvMemoryPoolAlloc(check_pool, 0);
+        BENCH_EXPECT(block[i] != NULL);
+        BENCH_EXPECT(((size_t)block[i] & portBYTE_ALIGNMENT_MASK) == 0);
+        BENCH_EXPECT(uxMemoryPoolGetFreeCount(check_pool) ==
+                     CHECK_POOL_BLOCKS - 1 - i);
+        memset(block[i], i, CHECK_POOL_BLOCK_SIZE);
+    }
+    // No two blocks overlap
+    for(int i = 0; i < CHECK_POOL_BLOCKS; i++)
+    {
+        for(int j = 0; j < CHECK_POOL_BLOCK_SIZE; j++)
+        {
+            BENCH_EXPECT(block[i][j] == i);
+        }
+    }
+    BENCH_EXPECT(pvMemoryPoolAlloc(check_pool, 0) == NULL);
+    BENCH_EXPECT(uxMemoryPoolGetMinimumEverFreeCount(check_pool) == 0);
+
+    for(int i = 0; i < CHECK_POOL_BLOCKS; i++)
+    {
+        vMemoryPoolFree(check_pool, block[i]);
+    }
+    BENCH_EXPECT(uxMemoryPoolGetFreeCount(check_pool) == CHECK_POOL_BLOCKS);
+    // The minimum is kept
+    BENCH_EXPECT(uxMemoryPoolGetMinimumEverFreeCount(check_pool) == 0);
+    // The last block freed is the next one allocated
+    BENCH_EXPECT(pvMemoryPoolAlloc(check_pool, 0) ==
+                 block[CHECK_POOL_BLOCKS - 1]);
+    vMemoryPoolDelete(check_pool);
+    return failures;
+}
+
+// An allocation from an empty pool waits, until the timeout or until a
+// block is freed
+static unsigned check_pool_block_empty(void)
+{
+    unsigned failures = 0;
+    TickType_t start;
+    TickType_t elapsed;
+
+    check_pool = xMemoryPoolCreate(1, CHECK_POOL_BLOCK_SIZE);
+    check_pool_block = pvMemoryPoolAlloc(check_pool, 0);
+    start = xTaskGetTickCount();
+    BENCH_EXPECT(pvMemoryPoolAlloc(check_pool, 20) == NULL);
+    elapsed = xTaskGetTickCount() - start;
+    BENCH_EXPECT(elapsed >= 20);
+    BENCH_EXPECT(elapsed < 20 + CHECK_SLACK_TICKS);
+
+    bench_task_create(check_pool_free_task, NULL, BENCH_PRIORITY_LOW);
+    start = xTaskGetTickCount();
+    BENCH_EXPECT(pvMemoryPoolAlloc(check_pool, 1000) == check_pool_block);
+    BENCH_EXPECT(xTaskGetTickCount() - start < CHECK_SLACK_TICKS);
+    BENCH_EXPECT(uxMemoryPoolGetFreeCount(check_pool) == 0);
+    bench_cleanup();
+    vMemoryPoolDelete(check_pool);
+    return failures;
+}
+
+// A block freed from an interrupt wakes the waiting task, an interrupt
+// allocates only when a block is free
+static unsigned check_pool_isr(void)
+{
+    unsigned failures = 0;
+
+    check_pool = xMemoryPoolCreate(1, CHECK_POOL_BLOCK_SIZE);
+    check_pool_block = pvMemoryPoolAlloc(check_pool, 0);
+    check_pool_isr_block = check_pool_block;
+    bench_tick_hook = check_pool_free_from_isr;
+    BENCH_EXPECT(pvMemoryPoolAlloc(check_pool, CHECK_SLACK_TICKS) ==
+                 check_pool_block);
+    BENCH_EXPECT(check_pool_isr_block == NULL);
+    BENCH_EXPECT(bench_tick_hook == NULL);
+
+    vMemoryPoolFree(check_pool, check_pool_block);
+    bench_tick_hook = check_pool_alloc_from_isr;
+    for(int i = 0; i < CHECK_SLACK_TICKS && bench_tick_hook != NULL; i++)
+    {
+        vTaskDelay(1);
+    }
+    BENCH_EXPECT(check_pool_isr_block == check_pool_block);
+    BENCH_EXPECT(uxMemoryPoolGetFreeCount(check_pool) == 0);
+    BENCH_EXPECT(uxMemoryPoolGetMinimumEverFreeCount(check_pool) == 0);
+    bench_tick_hook = NULL;
+    vMemoryPoolDelete(check_pool);
+    return failures;
+}
+
+/*-----------------------------------------------------------*/
+
+const bench_check_t bench_checks[] =
+{
+    { "fragment_message", "xMessageBufferSendFragments, one length prefix",
+      check_fragment_message },
+    { "fragment_partial", "xStreamBufferSendFragments partial fit and timeout",
+      check_fragment_partial },
+    { "fragment_isr", "xStreamBufferSendFragmentsFromISR to a blocked reader",
+      check_fragment_isr },
+    { "idle_timeout", "xStreamBufferSetIdleTimeout below the trigger level",
+      check_idle_timeout },
+    { "idle_failed_send", "empty sends do not restart the idle gap",
+      check_idle_failed_send },
+    { "heap_alloc_free", "pvPortMalloc and vPortFree heap statistics",
+      check_heap_alloc_free },
+    { "heap_split_merge", "holes are split and freed neighbours merged",
+      check_heap_split_merge },
+    { "heap_fragmentation", "every other block freed",
+      check_heap_fragmentation },
+    { "pool_alloc_free", "pvMemoryPoolAlloc and vMemoryPoolFree, counts",
+      check_pool_alloc_free },
+    { "pool_block_empty", "pvMemoryPoolAlloc waits on an empty pool",
+      check_pool_block_empty },
+    { "pool_isr", "pvMemoryPoolAllocFromISR and vMemoryPoolFreeFromISR",
+      check_pool_isr },
+    { NULL, NULL, NULL }
+};
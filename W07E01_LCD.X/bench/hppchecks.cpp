@@ -0,0 +1,163 @@
+/*
+ * File:   hppchecks.cpp
+ * Author: Nevil Sandaradura
+ * Email: npsand@utu.fi
+ * Device:  Linux host
+ *
+ * Functional checks of the C++ wrappers in freertos.hpp, run with
+ * kernelbench -c (make check) after the checks in checks.c. Every object is
+ * created and destroyed twice at the same address, so a kernel object that
+ * its destructor left behind would show up the second time.
+ *
+ * Created on October 19, 2026
+ */
+
+#include <stdint.h>
+#include <new>
+// FreeRTOS
+#include "freertos.hpp"
+
+#include "bench.h"
+
+extern "C" void hpp_counter_task(void *param);
+
+// The Task objects hold their stacks, too big for the stack of the check
+typedef freertos::Task< configMINIMAL_STACK_SIZE, BENCH_PRIORITY_HIGH,
+                        hpp_counter_task > hpp_counter_t;
+
+static volatile unsigned hpp_count;
+alignas(hpp_counter_t) static uint8_t hpp_task_storage[sizeof(hpp_counter_t)];
+
+/*-----------------------------------------------------------*/
+// Helpers
+
+// Counts the timer expiries in the unsigned its ID points to
+static void hpp_timer_callback(TimerHandle_t timer)
+{
+    (*static_cast<volatile unsigned *>(pvTimerGetTimerID(timer)))++;
+}
+
+// Counts the notifications it takes
+void hpp_counter_task(void *param)
+{
+    for(;;)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        hpp_count++;
+    }
+}
+
+/*-----------------------------------------------------------*/
+// Checks
+
+// Items come out in order, a full queue refuses more and a mailbox keeps
+// the last item
+static unsigned check_hpp_queue(void)
+{
+    unsigned failures = 0;
+
+    for(int round = 0; round < 2; round++)
+    {
+        freertos::Queue< uint32_t, 4 > queue;
+        freertos::Queue< uint32_t, 1 > mailbox;
+        uint32_t item = 0;
+
+        for(uint32_t i = 1; i <= 4; i++)
+        {
+            BENCH_EXPECT(queue.send(i));
+        }
+        BENCH_EXPECT(queue.spaces() == 0);
+        BENCH_EXPECT(!queue.send(5));
+        BENCH_EXPECT(!queue.sendToFront(0));
+        for(uint32_t i = 1; i <= 4; i++)
+        {
+            BENCH_EXPECT(queue.receive(item, 0) && item == i);
+        }
+        BENCH_EXPECT(!queue.receive(item, 0));
+
+        mailbox.overwrite(1);
+        mailbox.overwrite(2);
+        BENCH_EXPECT(mailbox.waiting() == 1);
+        BENCH_EXPECT(mailbox.peek(item) && item == 2);
+        BENCH_EXPECT(mailbox.waiting() == 1);
+    }
+    return failures;
+}
+
+// One-shot and auto-reload timers expire as often as they should, and a
+// running timer can be destroyed
+static unsigned check_hpp_timer(void)
+{
+    unsigned failures = 0;
+
+    for(int round = 0; round < 2; round++)
+    {
+        volatile unsigned once = 0;
+        volatile unsigned periodic = 0;
+        freertos::Timer< 5, false, hpp_timer_callback >
+            one_shot("once", const_cast<unsigned *>(&once));
+        freertos::Timer< 2, true, hpp_timer_callback >
+            reload("reload", const_cast<unsigned *>(&periodic));
+
+        BENCH_EXPECT(!one_shot.isActive());
+        BENCH_EXPECT(one_shot.start());
+        BENCH_EXPECT(reload.start());
+        vTaskDelay(21);
+        BENCH_EXPECT(once == 1);
+        BENCH_EXPECT(!one_shot.isActive());
+        BENCH_EXPECT(periodic >= 5);
+        BENCH_EXPECT(periodic <= 11);
+        // The auto-reload timer is still running when it is destroyed
+        BENCH_EXPECT(reload.isActive());
+        // A notification of the application must survive the destructors
+        xTaskNotifyGive(xTaskGetCurrentTaskHandle());
+    }
+    // Given twice, the destructors did not wait on index 0
+    BENCH_EXPECT(ulTaskNotifyTake(pdTRUE, 0) == 2);
+    return failures;
+}
+
+// The task runs on notifications, stops while suspended and is deleted
+// with its object
+static unsigned check_hpp_task(void)
+{
+    unsigned failures = 0;
+    UBaseType_t tasks = uxTaskGetNumberOfTasks();
+
+    for(int round = 0; round < 2; round++)
+    {
+        hpp_counter_t *counter = new (hpp_task_storage) hpp_counter_t("count");
+
+        hpp_count = 0;
+        // Higher priority, it counts before notifyGive() returns
+        counter->notifyGive();
+        counter->notifyGive();
+        BENCH_EXPECT(hpp_count == 2);
+        BENCH_EXPECT(counter->notify(0, eIncrement));
+        BENCH_EXPECT(hpp_count == 3);
+
+        counter->suspend();
+        counter->notifyGive();
+        BENCH_EXPECT(hpp_count == 3);
+        counter->resume();
+        BENCH_EXPECT(hpp_count == 4);
+
+        BENCH_EXPECT(uxTaskGetNumberOfTasks() == tasks + 1);
+        counter->~hpp_counter_t();
+        BENCH_EXPECT(uxTaskGetNumberOfTasks() == tasks);
+    }
+    return failures;
+}
+
+/*-----------------------------------------------------------*/
+
+extern "C" const bench_check_t bench_hpp_checks[] =
+{
+    { "hpp_queue", "freertos::Queue send, receive, overwrite, destructor",
+      check_hpp_queue },
+    { "hpp_timer", "freertos::Timer one-shot, auto-reload, destructor",
+      check_hpp_timer },
+    { "hpp_task", "freertos::Task notify, suspend, resume, destructor",
+      check_hpp_task },
+    { NULL, NULL, NULL }
+};
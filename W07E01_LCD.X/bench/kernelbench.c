@@ -0,0 +1,473 @@
+/*
+ * File:   kernelbench.c
+ * Author: Nevil Sandaradura
+ * Email: npsand@utu.fi
+ * Device:  Linux host
+ *
+ * Runs the kernel micro-benchmarks on the FreeRTOS Posix port, writes the
+ * results as CSV and compares them with a baseline.
+ *
+ * Usage: kernelbench [-o results.csv] [-b baseline.csv] [-t percent]
+ *                    [-r rounds] [-s scale] [-f filter] [-l] [-c]
+ *
+ *   -o  CSV output file
+ *   -b  baseline CSV, a benchmark that is more than the threshold slower
+ *       than its baseline fails the run (exit status 1)
+ *   -t  threshold in percent, 50 by default
+ *   -r  measured rounds per benchmark, the median is reported, 7 by default
+ *   -s  scales the iterations of every round, 1.0 by default
+ *   -f  runs only the benchmarks whose name contains the filter
+ *   -l  lists the benchmarks and the checks
+ *   -c  runs the functional checks instead of the benchmarks, any failed
+ *       check fails the run (exit status 1). -f filters them too
+ *
+ * CSV columns: benchmark, operation, iterations, ns_per_op, mb_per_s,
+ * baseline_ns_per_op, limit_ns_per_op, result. A results file can be used
+ * as the baseline of later runs.
+ *
+ * All threads are pinned to one CPU, which is what the Posix port uses at
+ * a time anyway, so the numbers do not depend on thread migration.
+ *
+ * Created on October 19, 2026
+ */
+
+#define _GNU_SOURCE
+#include <sched.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+// FreeRTOS
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "bench.h"
+
+#define BENCH_ROUNDS_MAX 31
+#define BENCH_HELPERS_MAX 40
+#define BENCH_BASELINE_MAX 64
+#define BENCH_NAME_LEN 48
+
+typedef struct
+{
+    char name[BENCH_NAME_LEN];
+    double ns_per_op;
+} baseline_t;
+
+TaskHandle_t bench_task;
+void (*volatile bench_tick_hook)(void);
+
+// Benchmark tables, each ends with an entry without a name
+static const benchmark_t *const suites[] =
+{
+    bench_kernel,
+    NULL
+};
+
+// Check tables, each ends with an entry without a name
+static const bench_check_t *const check_suites[] =
+{
+    bench_checks,
+    bench_hpp_checks,
+    NULL
+};
+
+static TaskHandle_t helpers[BENCH_HELPERS_MAX];
+static uint8_t helper_count;
+
+static const char *output_path;
+static const char *baseline_path;
+static const char *filter;
+static uint8_t run_checks;
+static double threshold = 50.0;
+static unsigned rounds = 7;
+static double scale = 1.0;
+static baseline_t baseline[BENCH_BASELINE_MAX];
+static unsigned baseline_count;
+
+/*-----------------------------------------------------------*/
+
+uint64_t bench_now_ns(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000u + now.tv_nsec;
+}
+
+TaskHandle_t bench_task_create(TaskFunction_t code, void *param,
+                               UBaseType_t priority)
+{
+    TaskHandle_t task = NULL;
+
+    configASSERT(helper_count < BENCH_HELPERS_MAX);
+    xTaskCreate(code, "helper", configMINIMAL_STACK_SIZE, param, priority,
+                &task);
+    configASSERT(task != NULL);
+    helpers[helper_count++] = task;
+    return task;
+}
+
+void bench_cleanup(void)
+{
+    if(helper_count == 0)
+    {
+        return;
+    }
+    while(helper_count > 0)
+    {
+        vTaskDelete(helpers[--helper_count]);
+    }
+    // Idle task frees the deleted tasks
+    vTaskDelay(2);
+}
+
+// Static allocation is on for freertos.hpp, the kernel tasks use these
+void vApplicationGetIdleTaskMemory(StaticTask_t **tcb, StackType_t **stack,
+                                   uint32_t *stack_size)
+{
+    static StaticTask_t idle_tcb;
+    static StackType_t idle_stack[configMINIMAL_STACK_SIZE];
+
+    *tcb = &idle_tcb;
+    *stack = idle_stack;
+    *stack_size = configMINIMAL_STACK_SIZE;
+}
+
+void vApplicationGetTimerTaskMemory(StaticTask_t **tcb, StackType_t **stack,
+                                    uint32_t *stack_size)
+{
+    static StaticTask_t timer_tcb;
+    static StackType_t timer_stack[configTIMER_TASK_STACK_DEPTH];
+
+    *tcb = &timer_tcb;
+    *stack = timer_stack;
+    *stack_size = configTIMER_TASK_STACK_DEPTH;
+}
+
+void vApplicationTickHook(void)
+{
+    void (*hook)(void) = bench_tick_hook;
+
+    if(hook != NULL)
+    {
+        hook();
+    }
+}
+
+unsigned bench_expect(int ok, const char *expression, const char *file,
+                      int line)
+{
+    if(ok)
+    {
+        return 0;
+    }
+    printf("    %s:%d: expected %s\n", file, line, expression);
+    return 1;
+}
+
+void bench_assert(const char *file, int line)
+{
+    fprintf(stderr, "kernelbench: assertion failed at %s:%d\n", file, line);
+    fflush(NULL);
+    _exit(2);
+}
+
+/*-----------------------------------------------------------*/
+
+static void load_baseline(const char *path)
+{
+    FILE *file = fopen(path, "r");
+    char line[256];
+
+    if(file == NULL)
+    {
+        perror(path);
+        exit(1);
+    }
+    while(fgets(line, sizeof(line), file) != NULL &&
+          baseline_count < BENCH_BASELINE_MAX)
+    {
+        char *name = strtok(line, ",");
+        char *field = NULL;
+        uint8_t column;
+
+        // ns_per_op is the fourth column
+        for(column = 1; column < 4 && name != NULL; column++)
+        {
+            field = strtok(NULL, ",");
+        }
+        if(name == NULL || field == NULL || strcmp(name, "benchmark") == 0)
+        {
+            continue;
+        }
+        snprintf(baseline[baseline_count].name, BENCH_NAME_LEN, "%s", name);
+        baseline[baseline_count].ns_per_op = strtod(field, NULL);
+        baseline_count++;
+    }
+    fclose(file);
+}
+
+static const baseline_t *find_baseline(const char *name)
+{
+    for(unsigned i = 0; i < baseline_count; i++)
+    {
+        if(strcmp(baseline[i].name, name) == 0)
+        {
+            return &baseline[i];
+        }
+    }
+    return NULL;
+}
+
+static int compare_double(const void *a, const void *b)
+{
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+
+    return x < y ? -1 : (x > y ? 1 : 0);
+}
+
+// Median of the rounds after one warm-up round
+static double measure(const benchmark_t *benchmark, uint32_t iterations)
+{
+    double results[BENCH_ROUNDS_MAX];
+
+    benchmark->run(iterations);
+    bench_cleanup();
+    for(unsigned i = 0; i < rounds; i++)
+    {
+        results[i] = benchmark->run(iterations);
+        bench_cleanup();
+    }
+    qsort(results, rounds, sizeof(double), compare_double);
+    return results[rounds / 2];
+}
+
+static void check_main(void)
+{
+    unsigned failed = 0;
+
+    for(unsigned s = 0; check_suites[s] != NULL; s++)
+    {
+        for(const bench_check_t *c = check_suites[s]; c->name != NULL; c++)
+        {
+            unsigned failures;
+
+            if(filter != NULL && strstr(c->name, filter) == NULL)
+            {
+                continue;
+            }
+            printf("%-24s %s\n", c->name, c->feature);
+            fflush(stdout);
+            failures = c->run();
+            bench_cleanup();
+            printf("%-24s %s\n", c->name, failures > 0 ? "FAILED" : "ok");
+            fflush(stdout);
+            if(failures > 0)
+            {
+                failed++;
+            }
+        }
+    }
+    if(failed > 0)
+    {
+        printf("%u checks failed\n", failed);
+    }
+    else
+    {
+        printf("All checks passed\n");
+    }
+    fflush(stdout);
+    _exit(failed > 0 ? 1 : 0);
+}
+
+static void bench_main(void *param)
+{
+    FILE *output = NULL;
+    unsigned regressions = 0;
+
+    bench_task = xTaskGetCurrentTaskHandle();
+    if(run_checks)
+    {
+        check_main();
+    }
+    if(output_path != NULL)
+    {
+        output = fopen(output_path, "w");
+        if(output == NULL)
+        {
+            perror(output_path);
+            _exit(1);
+        }
+        fprintf(output, "benchmark,operation,iterations,ns_per_op,mb_per_s,"
+                "baseline_ns_per_op,limit_ns_per_op,result\n");
+    }
+    printf("%-24s %12s %10s %12s  %s\n", "benchmark", "ns/op", "MB/s",
+           "baseline", "result");
+
+    for(unsigned s = 0; suites[s] != NULL; s++)
+    {
+        for(const benchmark_t *b = suites[s]; b->name != NULL; b++)
+        {
+            uint32_t iterations = (uint32_t)(b->iterations * scale);
+            const baseline_t *base = find_baseline(b->name);
+            double limit = 0.0;
+            double mb_per_s = 0.0;
+            const char *result = "new";
+            double ns;
+
+            if(filter != NULL && strstr(b->name, filter) == NULL)
+            {
+                continue;
+            }
+            // Even, the timer benchmark sends commands in pairs
+            iterations = iterations < 2 ? 2 : iterations & ~1u;
+            ns = measure(b, iterations);
+            if(b->bytes > 0)
+            {
+                mb_per_s = b->bytes * 1000.0 / ns;
+            }
+            if(base != NULL)
+            {
+                limit = base->ns_per_op * (1.0 + threshold / 100.0);
+                if(ns > limit)
+                {
+                    result = "regressed";
+                    regressions++;
+                }
+                else
+                {
+                    result = "ok";
+                }
+            }
+
+            printf("%-24s %12.1f ", b->name, ns);
+            if(b->bytes > 0)
+            {
+                printf("%10.1f ", mb_per_s);
+            }
+            else
+            {
+                printf("%10s ", "");
+            }
+            if(base != NULL)
+            {
+                printf("%12.1f  %s\n", base->ns_per_op, result);
+            }
+            else
+            {
+                printf("%12s  %s\n", "", result);
+            }
+            fflush(stdout);
+            if(output != NULL)
+            {
+                fprintf(output, "%s,%s,%u,%.1f,", b->name, b->operation,
+                        iterations, ns);
+                if(b->bytes > 0)
+                {
+                    fprintf(output, "%.1f", mb_per_s);
+                }
+                fprintf(output, ",");
+                if(base != NULL)
+                {
+                    fprintf(output, "%.1f,%.1f", base->ns_per_op, limit);
+                }
+                else
+                {
+                    fprintf(output, ",");
+                }
+                fprintf(output, ",%s\n", result);
+            }
+        }
+    }
+
+    if(output != NULL)
+    {
+        fclose(output);
+    }
+    if(regressions > 0)
+    {
+        printf("%u benchmarks regressed more than %.0f %%\n", regressions,
+               threshold);
+    }
+    fflush(stdout);
+    // The helpers are gone, stop the scheduler with the process
+    _exit(regressions > 0 ? 1 : 0);
+}
+
+int main(int argc, char *argv[])
+{
+    cpu_set_t cpus;
+    int option;
+
+    while((option = getopt(argc, argv, "o:b:t:r:s:f:lc")) != -1)
+    {
+        switch(option)
+        {
+            case 'o':
+                output_path = optarg;
+                break;
+            case 'b':
+                baseline_path = optarg;
+                break;
+            case 't':
+                threshold = strtod(optarg, NULL);
+                break;
+            case 'r':
+                rounds = (unsigned)strtoul(optarg, NULL, 10);
+                rounds = rounds < 1 ? 1 : rounds;
+                rounds = rounds > BENCH_ROUNDS_MAX ? BENCH_ROUNDS_MAX :
+                         rounds;
+                break;
+            case 's':
+                scale = strtod(optarg, NULL);
+                break;
+            case 'f':
+                filter = optarg;
+                break;
+            case 'l':
+                for(unsigned s = 0; suites[s] != NULL; s++)
+                {
+                    for(const benchmark_t *b = suites[s]; b->name != NULL;
+                        b++)
+                    {
+                        printf("%-24s %s\n", b->name, b->operation);
+                    }
+                }
+                for(unsigned s = 0; check_suites[s] != NULL; s++)
+                {
+                    for(const bench_check_t *c = check_suites[s];
+                        c->name != NULL; c++)
+                    {
+                        printf("%-24s %s\n", c->name, c->feature);
+                    }
+                }
+                return 0;
+            case 'c':
+                run_checks = 1;
+                break;
+            default:
+                fprintf(stderr, "usage: %s [-o results.csv] "
+                        "[-b baseline.csv] [-t percent] [-r rounds] "
+                        "[-s scale] [-f filter] [-l] [-c]\n", argv[0]);
+                return 1;
+        }
+    }
+    if(baseline_path != NULL)
+    {
+        load_baseline(baseline_path);
+    }
+
+    // Threads inherit the affinity
+    CPU_ZERO(&cpus);
+    CPU_SET(sched_getcpu(), &cpus);
+    sched_setaffinity(0, sizeof(cpus), &cpus);
+
+    xTaskCreate(bench_main, "bench", configMINIMAL_STACK_SIZE, NULL,
+                BENCH_PRIORITY, NULL);
+    vTaskStartScheduler();
+    return 1;
+}
@@ -14,12 +14,18 @@
 #include <string.h> // To use strlen function
 // FreeRTOS
 #include "FreeRTOS.h" 
+#include "task.h" // For the notifications
 #include "timers.h" // To use timers
+#include "croutine.h" // For the co-routine build
 
 #include "lcd.h" // To use lcd fucntions
 #include "adc.h" // To access ADC values
+#include "sampler.h" // Published ADC values
 #include "display.h" // To access variables
 
+// shown_mode before the first values
+#define DISPLAY_NOTHING_SHOWN 0xFF
+
 // Scrolling text
 const char g_scrolling_text[] = "DTEK0068 Embedded Microprocessor Systems";
 
@@ -30,18 +36,41 @@ void display_task(void *param)
     
     for(;;)
     {
-        // Take mutex to access ADC readings
-        xSemaphoreTake(mutex, 100);
-        adc_results = adc_read();
+        // Sleep until the sampler publishes a new value
+        xTaskNotifyWait(0, SAMPLER_ALL_BITS, NULL, portMAX_DELAY);
+        sampler_read(&adc_results);
         xQueueOverwrite(lcd_data_queue, &adc_results);
-        // Free mutex
-        xSemaphoreGive(mutex);
-        // Small delay :)
-        vTaskDelay(pdMS_TO_TICKS(100));
     }
     vTaskDelete(NULL);
 }
 
+void display_co_routine(CoRoutineHandle_t handle, UBaseType_t index)
+{
+    // Locals do not survive blocking in a co-routine
+    static ADC_result_t adc_results;
+    static BaseType_t result;
+    // Sequence number of the values sent last
+    static UBaseType_t sent = 0;
+    static UBaseType_t sequence;
+
+    crSTART(handle);
+    for(;;)
+    {
+        // Co-routines cannot wait for a notification, the sequence number
+        // tells if the values are new
+        sequence = sampler_read(&adc_results);
+        if(sequence != sent)
+        {
+            sent = sequence;
+            // lcd_co_routine is waiting, so the queue has room
+            crQUEUE_SEND(handle, lcd_data_queue, &adc_results, 0, &result);
+        }
+        // Small delay :)
+        crDELAY(handle, pdMS_TO_TICKS(100));
+    }
+    crEND();
+}
+
 // Callback function for display timer
 // Increases display_mode until 3 and then resets it
 void display_callback()
@@ -76,14 +105,9 @@ void scroll_callback()
     }
 }
 
-void lcd_task(void *param)
+// Creates and starts the timers that change the text on the LCD
+static void display_timers_start(TickType_t ticks_to_wait)
 {
-    // Init the lcd
-    lcd_init();
-    // Set scroll direction
-    direction = 0;
-    // Sets the leftmost char
-    leftmost_char = 0;
     TimerHandle_t display_timer = xTimerCreate
           ( "Timer",
             pdMS_TO_TICKS(660), // 660ms per text
@@ -98,50 +122,125 @@ void lcd_task(void *param)
             ( void * ) 1,
             scroll_callback);
     // Start both timers
-    xTimerStart(scroll_timer, 10);
-    xTimerStart(display_timer, 10);
+    xTimerStart(scroll_timer, ticks_to_wait);
+    xTimerStart(display_timer, ticks_to_wait);
+}
+
+// Formats the ADC value selected by display_mode, which is controlled by
+// timer. Returns 0 if there is nothing to show
+static uint8_t display_format(char *text, ADC_result_t *adc_results)
+{
+    switch(display_mode)
+    {
+        case 0:
+            sprintf(text, "LDR value: %d", adc_results->ldr);
+            return 1;
+        case 1:
+            sprintf(text, "NTC value: %d", adc_results->ntc);
+            return 1;
+        case 2:
+            sprintf(text, "POT value: %d", adc_results->pot);
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+// Writes the scrolling text to the second line
+static void display_scroll(void)
+{
+    // Change LCD line
+    lcd_cursor_set(1, 0);
+    // Sets scrolling text to the right position
+    strncpy(display_scroll_text, g_scrolling_text+leftmost_char, 16);
+    // Display the text
+    lcd_write(display_scroll_text);
+}
+
+void lcd_task(void *param)
+{
+    // Init the lcd
+    lcd_init();
+    // Set scroll direction
+    direction = 0;
+    // Sets the leftmost char
+    leftmost_char = 0;
+    display_timers_start(10);
     
-    // Reserve memory for ADC readings
-    char adc_val[10];
+    // Reserve memory for ADC readings, one LCD line and the terminator
+    char adc_val[17];
     
     // Declare variable for ADC readings
     ADC_result_t adc_results;
+    // Mode of the values on the first line
+    uint8_t shown_mode = DISPLAY_NOTHING_SHOWN;
     
     for(;;)
     {
-        // Check if queue receives data
-        if(xQueueReceive(lcd_data_queue, &adc_results, 100) == pdTRUE)
+        // Check if queue receives data, the values only come when they
+        // change, so the line is also written again when the mode changes
+        if(xQueueReceive(lcd_data_queue, &adc_results, 100) == pdTRUE ||
+           (shown_mode != DISPLAY_NOTHING_SHOWN && shown_mode != display_mode))
         {
+            shown_mode = display_mode;
             // Print ADR values to LCD regarding display_mode variable
-            // which is controlled by timer
-            switch(display_mode)
+            if(display_format(adc_val, &adc_results))
             {
-                case 0:
-                    sprintf(adc_val, "LDR value: %d", adc_results.ldr);
-                    lcd_clear();
-                    lcd_write(adc_val);
-                    break;
-                case 1:
-                    sprintf(adc_val, "NTC value: %d", adc_results.ntc);
-                    lcd_clear();
-                    lcd_write(adc_val);
-                    break;
-                case 2:
-                    sprintf(adc_val, "POT value: %d", adc_results.pot);
-                    lcd_clear();
-                    lcd_write(adc_val);
-                    break;
-                default:
-                    break;
+                lcd_clear();
+                lcd_write(adc_val);
             }
         }
-        // Change LCD line
-        lcd_cursor_set(1, 0);
-        // Sets scrolling text to the right position
-        strncpy(display_scroll_text, g_scrolling_text+leftmost_char, 16);
-        // Display the text
-        lcd_write(display_scroll_text);
+        display_scroll();
     }
     // This task never ends
     vTaskDelete(NULL);
+}
+
+void lcd_co_routine(CoRoutineHandle_t handle, UBaseType_t index)
+{
+    // Locals do not survive blocking in a co-routine
+    static char adc_val[17];
+    static ADC_result_t adc_results;
+    static BaseType_t result;
+    // Mode of the values on the first line
+    static uint8_t shown_mode = DISPLAY_NOTHING_SHOWN;
+    static TickType_t clear_start;
+
+    crSTART(handle);
+    // Init the lcd, busy waits once in this build
+    lcd_init();
+    // Set scroll direction
+    direction = 0;
+    // Sets the leftmost char
+    leftmost_char = 0;
+    // The idle task must not block
+    display_timers_start(0);
+
+    for(;;)
+    {
+        // Check if queue receives data, or the mode changed like in lcd_task
+        crQUEUE_RECEIVE(handle, lcd_data_queue, &adc_results, 100, &result);
+        if(result == pdPASS ||
+           (shown_mode != DISPLAY_NOTHING_SHOWN && shown_mode != display_mode))
+        {
+            shown_mode = display_mode;
+            if(display_format(adc_val, &adc_results))
+            {
+                // Let the other co-routines run while the LCD clears. The
+                // co-routine tick count lags the kernel's while the idle
+                // task waits, so crDELAY could end early, count kernel
+                // ticks instead
+                lcd_clear_send();
+                clear_start = xTaskGetTickCount();
+                while((TickType_t)(xTaskGetTickCount() - clear_start) <
+                      LCD_CLEAR_TICKS)
+                {
+                    crDELAY(handle, 0);
+                }
+                lcd_write(adc_val);
+            }
+        }
+        display_scroll();
+    }
+    crEND();
 }
\ No newline at end of file
@@ -10,9 +10,15 @@
 #ifndef DISPLAY_H
 #define	DISPLAY_H
 
+#include "queue.h" // For QueueHandle_t
+#include "croutine.h"
+
 // Declare functions
 void display_task(void *param);
 void lcd_task(void *param);
+// Same as display_task and lcd_task, for the co-routine build
+void display_co_routine(CoRoutineHandle_t handle, UBaseType_t index);
+void lcd_co_routine(CoRoutineHandle_t handle, UBaseType_t index);
 // Declare variables
 char display_scroll_text[16];
 uint8_t display_mode;
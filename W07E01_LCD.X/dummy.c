@@ -13,33 +13,62 @@
 #include <avr/io.h> 
 // FreeRTOS
 #include "FreeRTOS.h" 
+#include "task.h" // For the notifications
+#include "croutine.h" // For the co-routine build
 
 #include "adc.h" // To get POT and NTC values
+#include "sampler.h" // Published values
+
+// LED rule, blinks PF5 while NTC is above POT
+static void dummy_led_update(ADC_result_t *adc_result)
+{
+    if(adc_result->ntc > adc_result->pot)
+    {
+        // Toggle PF5
+        PORTF.OUTTGL = PIN5_bm;
+    }
+    else
+    {   // SET PF5 low
+        PORTF.OUTSET = PIN5_bm;
+    }
+}
 
 void dummy_task(void *param)
 {
+    ADC_result_t adc_result;
+
     // Set PF5 as output
     PORTF.DIRSET = PIN5_bm;
 
     for(;;)
     {
-        // Take mutex, get adc values and free mutex...
-        xSemaphoreTake(mutex, 100);
-        ADC_result_t adc_result = adc_read();
-        xSemaphoreGive(mutex);
-        
-        if(adc_result.ntc > adc_result.pot)
-        {
-            // Toggle PF5
-            PORTF.OUTTGL = PIN5_bm;
-        }
-        else
-        {   // SET PF5 low
-            PORTF.OUTSET = PIN5_bm;
-        }
-        // wait 100ms
-        vTaskDelay(pdMS_TO_TICKS(100));
+        sampler_read(&adc_result);
+        dummy_led_update(&adc_result);
+        // Blinking needs the 100ms period, otherwise only a new NTC or
+        // POT value can change the LED
+        xTaskNotifyWait(0, SAMPLER_ALL_BITS, NULL,
+                        adc_result.ntc > adc_result.pot ?
+                        pdMS_TO_TICKS(100) : portMAX_DELAY);
     }
     // This task runs infinitely
     vTaskDelete(NULL);
+}
+
+void dummy_co_routine(CoRoutineHandle_t handle, UBaseType_t index)
+{
+    ADC_result_t adc_result;
+
+    crSTART(handle);
+    // Set PF5 as output
+    PORTF.DIRSET = PIN5_bm;
+
+    for(;;)
+    {
+        // Reading the published values does not block
+        sampler_read(&adc_result);
+        dummy_led_update(&adc_result);
+        // wait 100ms
+        crDELAY(handle, pdMS_TO_TICKS(100));
+    }
+    crEND();
 }
\ No newline at end of file
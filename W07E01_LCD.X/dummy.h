@@ -10,6 +10,10 @@
 #ifndef DUMMY_H
 #define	DUMMY_H
 
+#include "croutine.h"
+
 void dummy_task(void *param);
+// Same as dummy_task, for the co-routine build
+void dummy_co_routine(CoRoutineHandle_t handle, UBaseType_t index);
 
 #endif	/* DUMMY_H */
@@ -0,0 +1,37 @@
+/*
+ * File:   heapstats.c
+ * Author: Nevil Sandaradura
+ * Email: npsand@utu.fi
+ * Device:  ATmega4809 Curiosity Nano
+ * 
+ * Prints FreeRTOS heap statistics to the serial terminal via USART0.
+ * Minimum ever free bytes tells how much of configTOTAL_HEAP_SIZE is
+ * actually needed, failed allocations tell if the heap is too small.
+ * 
+ * Created on October 19, 2026
+ */
+
+#include <stdio.h>
+// FreeRTOS
+#include "FreeRTOS.h" 
+
+#include "heapstats.h"
+
+#if HEAP_STATS_INTERVAL_S > 0
+void heap_stats_print(void)
+{
+    HeapStats_t stats;
+    
+    vPortGetHeapStats(&stats);
+    // size_t is 16 bits wide, so %u is enough
+    printf("HEAP free: %u\tmin: %u\tlargest: %u\tblocks: %u\r\n",
+           (unsigned int)stats.xAvailableHeapSpaceInBytes,
+           (unsigned int)stats.xMinimumEverFreeBytesRemaining,
+           (unsigned int)stats.xSizeOfLargestFreeBlockInBytes,
+           (unsigned int)stats.xNumberOfFreeBlocks);
+    printf("HEAP allocs: %u\tfrees: %u\tfailed: %u\r\n",
+           (unsigned int)stats.xNumberOfSuccessfulAllocations,
+           (unsigned int)stats.xNumberOfSuccessfulFrees,
+           (unsigned int)stats.xNumberOfFailedAllocations);
+}
+#endif
@@ -0,0 +1,26 @@
+/* 
+ * File:   heapstats.h
+ * Author: Nevil Sandaradura
+ * Email: npsand@utu.fi
+ * Device:  ATmega4809 Curiosity Nano
+ * 
+ * Created on October 19, 2026
+ */
+
+#ifndef HEAPSTATS_H
+#define	HEAPSTATS_H
+
+// Seconds between heap statistics dumps on USART0, 0 disables the dump.
+// Only with APP_DIAGNOSTICS by default, see FreeRTOSConfig.h
+#ifndef HEAP_STATS_INTERVAL_S
+#if APP_DIAGNOSTICS == 1
+#define HEAP_STATS_INTERVAL_S 10
+#else
+#define HEAP_STATS_INTERVAL_S 0
+#endif
+#endif
+
+// Declaring functions
+void heap_stats_print(void);
+
+#endif	/* HEAPSTATS_H */
@@ -91,6 +91,18 @@
     LCD_ENABLE_PULSE();         \
     LCD_CMD_DELAY();            \
 }
+/*
+ * LCD_WAIT_MS - Long waits of the initialisation and clear
+ *      Blocks the calling task. Co-routines run in the idle task, which must
+ *      never block, so the co-routine build busy waits instead.
+ */
+#if APP_CO_ROUTINES == 1
+#define LCD_WAIT_MS(ms)                 _delay_ms(ms)
+#else
+// The first tick can come right away, so one more tick guarantees the
+// full time
+#define LCD_WAIT_MS(ms)                 vTaskDelay(pdMS_TO_TICKS(ms) + 1)
+#endif
 
 
 /******************************************************************************
@@ -129,12 +141,18 @@ void lcd_cursor_set(uint8_t x, uint8_t y)
 }
 
 
-void lcd_clear(void)
+void lcd_clear_send(void)
 {
     // Send "clear screen" command
     LCD_CMD_SEND(0b00000001);
+}
+
+
+void lcd_clear(void)
+{
+    lcd_clear_send();
     // Wait until clear is completed (>1,52 ms)
-    vTaskDelay(pdMS_TO_TICKS(2));
+    LCD_WAIT_MS(2);
 }
 
 /*
@@ -162,7 +180,7 @@ void lcd_init(void)
     /*
      * Display will be busy for 40 ms after Vcc has stabilized > 4.5 V
      */
-    vTaskDelay(pdMS_TO_TICKS(100));
+    LCD_WAIT_MS(100);
 
     /*
      * 1) Function set
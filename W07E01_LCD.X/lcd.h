@@ -12,6 +12,8 @@
 
 #define LCD_LINE0       0
 #define LCD_LINE1       1
+// Clear takes > 1,52 ms, one more tick as the first can come right away
+#define LCD_CLEAR_TICKS (pdMS_TO_TICKS(2) + 1)
 
 
 #ifdef	__cplusplus
@@ -48,6 +50,14 @@ void lcd_cursor_set(uint8_t x, uint8_t y);
  */
 void lcd_clear(void);
 
+/*
+ * lcd_clear_send()
+ *
+ *      Sends the clear command without waiting, for callers that must not
+ *      block. Wait LCD_CLEAR_TICKS before the next command.
+ */
+void lcd_clear_send(void);
+
 
 
 #ifdef	__cplusplus
@@ -8,7 +8,14 @@
  * This program display text and values on the LCD display.
  * Values that are on the LCD are from LDR, POT and NTC.
  * LCD backlight is adjustet using LDR value. LCD backlight turns off
- * automatically after 10 seconds if potentiometer value stays exactly same!
+ * automatically after 10 seconds if the potentiometer is not turned!
+ * 
+ * The sampler task converts the ADC channels only as often as they change
+ * and wakes the other tasks when a value they use changes, see sampler.h.
+ * 
+ * With APP_CO_ROUTINES set to 1 in FreeRTOSConfig.h the display refresh,
+ * serial telemetry and LED rule run as co-routines in the idle task, which
+ * saves their stacks and task control blocks.
  * 
  * Created on December 9, 2021, 4:20 PM
  */
@@ -17,12 +24,15 @@
 #include <avr/io.h> 
 // FreeRTOS
 #include "FreeRTOS.h" 
+#include "croutine.h"
 // Including files to use spesific functions and create tasks
 #include "adc.h"
+#include "sampler.h"
 #include "uart.h"
 #include "dummy.h"
 #include "display.h"
 #include "backlight.h"
+#include "portbench.h"
 
 // Initialize TCB3
 void TCB3_init (void)
@@ -37,15 +47,26 @@ void TCB3_init (void)
     TCB3.CTRLB |= TCB_CNTMODE_PWM8_gc;
 }
 
+#if APP_CO_ROUTINES == 1
+// Runs the co-routines, they share the stack of the idle task. Only one of
+// them runs per call, the idle task yields to the backlight task in between
+void vApplicationIdleHook(void)
+{
+    vCoRoutineSchedule();
+}
+#endif
   
 int main(void)
 {
-    // Create mutex
-    mutex = xSemaphoreCreateMutex();
+    // Task handles for the sampler's notifications
+    TaskHandle_t handle;
+    
     // Create queue for acd data
     lcd_data_queue = xQueueCreate(1, sizeof(ADC_result_t));
     // Initialize adc
     adc_init();
+    // Initialize the published ADC values
+    sampler_init();
     // Initialize usart0
     usart0_init();
     // Initialize TCB3
@@ -54,14 +75,34 @@ int main(void)
     backlight_init();
     
     // TASKS
+    // Only task that uses the ADC. It runs above the display, LCD, USART
+    // and backlight tasks it notifies, which then see all the channels that
+    // changed at once. The dummy task runs above it and preempts it as soon
+    // as it is notified.
+    xTaskCreate( 
+        sampler_task, 
+        "sampler", 
+        configMINIMAL_STACK_SIZE, 
+        NULL, 
+        tskIDLE_PRIORITY + 1, 
+        NULL 
+    );
+#if APP_CO_ROUTINES == 1
+    // Co-routine priority 1 runs before 0 when both are ready
+    xCoRoutineCreate(display_co_routine, 0, 0);
+    xCoRoutineCreate(lcd_co_routine, 0, 0);
+    xCoRoutineCreate(usart0_co_routine, 0, 0);
+    xCoRoutineCreate(dummy_co_routine, 1, 0);
+#else
     xTaskCreate( 
         display_task, 
         "display", 
         configMINIMAL_STACK_SIZE, 
         NULL, 
         tskIDLE_PRIORITY, 
-        NULL 
+        &handle 
     );
+    sampler_subscribe(handle, SAMPLER_ALL_BITS);
     
     xTaskCreate( 
         lcd_task, 
@@ -80,6 +121,7 @@ int main(void)
         tskIDLE_PRIORITY, 
         NULL 
     ); 
+#endif
    
         xTaskCreate( 
         backlight_task, 
@@ -87,16 +129,24 @@ int main(void)
         configMINIMAL_STACK_SIZE, 
         NULL, 
         tskIDLE_PRIORITY, 
-        NULL 
+        &handle 
     );    
+    sampler_subscribe(handle, SAMPLER_BIT(ADC_LDR) | SAMPLER_BIT(ADC_POT));
+#if APP_CO_ROUTINES == 0
        xTaskCreate( 
         dummy_task, 
         "dummy", 
         configMINIMAL_STACK_SIZE, 
         NULL, 
         (configMAX_PRIORITIES - 1), // Priority 10, higher than other tasks
-        NULL 
+        &handle 
     ); 
+    sampler_subscribe(handle, SAMPLER_BIT(ADC_NTC) | SAMPLER_BIT(ADC_POT));
+#endif
+#if PORT_BENCH_ENABLE == 1
+    // Context switch benchmark, prints its results once
+    port_bench_create();
+#endif
        
     // Start the scheduler 
     vTaskStartScheduler(); 
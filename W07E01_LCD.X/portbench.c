@@ -0,0 +1,147 @@
+/*
+ * File:   portbench.c
+ * Author: Nevil Sandaradura
+ * Email: npsand@utu.fi
+ * Device:  ATmega4809 Curiosity Nano
+ * 
+ * Context switch benchmark of the FreeRTOS port, see portbench.h.
+ * 
+ * Created on October 19, 2026
+ */
+
+#include <avr/io.h>
+#include <stdio.h>
+// FreeRTOS
+#include "FreeRTOS.h"
+#include "task.h"
+#include "porthardware.h"
+
+#include "portbench.h"
+
+#ifndef TICK_TMR_READ
+#error The port benchmark needs a TCB tick timer, see configUSE_TIMER_INSTANCE
+#endif
+
+typedef struct
+{
+    uint16_t min;
+    uint16_t max;
+    uint32_t sum;
+    uint16_t count;
+} bench_result_t;
+
+static bench_result_t yield_result;
+static bench_result_t tick_result;
+// Capture of the task that yielded last
+static volatile uint16_t yield_start;
+// Cycles between two captures with nothing in between
+static uint16_t capture_overhead;
+static volatile uint8_t yield_done;
+
+// Timestamps the call with a TCB2 capture
+static uint16_t capture(void)
+{
+    EVSYS.STROBE = 1 << 0;
+    // The capture lands a few cycles after the strobe, always as many
+    while(!(TCB2.INTFLAGS & TCB_CAPT_bm))
+    {
+        ;
+    }
+    // Reading CCMP clears the flag
+    return TCB2.CCMP;
+}
+
+static void result_add(bench_result_t *result, uint16_t cycles)
+{
+    if(result->count == 0 || cycles < result->min)
+    {
+        result->min = cycles;
+    }
+    if(cycles > result->max)
+    {
+        result->max = cycles;
+    }
+    result->sum += cycles;
+    result->count++;
+}
+
+static void result_print(const char *name, bench_result_t *result)
+{
+    printf("PORT %s cycles min: %u\tavg: %u\tmax: %u\r\n", name,
+           result->min, (unsigned int)(result->sum / result->count),
+           result->max);
+}
+
+static void timer_init(void)
+{
+    // Software events on channel 0 make TCB2 copy its count to CCMP
+    EVSYS.USERTCB2 = EVSYS_CHANNEL_CHANNEL0_gc;
+    TCB2.CTRLB = TCB_CNTMODE_CAPT_gc;
+    TCB2.EVCTRL = TCB_CAPTEI_bm;
+    TCB2.CTRLA = TCB_CLKSEL_CLKDIV1_gc | TCB_ENABLE_bm;
+}
+
+// Times the switch from the other task's capture to the line after its own
+// taskYIELD(), the two tasks run the same loop at the same priority
+static void yield_loop(void)
+{
+    uint16_t cycles;
+
+    for(;;)
+    {
+        yield_start = capture();
+        taskYIELD();
+        cycles = capture() - yield_start - capture_overhead;
+        if(yield_result.count < PORT_BENCH_SAMPLES)
+        {
+            result_add(&yield_result, cycles);
+        }
+        else if(yield_done)
+        {
+            return;
+        }
+        else
+        {
+            // Tell the other task to stop after this yield
+            yield_done = 1;
+        }
+    }
+}
+
+static void yield_partner_task(void *param)
+{
+    yield_loop();
+    vTaskSuspend(NULL);
+}
+
+static void port_bench_task(void *param)
+{
+    uint16_t first;
+
+    timer_init();
+    first = capture();
+    capture_overhead = capture() - first;
+
+    // A preempted task, a timer or the dummy task between the two yields
+    // shows in the maximum only
+    xTaskCreate(yield_partner_task, "partner", configMINIMAL_STACK_SIZE, NULL,
+                configMAX_PRIORITIES - 1, NULL);
+    yield_loop();
+
+    for(uint16_t i = 0; i < PORT_BENCH_SAMPLES; i++)
+    {
+        // Wakes from the tick, the tick timer counts from the match
+        vTaskDelay(1);
+        result_add(&tick_result, TICK_TMR_READ());
+    }
+
+    result_print("yield", &yield_result);
+    result_print("tick", &tick_result);
+    vTaskSuspend(NULL);
+}
+
+void port_bench_create(void)
+{
+    xTaskCreate(port_bench_task, "portbench", configMINIMAL_STACK_SIZE, NULL,
+                configMAX_PRIORITIES - 1, NULL);
+}
@@ -0,0 +1,36 @@
+/* 
+ * File:   portbench.h
+ * Author: Nevil Sandaradura
+ * Email: npsand@utu.fi
+ * Device:  ATmega4809 Curiosity Nano
+ * 
+ * Measures the context switch of the FreeRTOS port in CPU cycles and prints
+ * the results once to USART0:
+ * 
+ *   PORT yield: taskYIELD() in one task to the next line of another task
+ *   PORT tick:  tick timer match to the task woken by the tick
+ * 
+ * The yield is timed with TCB2 capturing its count on a software event of
+ * EVSYS channel 0, the tick with the count of the tick timer, which restarts
+ * at the match. Both run from CLK_PER, so a count is a cycle. The numbers
+ * include the kernel, run time stats and trace recorder, compare them with
+ * the port's part in portmacro.h.
+ * 
+ * The benchmark tasks run at the highest priority and starve the other tasks
+ * until they are done, about PORT_BENCH_SAMPLES ticks.
+ * 
+ * Created on October 19, 2026
+ */
+
+#ifndef PORTBENCH_H
+#define	PORTBENCH_H
+
+// 1 creates the benchmark tasks in main()
+#define PORT_BENCH_ENABLE 0
+// Samples of each measurement
+#define PORT_BENCH_SAMPLES 200
+
+// Declaring functions
+void port_bench_create(void);
+
+#endif	/* PORTBENCH_H */
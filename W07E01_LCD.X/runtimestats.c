@@ -0,0 +1,92 @@
+/*
+ * File:   runtimestats.c
+ * Author: Nevil Sandaradura
+ * Email: npsand@utu.fi
+ * Device:  ATmega4809 Curiosity Nano
+ * 
+ * Sends run time stats of all tasks to the serial terminal via USART0 as a
+ * compact binary frame, see runtimestats.h for the format. Sending takes
+ * about 130 ms at 9600 baud, which is counted as run time of the calling
+ * task.
+ * 
+ * Created on October 19, 2026
+ */
+
+#include <stdint.h>
+// FreeRTOS
+#include "FreeRTOS.h" 
+#include "task.h"
+
+#include "uart.h" // To send bytes
+#include "runtimestats.h"
+
+#if RUN_TIME_STATS_INTERVAL_S > 0
+
+#if configGENERATE_RUN_TIME_STATS != 1 || configUSE_TRACE_FACILITY != 1
+#error The run time stats frames need configGENERATE_RUN_TIME_STATS and configUSE_TRACE_FACILITY
+#endif
+
+// Static so the calling task does not need the stack for it
+static TaskStatus_t task_status[RUN_TIME_STATS_MAX_TASKS];
+static uint8_t checksum;
+
+static void send_byte(uint8_t value)
+{
+    checksum += value;
+    usart0_send_char((char)value);
+}
+
+static void send_u16(uint16_t value)
+{
+    send_byte((uint8_t)value);
+    send_byte((uint8_t)(value >> 8));
+}
+
+static void send_u32(uint32_t value)
+{
+    send_u16((uint16_t)value);
+    send_u16((uint16_t)(value >> 16));
+}
+
+void run_time_stats_send(void)
+{
+    uint32_t total_run_time;
+    UBaseType_t task_count;
+    
+    // Returns 0 if task_status is too small
+    task_count = uxTaskGetSystemState(task_status, RUN_TIME_STATS_MAX_TASKS,
+                                      &total_run_time);
+    
+    // Sync bytes
+    usart0_send_char((char)0xA5);
+    usart0_send_char((char)0x5A);
+    
+    checksum = 0;
+    send_byte(RUN_TIME_STATS_VERSION);
+    send_byte(task_count);
+    send_u32(total_run_time);
+    
+    for(UBaseType_t i = 0; i < task_count; i++)
+    {
+        send_byte((uint8_t)task_status[i].xTaskNumber);
+        send_byte((uint8_t)task_status[i].eCurrentState);
+        send_byte((uint8_t)task_status[i].uxCurrentPriority);
+        send_u32(task_status[i].ulRunTimeCounter);
+        send_u16(task_status[i].usStackHighWaterMark);
+        
+        // Name is sent NUL padded to a fixed length
+        uint8_t end = 0;
+        for(uint8_t j = 0; j < configMAX_TASK_NAME_LEN; j++)
+        {
+            if(task_status[i].pcTaskName[j] == '\0')
+            {
+                end = 1;
+            }
+            send_byte(end ? 0 : (uint8_t)task_status[i].pcTaskName[j]);
+        }
+    }
+    
+    usart0_send_char((char)checksum);
+}
+
+#endif /* RUN_TIME_STATS_INTERVAL_S */
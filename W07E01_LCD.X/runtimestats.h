@@ -0,0 +1,47 @@
+/* 
+ * File:   runtimestats.h
+ * Author: Nevil Sandaradura
+ * Email: npsand@utu.fi
+ * Device:  ATmega4809 Curiosity Nano
+ * 
+ * Binary frame sent over USART0, multi-byte values are little endian:
+ * 
+ *   0xA5 0x5A                  sync, not part of the checksum
+ *   uint8_t  version           RUN_TIME_STATS_VERSION
+ *   uint8_t  task count
+ *   uint32_t total run time    run time stats clock counts
+ *   per task:
+ *     uint8_t  task number
+ *     uint8_t  state           eTaskState
+ *     uint8_t  priority
+ *     uint32_t run time        run time stats clock counts
+ *     uint16_t stack left      minimum ever free stack, bytes
+ *     char     name[configMAX_TASK_NAME_LEN], NUL padded
+ *   uint8_t  checksum          sum of the bytes after the sync bytes
+ * 
+ * runtimestats.py decodes the frames and prints CPU usage per task.
+ * 
+ * Created on October 19, 2026
+ */
+
+#ifndef RUNTIMESTATS_H
+#define	RUNTIMESTATS_H
+
+// Seconds between run time stats frames on USART0, 0 disables the frames.
+// Only with APP_DIAGNOSTICS by default, see FreeRTOSConfig.h
+#ifndef RUN_TIME_STATS_INTERVAL_S
+#if APP_DIAGNOSTICS == 1
+#define RUN_TIME_STATS_INTERVAL_S 5
+#else
+#define RUN_TIME_STATS_INTERVAL_S 0
+#endif
+#endif
+// Five application tasks, idle task and timer task
+#define RUN_TIME_STATS_MAX_TASKS 8
+// Frame format version
+#define RUN_TIME_STATS_VERSION 1
+
+// Declaring functions
+void run_time_stats_send(void);
+
+#endif	/* RUNTIMESTATS_H */
@@ -0,0 +1,102 @@
+#!/usr/bin/env python3
+#
+# File:   runtimestats.py
+# Author: Nevil Sandaradura
+# Email: npsand@utu.fi
+#
+# Prints per task CPU usage from the run time stats frames sent by
+# runtimestats.c. Text printed by the application on the same USART0 is
+# skipped. Reads a serial port (needs pyserial) or a file of captured bytes.
+#
+# Usage: runtimestats.py /dev/ttyACM0
+#        runtimestats.py capture.bin
+#
+# Created on October 19, 2026
+
+import struct
+import sys
+
+SYNC = b"\xa5\x5a"
+VERSION = 1
+TASK_NAME_LEN = 8  # configMAX_TASK_NAME_LEN
+TASK_FORMAT = "<BBBIH%ds" % TASK_NAME_LEN
+TASK_SIZE = struct.calcsize(TASK_FORMAT)
+STATES = ["Running", "Ready", "Blocked", "Suspend", "Deleted", "Invalid"]
+
+
+def open_input(path):
+    if path.startswith("/dev/"):
+        import serial
+        return serial.Serial(path, 9600)
+    return open(path, "rb")
+
+
+def frames(stream):
+    """Yields (total run time, tasks) for every valid frame in the stream."""
+    buffer = b""
+    while True:
+        data = stream.read(1 if hasattr(stream, "baudrate") else 4096)
+        if not data:
+            return
+        buffer += data
+        while True:
+            start = buffer.find(SYNC)
+            if start < 0:
+                buffer = buffer[-1:]
+                break
+            body = buffer[start + 2:]
+            if len(body) < 6:
+                buffer = buffer[start:]
+                break
+            version, count, total = struct.unpack_from("<BBI", body)
+            length = 6 + count * TASK_SIZE
+            if version != VERSION:
+                buffer = buffer[start + 1:]
+                continue
+            if len(body) < length + 1:
+                buffer = buffer[start:]
+                break
+            if sum(body[:length]) & 0xFF != body[length]:
+                # Sync bytes inside text or a corrupted frame
+                buffer = buffer[start + 1:]
+                continue
+            tasks = []
+            for i in range(count):
+                number, state, priority, run_time, stack, name = \
+                    struct.unpack_from(TASK_FORMAT, body, 6 + i * TASK_SIZE)
+                name = name.split(b"\0")[0].decode("ascii", "replace")
+                tasks.append((number, name, state, priority, run_time, stack))
+            buffer = body[length + 1:]
+            yield total, tasks
+
+
+def print_frame(total, tasks, previous):
+    # Counters are 32 bits wide, so differences are taken modulo 2^32
+    interval = (total - previous[0]) & 0xFFFFFFFF if previous else total
+    print("%-8s %3s %-8s %4s %6s %6s %10s" %
+          ("Task", "#", "State", "Prio", "CPU%", "Total%", "Stack left"))
+    for number, name, state, priority, run_time, stack in \
+            sorted(tasks, key=lambda task: task[0]):
+        if previous and number in previous[1]:
+            used = (run_time - previous[1][number]) & 0xFFFFFFFF
+        else:
+            used = run_time
+        print("%-8s %3d %-8s %4d %6.1f %6.1f %10d" % (
+            name, number, STATES[min(state, len(STATES) - 1)], priority,
+            100.0 * used / interval if interval else 0.0,
+            100.0 * run_time / total if total else 0.0,
+            stack))
+    print()
+
+
+def main():
+    if len(sys.argv) != 2:
+        sys.exit("usage: %s <serial port or capture file>" % sys.argv[0])
+    previous = None
+    for total, tasks in frames(open_input(sys.argv[1])):
+        print_frame(total, tasks, previous)
+        previous = (total, dict((task[0], task[4]) for task in tasks))
+
+
+if __name__ == "__main__":
+    main()
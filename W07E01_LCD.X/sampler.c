@@ -0,0 +1,226 @@
+/*
+ * File:   sampler.c
+ * Author: Nevil Sandaradura
+ * Email: npsand@utu.fi
+ * Device:  ATmega4809 Curiosity Nano
+ *
+ * Change driven sampling of the ADC channels, see sampler.h.
+ *
+ * Created on October 19, 2026
+ */
+
+#include <stdio.h> // To use printf function
+// FreeRTOS
+#include "FreeRTOS.h"
+#include "task.h"
+#include "seqlock.h" // For the published values
+
+#include "sampler.h"
+
+typedef struct
+{
+    TickType_t min_period;
+    TickType_t max_period;
+    uint16_t deadband;      // Largest change that counts as noise
+} sampler_channel_t;
+
+static const sampler_channel_t sampler_channels[ADC_CHANNELS] =
+{
+    // A hand over the LDR should dim the backlight at once
+    [ADC_LDR] = { pdMS_TO_TICKS(50), pdMS_TO_TICKS(800), 4 },
+    // The temperature changes slowly
+    [ADC_NTC] = { pdMS_TO_TICKS(200), pdMS_TO_TICKS(3200), 2 },
+    // Turning the POT switches the backlight on
+    [ADC_POT] = { pdMS_TO_TICKS(50), pdMS_TO_TICKS(800), 2 }
+};
+
+static SeqLockHandle_t sampler_lock;
+static TaskHandle_t sampler_tasks[SAMPLER_SUBSCRIBERS_MAX];
+static uint32_t sampler_task_bits[SAMPLER_SUBSCRIBERS_MAX];
+static uint8_t sampler_task_count = 0;
+
+static TickType_t sampler_periods[ADC_CHANNELS];
+// Ticks until the channel is sampled again
+static TickType_t sampler_left[ADC_CHANNELS];
+static uint16_t sampler_last[ADC_CHANNELS];
+static uint16_t sampler_published[ADC_CHANNELS];
+// Bit n set until channel n has been published once
+static uint8_t sampler_unpublished = SAMPLER_ALL_BITS;
+
+#if ADC_STATS_INTERVAL_S > 0
+// Since the last sampler_stats_print()
+static uint16_t sampler_wakeups = 0;
+static uint16_t sampler_notifications = 0;
+static TickType_t sampler_stats_start = 0;
+#endif
+
+void sampler_init(void)
+{
+    sampler_lock = xSeqLockCreate(sizeof(ADC_result_t));
+    for(uint8_t i = 0; i < ADC_CHANNELS; i++)
+    {
+        sampler_periods[i] = sampler_channels[i].min_period;
+        sampler_left[i] = 0;
+    }
+}
+
+void sampler_subscribe(TaskHandle_t task, uint32_t bits)
+{
+    if(sampler_task_count < SAMPLER_SUBSCRIBERS_MAX)
+    {
+        sampler_tasks[sampler_task_count] = task;
+        sampler_task_bits[sampler_task_count] = bits;
+        sampler_task_count++;
+    }
+}
+
+UBaseType_t sampler_read(ADC_result_t *result)
+{
+    return uxSeqLockRead(sampler_lock, result);
+}
+
+static uint16_t sampler_difference(uint16_t a, uint16_t b)
+{
+    return a > b ? a - b : b - a;
+}
+
+// Writes the published values and notifies the tasks that want a channel
+// in changed
+static void sampler_publish(uint8_t changed)
+{
+    ADC_result_t result;
+
+    result.ldr = sampler_published[ADC_LDR];
+    result.ntc = sampler_published[ADC_NTC];
+    result.pot = sampler_published[ADC_POT];
+    vSeqLockWrite(sampler_lock, &result);
+
+    for(uint8_t i = 0; i < sampler_task_count; i++)
+    {
+        if(sampler_task_bits[i] & changed)
+        {
+            xTaskNotify(sampler_tasks[i], sampler_task_bits[i] & changed,
+                        eSetBits);
+#if ADC_STATS_INTERVAL_S > 0
+            sampler_notifications++;
+#endif
+        }
+    }
+}
+
+// Converts the channels in due, adapts their periods and publishes the
+// values that changed
+static void sampler_sample(uint8_t due)
+{
+    uint8_t changed = 0;
+
+    adc_convert(due);
+    for(uint8_t i = 0; i < ADC_CHANNELS; i++)
+    {
+        const sampler_channel_t *channel = &sampler_channels[i];
+        uint16_t value;
+
+        if(!(due & (1 << i)))
+        {
+            continue;
+        }
+        value = adc_value(i);
+        // Fast while the value moves, slowing down while it stays
+        if(sampler_difference(value, sampler_last[i]) > channel->deadband)
+        {
+            sampler_periods[i] = channel->min_period;
+        }
+        else if(sampler_periods[i] <= channel->max_period / 2)
+        {
+            sampler_periods[i] *= 2;
+        }
+        else
+        {
+            sampler_periods[i] = channel->max_period;
+        }
+        sampler_last[i] = value;
+        sampler_left[i] = sampler_periods[i];
+
+        if((sampler_unpublished & (1 << i)) ||
+           sampler_difference(value, sampler_published[i]) > channel->deadband)
+        {
+            sampler_published[i] = value;
+            changed |= 1 << i;
+        }
+    }
+    if(changed)
+    {
+        sampler_unpublished &= ~changed;
+        sampler_publish(changed);
+    }
+}
+
+void sampler_task(void *param)
+{
+    TickType_t wake = xTaskGetTickCount();
+    // Every channel at the start
+    uint8_t due = SAMPLER_ALL_BITS;
+
+    for(;;)
+    {
+        TickType_t sleep = portMAX_DELAY;
+
+        sampler_sample(due);
+        // Sleep until the next channel is due
+        for(uint8_t i = 0; i < ADC_CHANNELS; i++)
+        {
+            if(sampler_left[i] < sleep)
+            {
+                sleep = sampler_left[i];
+            }
+        }
+        // Returns at once if the sampling took longer
+        vTaskDelayUntil(&wake, sleep);
+#if ADC_STATS_INTERVAL_S > 0
+        sampler_wakeups++;
+#endif
+
+        due = 0;
+        for(uint8_t i = 0; i < ADC_CHANNELS; i++)
+        {
+            sampler_left[i] -= sleep;
+            if(sampler_left[i] == 0)
+            {
+                due |= 1 << i;
+            }
+        }
+    }
+    // This task runs infinitely
+    vTaskDelete(NULL);
+}
+
+#if ADC_STATS_INTERVAL_S > 0
+void sampler_stats_print(void)
+{
+    TickType_t now = xTaskGetTickCount();
+    uint32_t elapsed_ms;
+    uint16_t wakeups;
+    uint16_t notifications;
+
+    // The sampler task has the higher priority
+    taskENTER_CRITICAL();
+    wakeups = sampler_wakeups;
+    notifications = sampler_notifications;
+    sampler_wakeups = 0;
+    sampler_notifications = 0;
+    taskEXIT_CRITICAL();
+    elapsed_ms = (uint32_t)(now - sampler_stats_start) * 1000 /
+                 configTICK_RATE_HZ;
+    sampler_stats_start = now;
+    if(elapsed_ms == 0)
+    {
+        return;
+    }
+    // Hundredths of a wake-up per second
+    printf("SAMPLER: %u.%02u wakeups/s, %u.%02u notifications/s\r\n",
+           (unsigned)(wakeups * 100000UL / elapsed_ms / 100),
+           (unsigned)(wakeups * 100000UL / elapsed_ms % 100),
+           (unsigned)(notifications * 100000UL / elapsed_ms / 100),
+           (unsigned)(notifications * 100000UL / elapsed_ms % 100));
+}
+#endif
@@ -0,0 +1,53 @@
+/*
+ * File:   sampler.h
+ * Author: Nevil Sandaradura
+ * Email: npsand@utu.fi
+ * Device:  ATmega4809 Curiosity Nano
+ *
+ * Change driven sampling of the ADC channels. The sampler task is the only
+ * one that converts. Every channel has its own period between a minimum
+ * and a maximum: it drops to the minimum when two samples in a row differ
+ * by more than the channel's deadband, and doubles after every sample that
+ * does not, so a static scene is sampled at the maximum period. The
+ * periods and the deadbands of the channels are in sampler.c.
+ *
+ * A value is published only when it differs from the last published one
+ * by more than the deadband. The published values are in a sequence lock,
+ * the subscribed tasks get a task notification with a bit per channel
+ * that changed. Co-routines cannot wait for notifications, they compare
+ * the sequence number instead.
+ *
+ * With ADC_STATS_INTERVAL_S above 0 the sampler wake-ups and the
+ * notifications per second are sent to USART0 with the ADC statistics.
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef SAMPLER_H
+#define	SAMPLER_H
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "adc.h"
+
+// At most this many tasks subscribe
+#define SAMPLER_SUBSCRIBERS_MAX 4
+// Notification bit of a channel, e.g. SAMPLER_BIT(ADC_POT)
+#define SAMPLER_BIT(channel) (1UL << (channel))
+#define SAMPLER_ALL_BITS (SAMPLER_BIT(ADC_CHANNELS) - 1)
+
+// Declaring functions
+// Creates the sequence lock, call before the scheduler starts
+void sampler_init(void);
+void sampler_task(void *param);
+// The task gets the channels in bits that changed as notification bits,
+// call before the scheduler starts
+void sampler_subscribe(TaskHandle_t task, uint32_t bits);
+// Copies the published values, returns a number that changes on every
+// publication
+UBaseType_t sampler_read(ADC_result_t *result);
+// Prints the wake-ups and notifications per second since the last call
+void sampler_stats_print(void);
+
+#endif	/* SAMPLER_H */
@@ -0,0 +1,70 @@
+/*
+ * File:   FreeRTOSConfig.h
+ * Author: Nevil Sandaradura
+ * Email: npsand@utu.fi
+ * Device:  Linux host (simulates ATmega4809 Curiosity Nano)
+ *
+ * Host simulation configuration. Uses the application configuration in
+ * ../FreeRTOSConfig.h and only changes what the Posix port needs.
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef SIM_FREERTOSCONFIG_H
+#define SIM_FREERTOSCONFIG_H
+
+#ifndef SIM_VIRTUAL_TIME
+#define SIM_VIRTUAL_TIME 0
+#endif
+
+// Timestamps use the run time stats clock of the Posix port, times()
+#define TRACE_CLOCK_HZ 100
+
+// The Posix port counts critical section nesting and enables interrupts when
+// the count returns to zero, also when the kernel had disabled them without
+// counting before the scheduler starts. The recorder saves and restores the
+// signal mask instead, like SREG on the AVR
+void sim_enter_critical(void);
+void sim_exit_critical(void);
+#define TRACE_ENTER_CRITICAL() sim_enter_critical()
+#define TRACE_EXIT_CRITICAL() sim_exit_critical()
+
+#include "../FreeRTOSConfig.h"
+
+// Tasks run in pthreads (fibers in virtual time) on their FreeRTOS stacks,
+// which must be at least PTHREAD_STACK_MIN and big enough for the host C
+// library
+#undef configMINIMAL_STACK_SIZE
+#define configMINIMAL_STACK_SIZE ((unsigned short)8192)
+#undef configTOTAL_HEAP_SIZE
+#define configTOTAL_HEAP_SIZE ((size_t)(1024 * 1024))
+
+// The Posix port still uses the old type names
+#undef configENABLE_BACKWARD_COMPATIBILITY
+#define configENABLE_BACKWARD_COMPATIBILITY 1
+
+// The Posix port always uses 32-bit ticks
+#undef configUSE_16_BIT_TICKS
+#define configUSE_16_BIT_TICKS 0
+
+// Virtual time on the fiber port, see the Makefile. The hook runs the
+// simulation steps (simmain.c)
+#define configUSE_VIRTUAL_TIME SIM_VIRTUAL_TIME
+#define configUSE_VIRTUAL_TIME_HOOK SIM_VIRTUAL_TIME
+#define configUSE_TICKLESS_IDLE SIM_VIRTUAL_TIME
+// A kernel call or context switch of the AVR port, about 250 CPU cycles
+#define configVIRTUAL_TIME_KERNEL_NS (250ull * 1000000000u / configCPU_CLOCK_HZ)
+#if APP_CO_ROUTINES == 1
+// The co-routines run in the idle hook and need every tick
+#define configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING(x) ((x) = 0)
+#endif
+
+// Report the failed assertion and stop the simulation
+void sim_assert(const char *file, int line);
+#define configASSERT(x) \
+    if((x) == 0) \
+    { \
+        sim_assert(__FILE__, __LINE__); \
+    }
+
+#endif /* SIM_FREERTOSCONFIG_H */
@@ -0,0 +1,96 @@
+#!/bin/sh
+#
+# File:   check.sh
+# Author: Nevil Sandaradura
+# Email: npsand@utu.fi
+#
+# Regression test of the W07 application on the host simulation. Runs
+# w07sim for 4 seconds with the inputs in check.txt and compares the report
+# and the USART0 output with what those inputs must give. Prints the
+# failed checks and exits with 1 if there are any. The simulation runs in
+# real time, so run it on an otherwise idle machine, or build it with
+# VIRTUAL_TIME=1 (see the Makefile) for a run that does not depend on the
+# machine.
+#
+# Usage: check.sh build/w07sim
+#
+# Created on October 19, 2026
+#
+
+SIM=${1:-./build/w07sim}
+DIR=$(dirname "$0")
+OUT=$(mktemp -d)
+trap 'rm -rf "$OUT"' EXIT
+
+if ! "$SIM" -q -t 4000 -s "$DIR/check.txt" -o "$OUT/uart.bin" \
+    > "$OUT/report.txt"
+then
+    cat "$OUT/report.txt"
+    echo "FAIL: w07sim exited with an error"
+    exit 1
+fi
+
+failures=0
+fail()
+{
+    echo "FAIL: $1"
+    failures=$((failures + 1))
+}
+value()
+{
+    sed -n "s/^$1: //p" "$OUT/report.txt"
+}
+
+# 1000 mV, 750 mV and 1650 mV against the 2.5 V reference, then 500 mV
+TAB=$(printf '\t')
+grep -aq "LDR: 409${TAB}NTC: 307${TAB}POT: 675" "$OUT/uart.bin" ||
+    fail "USART0 line before the POT change"
+grep -aq "LDR: 409${TAB}NTC: 307${TAB}POT: 204" "$OUT/uart.bin" ||
+    fail "USART0 line after the POT change"
+[ "$(value 'uart bytes')" -eq "$(wc -c < "$OUT/uart.bin")" ] ||
+    fail "uart bytes does not match the captured bytes"
+
+for ain in 8 9 14
+do
+    [ "$(value "adc ain$ain conversions")" -gt 0 ] 2>/dev/null ||
+        fail "no conversions on AIN$ain"
+done
+[ "$(value 'adc conversions')" -eq $(($(value 'adc ain8 conversions') + \
+    $(value 'adc ain9 conversions') + $(value 'adc ain14 conversions'))) ] ||
+    fail "conversions on other inputs"
+# The sampler converts a channel at most every 50 ms, and only that often
+# while it changes
+[ "$(value 'adc conversions')" -le 240 ] ||
+    fail "ADC polled, $(value 'adc conversions') conversions"
+# Every input uses the internal reference, REFSEL is never rewritten
+[ "$(value 'adc reference changes')" -eq 0 ] ||
+    fail "ADC reference changed $(value 'adc reference changes') times"
+
+[ "$(value 'lcd timing violations')" -eq 0 ] ||
+    fail "LCD written while busy"
+[ "$(value 'lcd clears')" -gt 0 ] || fail "LCD never cleared"
+value 'lcd frame 0' | grep -Eq \
+    '^\|(LDR value: 409|NTC value: 307|POT value: (675|204)) *\|$' ||
+    fail "LCD line 0: $(value 'lcd frame 0')"
+line1=$(value 'lcd frame 1' | tr -d '|')
+case "DTEK0068 Embedded Microprocessor Systems" in
+    *"$line1"*)
+        ;;
+    *)
+        fail "LCD line 1: |$line1|"
+        ;;
+esac
+
+# LED toggles every 100 ms once NTC is above POT
+[ "$(value 'led edges')" -ge 5 ] || fail "LED PF5 is not blinking"
+# TCB3 CCMP = LDR * 60, duty CCMPH / (CCMPL + 1)
+[ "$(value 'backlight duty now %')" = "43.0" ] ||
+    fail "backlight duty $(value 'backlight duty now %')"
+
+if [ "$failures" -gt 0 ]
+then
+    echo "$failures checks failed, report:"
+    cat "$OUT/report.txt"
+    exit 1
+fi
+echo "All checks passed"
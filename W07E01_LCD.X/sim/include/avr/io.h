@@ -0,0 +1,221 @@
+/*
+ * File:   io.h
+ * Author: Nevil Sandaradura
+ * Email: npsand@utu.fi
+ * Device:  Linux host (simulates ATmega4809 Curiosity Nano)
+ *
+ * Stand-in for <avr/io.h> in the host simulation. Only the registers and
+ * bit masks used by the W07 application are declared, with the same names
+ * and values as the ATmega4809 header.
+ *
+ * Peripherals that have behaviour (ADC0, USART0, PORTx/VPORTx) are reached
+ * through accessor functions in peripherals.c. Every use of the register
+ * name calls the accessor, which brings the model up to date with the
+ * previous write before handing out the registers. TCB3 and the other
+ * peripherals are plain memory.
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef SIM_AVR_IO_H
+#define	SIM_AVR_IO_H
+
+#include <stdint.h>
+
+typedef volatile uint8_t register8_t;
+typedef volatile uint16_t register16_t;
+typedef volatile uint32_t register32_t;
+
+// ADC0
+typedef struct ADC_struct
+{
+    register8_t CTRLA;
+    register8_t CTRLB;
+    register8_t CTRLC;
+    register8_t CTRLD;
+    register8_t CTRLE;
+    register8_t SAMPCTRL;
+    register8_t MUXPOS;
+    register8_t COMMAND;
+    register8_t EVCTRL;
+    register8_t INTCTRL;
+    register8_t INTFLAGS;
+    register16_t RES;
+    register16_t WINLT;
+    register16_t WINHT;
+} ADC_t;
+
+#define ADC_ENABLE_bm  0x01
+#define ADC_RESSEL_bm  0x04
+#define ADC_STCONV_bm  0x01
+#define ADC_RESRDY_bm  0x01
+#define ADC_WCMP_bm  0x02
+
+#define ADC_PRESC_gm  0x07
+#define ADC_PRESC_DIV2_gc  (0x00<<0)
+#define ADC_PRESC_DIV4_gc  (0x01<<0)
+#define ADC_PRESC_DIV8_gc  (0x02<<0)
+#define ADC_PRESC_DIV16_gc  (0x03<<0)
+#define ADC_PRESC_DIV32_gc  (0x04<<0)
+#define ADC_PRESC_DIV64_gc  (0x05<<0)
+#define ADC_PRESC_DIV128_gc  (0x06<<0)
+#define ADC_PRESC_DIV256_gc  (0x07<<0)
+#define ADC_REFSEL_gm  0x30
+#define ADC_REFSEL_INTREF_gc  (0x00<<4)
+#define ADC_REFSEL_VDDREF_gc  (0x01<<4)
+#define ADC_REFSEL_VREFA_gc  (0x02<<4)
+#define ADC_INITDLY_gm  0xE0
+#define ADC_INITDLY_DLY0_gc  (0x00<<5)
+#define ADC_INITDLY_DLY16_gc  (0x01<<5)
+#define ADC_INITDLY_DLY32_gc  (0x02<<5)
+#define ADC_INITDLY_DLY64_gc  (0x03<<5)
+#define ADC_MUXPOS_gm  0x1F
+#define ADC_MUXPOS_AIN0_gc  (0x00<<0)
+#define ADC_MUXPOS_AIN8_gc  (0x08<<0)
+#define ADC_MUXPOS_AIN9_gc  (0x09<<0)
+#define ADC_MUXPOS_AIN14_gc  (0x0E<<0)
+#define ADC_MUXPOS_AIN15_gc  (0x0F<<0)
+
+// VREF
+typedef struct VREF_struct
+{
+    register8_t CTRLA;
+    register8_t CTRLB;
+} VREF_t;
+
+#define VREF_ADC0REFSEL_gm  0x70
+#define VREF_ADC0REFSEL_0V55_gc  (0x00<<4)
+#define VREF_ADC0REFSEL_1V1_gc  (0x01<<4)
+#define VREF_ADC0REFSEL_2V5_gc  (0x02<<4)
+#define VREF_ADC0REFSEL_4V34_gc  (0x03<<4)
+#define VREF_ADC0REFSEL_1V5_gc  (0x04<<4)
+
+// PORTx and VPORTx
+typedef struct PORT_struct
+{
+    register8_t DIR;
+    register8_t DIRSET;
+    register8_t DIRCLR;
+    register8_t DIRTGL;
+    register8_t OUT;
+    register8_t OUTSET;
+    register8_t OUTCLR;
+    register8_t OUTTGL;
+    register8_t IN;
+    register8_t INTFLAGS;
+    register8_t PORTCTRL;
+    register8_t PIN0CTRL;
+    register8_t PIN1CTRL;
+    register8_t PIN2CTRL;
+    register8_t PIN3CTRL;
+    register8_t PIN4CTRL;
+    register8_t PIN5CTRL;
+    register8_t PIN6CTRL;
+    register8_t PIN7CTRL;
+} PORT_t;
+
+typedef struct VPORT_struct
+{
+    register8_t DIR;
+    register8_t OUT;
+    register8_t IN;
+    register8_t INTFLAGS;
+} VPORT_t;
+
+#define PIN0_bm  0x01
+#define PIN1_bm  0x02
+#define PIN2_bm  0x04
+#define PIN3_bm  0x08
+#define PIN4_bm  0x10
+#define PIN5_bm  0x20
+#define PIN6_bm  0x40
+#define PIN7_bm  0x80
+
+#define PORT_ISC_gm  0x07
+#define PORT_ISC_INTDISABLE_gc  (0x00<<0)
+#define PORT_ISC_INPUT_DISABLE_gc  (0x04<<0)
+#define PORT_PULLUPEN_bm  0x08
+
+// TCB, renamed by FreeRTOSConfig.h like the real header
+typedef struct TCB_struct
+{
+    register8_t CTRLA;
+    register8_t CTRLB;
+    register8_t reserved_1[2];
+    register8_t EVCTRL;
+    register8_t INTCTRL;
+    register8_t INTFLAGS;
+    register8_t STATUS;
+    register8_t DBGCTRL;
+    register8_t TEMP;
+    register16_t CNT;
+    register16_t CCMP;
+} TCB_t;
+
+#define TCB_ENABLE_bm  0x01
+#define TCB_CCMPEN_bm  0x10
+#define TCB_CAPT_bm  0x01
+
+#define TCB_CLKSEL_gm  0x06
+#define TCB_CLKSEL_CLKDIV1_gc  (0x00<<1)
+#define TCB_CLKSEL_CLKDIV2_gc  (0x01<<1)
+#define TCB_CLKSEL_CLKTCA_gc  (0x02<<1)
+#define TCB_CNTMODE_gm  0x07
+#define TCB_CNTMODE_INT_gc  (0x00<<0)
+#define TCB_CNTMODE_PWM8_gc  (0x07<<0)
+
+// USART0
+typedef struct USART_struct
+{
+    register8_t RXDATAL;
+    register8_t RXDATAH;
+    // 16 bits wide in the simulation so that an empty buffer can be told
+    // apart from any written character, see SIM_USART_EMPTY
+    register16_t TXDATAL;
+    register8_t TXDATAH;
+    register8_t STATUS;
+    register8_t CTRLA;
+    register8_t CTRLB;
+    register8_t CTRLC;
+    register16_t BAUD;
+} USART_t;
+
+#define SIM_USART_EMPTY  0x8000
+
+#define USART_DREIF_bm  0x20
+#define USART_TXCIF_bm  0x40
+#define USART_RXCIF_bm  0x80
+#define USART_TXEN_bm  0x40
+#define USART_RXEN_bm  0x80
+
+// Register models, see peripherals.c
+ADC_t *sim_adc0(void);
+USART_t *sim_usart0(void);
+PORT_t *sim_port(uint8_t port);
+VPORT_t *sim_vport(uint8_t port);
+
+extern VREF_t sim_vref;
+extern TCB_t sim_tcb[4];
+
+#define ADC0  (*sim_adc0())
+#define USART0  (*sim_usart0())
+#define VREF  sim_vref
+#define TCB0  sim_tcb[0]
+#define TCB1  sim_tcb[1]
+#define TCB2  sim_tcb[2]
+#define TCB3  sim_tcb[3]
+
+#define PORTA  (*sim_port(0))
+#define PORTB  (*sim_port(1))
+#define PORTC  (*sim_port(2))
+#define PORTD  (*sim_port(3))
+#define PORTE  (*sim_port(4))
+#define PORTF  (*sim_port(5))
+#define VPORTA  (*sim_vport(0))
+#define VPORTB  (*sim_vport(1))
+#define VPORTC  (*sim_vport(2))
+#define VPORTD  (*sim_vport(3))
+#define VPORTE  (*sim_vport(4))
+#define VPORTF  (*sim_vport(5))
+
+#endif	/* SIM_AVR_IO_H */
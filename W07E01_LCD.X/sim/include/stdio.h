@@ -0,0 +1,39 @@
+/*
+ * File:   stdio.h
+ * Author: Nevil Sandaradura
+ * Email: npsand@utu.fi
+ * Device:  Linux host (simulates ATmega4809 Curiosity Nano)
+ *
+ * Wraps the host <stdio.h>. When SIM_AVR_STDIO is defined (application
+ * sources only), stdout and printf() behave like avr-libc: output goes to
+ * the put function of the stream set up with FDEV_SETUP_STREAM(), and
+ * nothing is printed until stdout has been assigned.
+ *
+ * Created on October 19, 2026
+ */
+
+#include_next <stdio.h>
+
+#if defined(SIM_AVR_STDIO) && !defined(SIM_STDIO_H)
+#define	SIM_STDIO_H
+
+typedef struct sim_file
+{
+    int (*put)(char c, struct sim_file *stream);
+} sim_file_t;
+
+#define FILE sim_file_t
+#define FDEV_SETUP_STREAM(p, g, f) { (p) }
+#define _FDEV_SETUP_READ 0x01
+#define _FDEV_SETUP_WRITE 0x02
+#define _FDEV_SETUP_RW (_FDEV_SETUP_READ | _FDEV_SETUP_WRITE)
+
+extern sim_file_t *sim_stdout;
+int sim_printf(const char *format, ...)
+    __attribute__((format(printf, 1, 2)));
+
+#undef stdout
+#define stdout sim_stdout
+#define printf sim_printf
+
+#endif /* SIM_AVR_STDIO */
@@ -0,0 +1,29 @@
+/*
+ * File:   delay.h
+ * Author: Nevil Sandaradura
+ * Email: npsand@utu.fi
+ * Device:  Linux host (simulates ATmega4809 Curiosity Nano)
+ *
+ * Stand-in for <util/delay.h> in the host simulation. The delays busy wait
+ * on the host clock like the real ones burn CPU cycles, and the time spent
+ * is counted for the report.
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef SIM_UTIL_DELAY_H
+#define	SIM_UTIL_DELAY_H
+
+void sim_delay_us(double us);
+
+static inline void _delay_us(double us)
+{
+    sim_delay_us(us);
+}
+
+static inline void _delay_ms(double ms)
+{
+    sim_delay_us(ms * 1000.0);
+}
+
+#endif	/* SIM_UTIL_DELAY_H */
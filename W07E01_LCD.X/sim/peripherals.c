@@ -0,0 +1,377 @@
+/*
+ * File:   peripherals.c
+ * Author: Nevil Sandaradura
+ * Email: npsand@utu.fi
+ * Device:  Linux host (simulates ATmega4809 Curiosity Nano)
+ *
+ * Register models of the peripherals used by the W07 application:
+ *
+ *   ADC0     conversions from the scripted input voltages, with the
+ *            conversion time of the selected prescaler
+ *   USART0   one byte buffer and shift register at the BAUD rate
+ *   PORTx    strobe registers (DIRSET, OUTTGL...) and VPORTx aliases
+ *   LCD      1602 on PB3 (E), PB4 (RS) and PD[0:7], latched on E high
+ *   TCB3     8-bit PWM of the backlight on PB5
+ *
+ * Only one task runs at a time on the Posix port, so the application side
+ * needs no locking. The simulation thread only moves bytes out of USART0
+ * and reads the rest. In virtual time every register access takes
+ * SIM_ACCESS_CYCLES, the tick can preempt the task there.
+ *
+ * Created on October 19, 2026
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <avr/io.h>
+
+#include "FreeRTOS.h" // For configCPU_CLOCK_HZ
+#include "sim.h"
+
+// LCD pins, same as lcd.c
+#define LCD_PORT 1
+#define LCD_DATA_PORT 3
+#define LCD_E_PIN PIN3_bm
+#define LCD_RS_PIN PIN4_bm
+// ST7066U execution times
+#define LCD_CMD_NS 37000
+#define LCD_CLEAR_NS 1520000
+// LED on PF5, backlight on PB5
+#define LED_PORT 5
+#define LED_PIN PIN5_bm
+#define BACKLIGHT_PORT 1
+#define BACKLIGHT_PIN PIN5_bm
+// Supply and external reference voltage
+#define VDD_MV 3300
+// ADC conversion in CLK_ADC cycles, sampling and result included
+#define ADC_CONVERSION_CYCLES 15
+// CPU cycles of a register access and the instructions around it
+#define SIM_ACCESS_CYCLES 4
+
+sim_stats_t sim_stats;
+VREF_t sim_vref;
+TCB_t sim_tcb[4];
+
+static ADC_t adc0;
+static uint8_t adc_refsel;
+static uint64_t adc_ready_at;
+static volatile int32_t adc_input_mv[32];
+
+static USART_t usart0 = { .TXDATAL = SIM_USART_EMPTY };
+static uint64_t usart0_shift_free;
+
+static PORT_t ports[6];
+static VPORT_t vports[6];
+static uint8_t vport_out[6]; // VPORT values after the last access
+static uint8_t vport_dir[6];
+static uint64_t led_edge_at;
+
+static struct
+{
+    uint8_t ddram[128];
+    uint8_t address;
+    int8_t increment;
+    uint8_t latched;       // E seen high, waiting for it to go low
+    uint64_t busy_until;
+    char frame[SIM_LCD_LINES][SIM_LCD_COLUMNS];
+} lcd = { .increment = 1 };
+
+/*-----------------------------------------------------------*/
+// ADC0
+
+void sim_set_input(uint8_t ain, int32_t millivolts)
+{
+    adc_input_mv[ain & ADC_MUXPOS_gm] = millivolts;
+}
+
+static int32_t adc_reference_mv(void)
+{
+    if(adc_refsel != ADC_REFSEL_INTREF_gc)
+    {
+        return VDD_MV;
+    }
+    switch(sim_vref.CTRLA & VREF_ADC0REFSEL_gm)
+    {
+        case VREF_ADC0REFSEL_0V55_gc:
+            return 550;
+        case VREF_ADC0REFSEL_1V1_gc:
+            return 1100;
+        case VREF_ADC0REFSEL_1V5_gc:
+            return 1500;
+        case VREF_ADC0REFSEL_4V34_gc:
+            return 4340;
+        default:
+            return 2500;
+    }
+}
+
+ADC_t *sim_adc0(void)
+{
+    uint64_t now;
+
+    sim_cpu_cycles(SIM_ACCESS_CYCLES);
+    now = sim_time_ns();
+
+    // Reference changes need settling time on the real device
+    if((adc0.CTRLC & ADC_REFSEL_gm) != adc_refsel)
+    {
+        adc_refsel = adc0.CTRLC & ADC_REFSEL_gm;
+        sim_stats.adc_reference_changes++;
+    }
+    if((adc0.COMMAND & ADC_STCONV_bm) && (adc0.CTRLA & ADC_ENABLE_bm))
+    {
+        if(adc_ready_at == 0)
+        {
+            // Conversion started by the previous write
+            uint32_t clk_adc = configCPU_CLOCK_HZ /
+                               (2u << (adc0.CTRLC & ADC_PRESC_gm));
+            adc0.INTFLAGS &= ~ADC_RESRDY_bm;
+            adc_ready_at = now + (uint64_t)ADC_CONVERSION_CYCLES *
+                           1000000000u / clk_adc;
+        }
+        else if(now >= adc_ready_at)
+        {
+            uint8_t muxpos = adc0.MUXPOS & ADC_MUXPOS_gm;
+            int32_t result = adc_input_mv[muxpos] * 1024 / adc_reference_mv();
+
+            result = result < 0 ? 0 : (result > 1023 ? 1023 : result);
+            if(adc0.CTRLA & ADC_RESSEL_bm)
+            {
+                result >>= 2;
+            }
+            adc0.RES = (uint16_t)result;
+            adc0.COMMAND &= ~ADC_STCONV_bm;
+            adc0.INTFLAGS |= ADC_RESRDY_bm;
+            adc_ready_at = 0;
+            sim_stats.adc_conversions[muxpos]++;
+        }
+    }
+    return &adc0;
+}
+
+/*-----------------------------------------------------------*/
+// USART0
+
+USART_t *sim_usart0(void)
+{
+    sim_cpu_cycles(SIM_ACCESS_CYCLES);
+    if(__atomic_load_n(&usart0.TXDATAL, __ATOMIC_ACQUIRE) == SIM_USART_EMPTY)
+    {
+        usart0.STATUS |= USART_DREIF_bm;
+    }
+    else
+    {
+        usart0.STATUS &= ~USART_DREIF_bm;
+    }
+    return &usart0;
+}
+
+int sim_usart0_step(uint64_t now)
+{
+    uint16_t data = __atomic_load_n(&usart0.TXDATAL, __ATOMIC_ACQUIRE);
+    uint32_t baud;
+
+    if(data == SIM_USART_EMPTY || !(usart0.CTRLB & USART_TXEN_bm) ||
+       usart0.BAUD < 64 || now < usart0_shift_free)
+    {
+        return -1;
+    }
+    // Normal speed mode, BAUD = 64 * f_CLK_PER / (16 * baud rate)
+    baud = (uint32_t)(4ull * configCPU_CLOCK_HZ / usart0.BAUD);
+    // Start bit, 8 data bits and a stop bit
+    usart0_shift_free = now + 10ull * 1000000000u / baud;
+    __atomic_store_n(&usart0.TXDATAL, SIM_USART_EMPTY, __ATOMIC_RELEASE);
+    sim_stats.uart_bytes++;
+    return data & 0xFF;
+}
+
+/*-----------------------------------------------------------*/
+// LCD
+
+static void lcd_snapshot(void)
+{
+    uint8_t line;
+
+    for(line = 0; line < SIM_LCD_LINES; line++)
+    {
+        memcpy(lcd.frame[line], &lcd.ddram[line * 0x40], SIM_LCD_COLUMNS);
+    }
+}
+
+static void lcd_transaction(uint8_t rs, uint8_t data, uint64_t now)
+{
+    uint64_t busy = LCD_CMD_NS;
+
+    if(now < lcd.busy_until)
+    {
+        sim_stats.lcd_timing_violations++;
+    }
+    if(rs)
+    {
+        sim_stats.lcd_data++;
+        lcd.ddram[lcd.address] = data;
+        lcd.address = (lcd.address + lcd.increment) & 0x7F;
+    }
+    else
+    {
+        sim_stats.lcd_commands++;
+        if(data & 0x80)
+        {
+            // Set DDRAM address
+            lcd.address = data & 0x7F;
+        }
+        else if(data == 0x01)
+        {
+            // Clear display, keep what was shown for the report
+            sim_stats.lcd_clears++;
+            lcd_snapshot();
+            memset(lcd.ddram, ' ', sizeof(lcd.ddram));
+            lcd.address = 0;
+            lcd.increment = 1;
+            busy = LCD_CLEAR_NS;
+        }
+        else if((data & 0xFE) == 0x02)
+        {
+            // Return home
+            lcd.address = 0;
+            busy = LCD_CLEAR_NS;
+        }
+        else if((data & 0xFC) == 0x04)
+        {
+            // Entry mode set
+            lcd.increment = (data & 0x02) ? 1 : -1;
+        }
+    }
+    lcd.busy_until = now + busy;
+}
+
+void sim_lcd_line(uint8_t line, uint8_t last_frame,
+                  char text[SIM_LCD_COLUMNS + 1])
+{
+    uint8_t i;
+
+    if(last_frame)
+    {
+        memcpy(text, lcd.frame[line], SIM_LCD_COLUMNS);
+    }
+    else
+    {
+        memcpy(text, &lcd.ddram[line * 0x40], SIM_LCD_COLUMNS);
+    }
+    // Unwritten or custom characters
+    for(i = 0; i < SIM_LCD_COLUMNS; i++)
+    {
+        if(text[i] < ' ' || text[i] > '~')
+        {
+            text[i] = ' ';
+        }
+    }
+    text[SIM_LCD_COLUMNS] = '\0';
+}
+
+/*-----------------------------------------------------------*/
+// PORTx and VPORTx
+
+static void port_sync(uint8_t n)
+{
+    PORT_t *port = &ports[n];
+    VPORT_t *vport = &vports[n];
+    uint8_t dir = vport->DIR != vport_dir[n] ? vport->DIR : port->DIR;
+    uint8_t out = vport->OUT != vport_out[n] ? vport->OUT : port->OUT;
+    uint8_t old_out = vport_out[n];
+
+    // Apply the strobe registers written since the last access
+    dir = ((dir | port->DIRSET) & ~port->DIRCLR) ^ port->DIRTGL;
+    out = ((out | port->OUTSET) & ~port->OUTCLR) ^ port->OUTTGL;
+    port->DIRSET = port->DIRCLR = port->DIRTGL = 0;
+    port->OUTSET = port->OUTCLR = port->OUTTGL = 0;
+
+    port->DIR = vport->DIR = vport_dir[n] = dir;
+    port->OUT = vport->OUT = vport_out[n] = out;
+    // Nothing drives the input pins
+    port->IN = vport->IN = out & dir;
+
+    if(n == LED_PORT && ((old_out ^ out) & LED_PIN))
+    {
+        uint64_t now = sim_time_ns();
+        uint64_t interval = now - led_edge_at;
+
+        // Shows how late the LED rule runs
+        if(sim_stats.led_edges++ > 0)
+        {
+            if(sim_stats.led_interval_min_ns == 0 ||
+               interval < sim_stats.led_interval_min_ns)
+            {
+                sim_stats.led_interval_min_ns = interval;
+            }
+            if(interval > sim_stats.led_interval_max_ns)
+            {
+                sim_stats.led_interval_max_ns = interval;
+            }
+        }
+        led_edge_at = now;
+    }
+}
+
+static void lcd_bus_sample(void)
+{
+    uint8_t control = vport_out[LCD_PORT] & vport_dir[LCD_PORT];
+
+    if(!(control & LCD_E_PIN))
+    {
+        lcd.latched = 0;
+    }
+    else if(!lcd.latched)
+    {
+        // ST7066U latches on the falling edge, the next access to VPORTB
+        // is the one that clears E, so the bus is stable here
+        port_sync(LCD_DATA_PORT);
+        lcd.latched = 1;
+        lcd_transaction(control & LCD_RS_PIN,
+                        vport_out[LCD_DATA_PORT] & vport_dir[LCD_DATA_PORT],
+                        sim_time_ns());
+    }
+}
+
+PORT_t *sim_port(uint8_t n)
+{
+    sim_cpu_cycles(SIM_ACCESS_CYCLES);
+    port_sync(n);
+    if(n == LCD_PORT)
+    {
+        lcd_bus_sample();
+    }
+    return &ports[n];
+}
+
+VPORT_t *sim_vport(uint8_t n)
+{
+    sim_cpu_cycles(SIM_ACCESS_CYCLES);
+    port_sync(n);
+    if(n == LCD_PORT)
+    {
+        lcd_bus_sample();
+    }
+    return &vports[n];
+}
+
+/*-----------------------------------------------------------*/
+// TCB3
+
+double sim_backlight_duty(void)
+{
+    TCB_t *tcb = &sim_tcb[3];
+    uint16_t ccmp = tcb->CCMP;
+    double period = (ccmp & 0xFF) + 1;
+    double duty = ccmp >> 8;
+
+    if((tcb->CTRLA & TCB_ENABLE_bm) && (tcb->CTRLB & TCB_CCMPEN_bm) &&
+       (tcb->CTRLB & TCB_CNTMODE_gm) == TCB_CNTMODE_PWM8_gc)
+    {
+        // Output stays high when the duty cycle is above the period
+        return duty >= period ? 1.0 : duty / period;
+    }
+    // Pin is driven by the port
+    return (ports[BACKLIGHT_PORT].OUT & ports[BACKLIGHT_PORT].DIR &
+            BACKLIGHT_PIN) ? 1.0 : 0.0;
+}
@@ -0,0 +1,57 @@
+/*
+ * File:   sim.h
+ * Author: Nevil Sandaradura
+ * Email: npsand@utu.fi
+ * Device:  Linux host (simulates ATmega4809 Curiosity Nano)
+ *
+ * Interface between the peripheral models (peripherals.c) and the
+ * simulation driver (simmain.c).
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef SIM_H
+#define	SIM_H
+
+#include <stdint.h>
+
+// LCD 1602 geometry
+#define SIM_LCD_LINES 2
+#define SIM_LCD_COLUMNS 16
+
+// Counters shown in the report
+typedef struct
+{
+    uint32_t adc_conversions[32];   // per MUXPOS
+    uint32_t adc_reference_changes; // ADC0.CTRLC REFSEL changes
+    uint32_t lcd_commands;          // RS low transactions
+    uint32_t lcd_data;              // RS high transactions
+    uint32_t lcd_clears;
+    uint32_t lcd_timing_violations; // sent while the LCD was still busy
+    uint32_t uart_bytes;
+    uint32_t led_edges;             // PF5 changes
+    uint64_t led_interval_min_ns;   // between PF5 changes, 0 if < 2 edges
+    uint64_t led_interval_max_ns;
+    uint64_t delay_ns;              // time spent in _delay_us/_delay_ms
+} sim_stats_t;
+
+extern sim_stats_t sim_stats;
+
+// Nanoseconds since the simulation started
+uint64_t sim_time_ns(void);
+// Lets the time of CPU cycles pass in virtual time, does nothing in real
+// time where the host takes its own time
+void sim_cpu_cycles(uint32_t cycles);
+// Sets the voltage on an analog input pin (AINx)
+void sim_set_input(uint8_t ain, int32_t millivolts);
+// Moves the next byte out of USART0 at the configured baud rate, returns
+// -1 if there is nothing to send yet
+int sim_usart0_step(uint64_t now);
+// Backlight brightness 0.0 ... 1.0 from TCB3 or PB5
+double sim_backlight_duty(void);
+// Copies an LCD line, the last complete frame (contents before the last
+// clear command) or what the LCD shows right now
+void sim_lcd_line(uint8_t line, uint8_t last_frame,
+                  char text[SIM_LCD_COLUMNS + 1]);
+
+#endif	/* SIM_H */
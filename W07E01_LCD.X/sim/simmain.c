@@ -0,0 +1,463 @@
+/*
+ * File:   simmain.c
+ * Author: Nevil Sandaradura
+ * Email: npsand@utu.fi
+ * Device:  Linux host (simulates ATmega4809 Curiosity Nano)
+ *
+ * Runs the W07 application on the FreeRTOS Posix port for a fixed time
+ * and prints a report of the peripheral activity. main() of the
+ * application is renamed to app_main() by the Makefile.
+ *
+ * Usage: w07sim [-t ms] [-s script] [-o capture] [-q]
+ *
+ *   -t ms       run time, 10000 by default
+ *   -s script   ADC input script, see below
+ *   -o capture  also write the bytes sent on USART0 to a file, which
+ *               runtimestats.py and trace2json.py can read
+ *   -q          do not echo USART0 to stdout
+ *
+ * The script sets the input voltages over time, one change per line:
+ *
+ *   # time_ms input millivolts
+ *   0     ldr 1000
+ *   1500  pot 500
+ *
+ * Inputs are ldr (AIN8), ntc (AIN9), pot (AIN14) or ainN.
+ *
+ * In real time a second thread runs the simulation steps against the host
+ * clock. In virtual time (SIM_VIRTUAL_TIME) the port calls them as its
+ * time passes, and the times above are virtual.
+ *
+ * Created on October 19, 2026
+ */
+
+#define _GNU_SOURCE
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "sim.h"
+#if SIM_VIRTUAL_TIME == 1
+#include "FreeRTOS.h" // For the virtual time of the port
+#endif
+
+// Simulation thread period, shorter than one byte at 9600 baud
+#define SIM_STEP_NS 50000
+#define SIM_SCRIPT_MAX 256
+// Inputs before the script changes them, in millivolts
+#define SIM_DEFAULT_LDR_MV 1000
+#define SIM_DEFAULT_NTC_MV 750
+#define SIM_DEFAULT_POT_MV 1650
+
+typedef struct
+{
+    uint64_t time_ns;
+    uint8_t ain;
+    int32_t millivolts;
+} sim_script_t;
+
+// avr-libc style stdout of the application, see include/stdio.h
+typedef struct sim_file
+{
+    int (*put)(char c, struct sim_file *stream);
+} sim_file_t;
+
+sim_file_t *sim_stdout;
+
+int app_main(void);
+
+#if SIM_VIRTUAL_TIME == 0
+static struct timespec sim_start;
+#endif
+static uint64_t run_ns = 10000000000ull;
+static sim_script_t script[SIM_SCRIPT_MAX];
+static unsigned script_length;
+static FILE *capture;
+static int echo = 1;
+
+// Simulation step state
+static unsigned script_index;
+static double duty_sum;
+static uint64_t duty_samples;
+static uint64_t backlight_off_ns;
+static uint64_t previous_step_ns;
+
+/*-----------------------------------------------------------*/
+
+uint64_t sim_time_ns(void)
+{
+#if SIM_VIRTUAL_TIME == 1
+    return ullPortGetVirtualTime();
+#else
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)(now.tv_sec - sim_start.tv_sec) * 1000000000u +
+           now.tv_nsec - sim_start.tv_nsec;
+#endif
+}
+
+void sim_cpu_cycles(uint32_t cycles)
+{
+#if SIM_VIRTUAL_TIME == 1
+    vPortConsumeVirtualTime((uint64_t)cycles * 1000000000u /
+                            configCPU_CLOCK_HZ);
+#else
+    (void)cycles;
+#endif
+}
+
+void sim_delay_us(double us)
+{
+#if SIM_VIRTUAL_TIME == 1
+    uint64_t delay = (uint64_t)(us * 1000.0);
+
+    // The tick may still preempt
+    vPortConsumeVirtualTime(delay);
+    sim_stats.delay_ns += delay;
+#else
+    uint64_t start = sim_time_ns();
+    uint64_t end = start + (uint64_t)(us * 1000.0);
+    uint64_t now;
+
+    // Busy wait like the AVR delay loops, the tick may still preempt
+    do
+    {
+        now = sim_time_ns();
+    } while(now < end);
+    __atomic_add_fetch(&sim_stats.delay_ns, now - start, __ATOMIC_RELAXED);
+#endif
+}
+
+int sim_printf(const char *format, ...)
+{
+    char buffer[256];
+    va_list args;
+    int length;
+    int i;
+
+    va_start(args, format);
+    length = vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    if(sim_stdout == NULL || length < 0)
+    {
+        return length;
+    }
+    for(i = 0; i < length && buffer[i] != '\0'; i++)
+    {
+        sim_stdout->put(buffer[i], sim_stdout);
+    }
+    return length;
+}
+
+// Per thread, the tasks switch only with all signals blocked
+static __thread sigset_t critical_mask;
+static __thread unsigned critical_nesting;
+
+void sim_enter_critical(void)
+{
+    sigset_t signals;
+    sigset_t previous;
+
+    // SIGINT stays open like in the Posix port
+    sigfillset(&signals);
+    sigdelset(&signals, SIGINT);
+    pthread_sigmask(SIG_BLOCK, &signals, &previous);
+    if(critical_nesting++ == 0)
+    {
+        critical_mask = previous;
+    }
+}
+
+void sim_exit_critical(void)
+{
+    if(--critical_nesting == 0)
+    {
+        pthread_sigmask(SIG_SETMASK, &critical_mask, NULL);
+    }
+}
+
+void sim_assert(const char *file, int line)
+{
+    fprintf(stderr, "w07sim: assertion failed at %s:%d\n", file, line);
+    fflush(NULL);
+    _exit(2);
+}
+
+/*-----------------------------------------------------------*/
+
+static int parse_input(const char *name)
+{
+    if(strcmp(name, "ldr") == 0)
+    {
+        return 8;
+    }
+    if(strcmp(name, "ntc") == 0)
+    {
+        return 9;
+    }
+    if(strcmp(name, "pot") == 0)
+    {
+        return 14;
+    }
+    if(strncmp(name, "ain", 3) == 0 && name[3] != '\0')
+    {
+        char *end;
+        long ain = strtol(name + 3, &end, 10);
+
+        if(*end == '\0' && ain >= 0 && ain < 32)
+        {
+            return (int)ain;
+        }
+    }
+    return -1;
+}
+
+static void load_script(const char *path)
+{
+    FILE *file = fopen(path, "r");
+    char line[128];
+    unsigned number = 0;
+
+    if(file == NULL)
+    {
+        perror(path);
+        exit(1);
+    }
+    while(fgets(line, sizeof(line), file) != NULL)
+    {
+        unsigned long long time_ms;
+        char name[16];
+        long millivolts;
+        int ain;
+        int fields;
+
+        number++;
+        if(line[strspn(line, " \t\r\n")] == '#' ||
+           line[strspn(line, " \t\r\n")] == '\0')
+        {
+            continue;
+        }
+        fields = sscanf(line, "%llu %15s %ld", &time_ms, name, &millivolts);
+        ain = fields == 3 ? parse_input(name) : -1;
+        if(ain < 0 || script_length == SIM_SCRIPT_MAX ||
+           (script_length > 0 &&
+            time_ms * 1000000u < script[script_length - 1].time_ns))
+        {
+            fprintf(stderr, "%s:%u: bad line, times must not decrease\n",
+                    path, number);
+            exit(1);
+        }
+        script[script_length].time_ns = time_ms * 1000000u;
+        script[script_length].ain = (uint8_t)ain;
+        script[script_length].millivolts = (int32_t)millivolts;
+        script_length++;
+    }
+    fclose(file);
+}
+
+/*-----------------------------------------------------------*/
+
+static void report(uint64_t now, double duty_sum, uint64_t duty_samples,
+                   uint64_t backlight_off_ns)
+{
+    char text[SIM_LCD_COLUMNS + 1];
+    uint32_t conversions = 0;
+    uint8_t ain;
+    uint8_t line;
+
+    for(ain = 0; ain < 32; ain++)
+    {
+        conversions += sim_stats.adc_conversions[ain];
+    }
+    printf("\n--- w07sim report ---\n");
+    printf("run time ms: %llu\n", (unsigned long long)(now / 1000000u));
+    printf("adc conversions: %u\n", conversions);
+    for(ain = 0; ain < 32; ain++)
+    {
+        if(sim_stats.adc_conversions[ain] > 0)
+        {
+            printf("adc ain%u conversions: %u\n", ain,
+                   sim_stats.adc_conversions[ain]);
+        }
+    }
+    printf("adc reference changes: %u\n", sim_stats.adc_reference_changes);
+    printf("lcd commands: %u\n", sim_stats.lcd_commands);
+    printf("lcd data: %u\n", sim_stats.lcd_data);
+    printf("lcd clears: %u\n", sim_stats.lcd_clears);
+    printf("lcd timing violations: %u\n", sim_stats.lcd_timing_violations);
+    printf("uart bytes: %u\n", sim_stats.uart_bytes);
+    printf("led edges: %u\n", sim_stats.led_edges);
+    printf("led interval min ms: %.1f\n",
+           sim_stats.led_interval_min_ns / 1000000.0);
+    printf("led interval max ms: %.1f\n",
+           sim_stats.led_interval_max_ns / 1000000.0);
+    printf("backlight duty now %%: %.1f\n", 100.0 * sim_backlight_duty());
+    printf("backlight duty mean %%: %.1f\n",
+           duty_samples ? 100.0 * duty_sum / duty_samples : 0.0);
+    printf("backlight off ms: %llu\n",
+           (unsigned long long)(backlight_off_ns / 1000000u));
+    printf("busy wait ms: %llu\n",
+           (unsigned long long)(sim_stats.delay_ns / 1000000u));
+    for(line = 0; line < SIM_LCD_LINES; line++)
+    {
+        sim_lcd_line(line, 1, text);
+        printf("lcd frame %u: |%s|\n", line, text);
+    }
+    for(line = 0; line < SIM_LCD_LINES; line++)
+    {
+        sim_lcd_line(line, 0, text);
+        printf("lcd now %u: |%s|\n", line, text);
+    }
+    fflush(stdout);
+}
+
+// Plays the script, moves bytes out of USART0 and ends the run
+static void sim_step(uint64_t now)
+{
+    double duty;
+    int sent = 0;
+    int data;
+
+    while(script_index < script_length &&
+          script[script_index].time_ns <= now)
+    {
+        sim_set_input(script[script_index].ain,
+                      script[script_index].millivolts);
+        script_index++;
+    }
+    while((data = sim_usart0_step(now)) >= 0)
+    {
+        if(echo)
+        {
+            putchar(data);
+        }
+        if(capture != NULL)
+        {
+            fputc(data, capture);
+        }
+        sent = 1;
+    }
+    duty = sim_backlight_duty();
+    duty_sum += duty;
+    duty_samples++;
+    if(duty == 0.0)
+    {
+        backlight_off_ns += now - previous_step_ns;
+    }
+    previous_step_ns = now;
+
+    if(now >= run_ns)
+    {
+        if(capture != NULL)
+        {
+            fclose(capture);
+        }
+        report(now, duty_sum, duty_samples, backlight_off_ns);
+        // The tasks never return, stop them with the process
+        _exit(0);
+    }
+    if(echo && sent)
+    {
+        fflush(stdout);
+    }
+}
+
+#if SIM_VIRTUAL_TIME == 1
+// Runs the steps up to the new time, nothing in them wakes a task, so
+// running them late does not change the result
+void vApplicationVirtualTimeHook(uint64_t now)
+{
+    static uint64_t next;
+
+    while(next <= now)
+    {
+        sim_step(next);
+        next += SIM_STEP_NS;
+    }
+}
+#else
+static void *sim_thread(void *param)
+{
+    struct timespec next = sim_start;
+    sigset_t signals;
+
+    // Keep the tick signal of the Posix port away from this thread
+    sigfillset(&signals);
+    pthread_sigmask(SIG_BLOCK, &signals, NULL);
+
+    for(;;)
+    {
+        sim_step(sim_time_ns());
+
+        next.tv_nsec += SIM_STEP_NS;
+        if(next.tv_nsec >= 1000000000)
+        {
+            next.tv_nsec -= 1000000000;
+            next.tv_sec++;
+        }
+        while(clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next,
+                              NULL) == EINTR)
+        {
+            ;
+        }
+    }
+    return NULL;
+}
+#endif
+
+int main(int argc, char *argv[])
+{
+#if SIM_VIRTUAL_TIME == 0
+    pthread_t thread;
+#endif
+    int option;
+
+    while((option = getopt(argc, argv, "t:s:o:q")) != -1)
+    {
+        switch(option)
+        {
+            case 't':
+                run_ns = strtoull(optarg, NULL, 10) * 1000000u;
+                break;
+            case 's':
+                load_script(optarg);
+                break;
+            case 'o':
+                capture = fopen(optarg, "wb");
+                if(capture == NULL)
+                {
+                    perror(optarg);
+                    return 1;
+                }
+                break;
+            case 'q':
+                echo = 0;
+                break;
+            default:
+                fprintf(stderr, "usage: %s [-t ms] [-s script] "
+                        "[-o capture] [-q]\n", argv[0]);
+                return 1;
+        }
+    }
+
+    sim_set_input(8, SIM_DEFAULT_LDR_MV);
+    sim_set_input(9, SIM_DEFAULT_NTC_MV);
+    sim_set_input(14, SIM_DEFAULT_POT_MV);
+#if SIM_VIRTUAL_TIME == 0
+    clock_gettime(CLOCK_MONOTONIC, &sim_start);
+    if(pthread_create(&thread, NULL, sim_thread, NULL) != 0)
+    {
+        perror("pthread_create");
+        return 1;
+    }
+#endif
+    return app_main();
+}
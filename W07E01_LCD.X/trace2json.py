@@ -0,0 +1,237 @@
+#!/usr/bin/env python3
+#
+# File:   trace2json.py
+# Author: Nevil Sandaradura
+# Email: npsand@utu.fi
+#
+# Converts the kernel trace frames sent by tracerecorder.c to Chrome trace
+# JSON, which can be opened in chrome://tracing or https://ui.perfetto.dev.
+# Text printed by the application on the same USART0 is skipped. Reads a
+# serial port (needs pyserial, stop with Ctrl+C) or a file of captured bytes.
+#
+# Usage: trace2json.py /dev/ttyACM0 trace.json
+#        trace2json.py capture.bin trace.json
+#
+# Created on October 19, 2026
+
+import json
+import struct
+import sys
+
+SYNC = b"\xa5\x5b"
+VERSION = 1
+TASK_NAME_LEN = 8  # configMAX_TASK_NAME_LEN
+RECORD_FORMAT = "<BBHI"
+RECORD_SIZE = struct.calcsize(RECORD_FORMAT)
+
+# trace_event_t in tracerecorder.h
+(TASK_CREATE, TASK_SWITCHED_IN, TASK_DELAY, TASK_DELAY_UNTIL, TICK,
+ QUEUE_CREATE, QUEUE_SEND, QUEUE_SEND_FAILED, QUEUE_RECEIVE,
+ QUEUE_RECEIVE_FAILED, QUEUE_PEEK, QUEUE_BLOCK_SEND, QUEUE_BLOCK_RECEIVE,
+ QUEUE_SEND_FROM_ISR, QUEUE_RECEIVE_FROM_ISR, TIMER_CREATE,
+ TIMER_COMMAND_SEND, TIMER_EXPIRED) = range(1, 19)
+
+QUEUE_EVENTS = {
+    QUEUE_SEND: ("send", 1),
+    QUEUE_SEND_FAILED: ("send failed", 0),
+    QUEUE_RECEIVE: ("receive", -1),
+    QUEUE_RECEIVE_FAILED: ("receive failed", 0),
+    QUEUE_PEEK: ("peek", 0),
+    QUEUE_BLOCK_SEND: ("block on send", 0),
+    QUEUE_BLOCK_RECEIVE: ("block on receive", 0),
+    QUEUE_SEND_FROM_ISR: ("send from ISR", 1),
+    QUEUE_RECEIVE_FROM_ISR: ("receive from ISR", -1),
+}
+QUEUE_TYPES = ["queue", "mutex", "counting semaphore", "binary semaphore",
+               "recursive mutex", "queue set"]
+TIMER_COMMANDS = {0: "start (no wait)", 1: "start", 2: "reset", 3: "stop",
+                  4: "change period", 5: "delete", 6: "start from ISR",
+                  7: "reset from ISR", 8: "stop from ISR",
+                  9: "change period from ISR"}
+
+PID = 1
+ISR_TID = 0  # Task numbers start from 1
+
+
+def open_input(path):
+    if path.startswith("/dev/"):
+        import serial
+        return serial.Serial(path, 9600)
+    return open(path, "rb")
+
+
+def frames(stream):
+    """Yields (clock, task names, records) for every valid frame."""
+    buffer = b""
+    while True:
+        try:
+            data = stream.read(1 if hasattr(stream, "baudrate") else 4096)
+        except KeyboardInterrupt:
+            return
+        if not data:
+            return
+        buffer += data
+        while True:
+            start = buffer.find(SYNC)
+            if start < 0:
+                buffer = buffer[-1:]
+                break
+            body = buffer[start + 2:]
+            frame = parse(body)
+            if frame is None:
+                # Need more data
+                buffer = buffer[start:]
+                break
+            if frame is False:
+                # Sync bytes inside text or a corrupted frame
+                buffer = buffer[start + 1:]
+                continue
+            length, clock, names, records = frame
+            buffer = body[length + 1:]
+            yield clock, names, records
+
+
+def parse(body):
+    """Returns None if body is incomplete, False if it is not a frame."""
+    if len(body) < 6:
+        return None
+    version, clock, task_count = struct.unpack_from("<BIB", body)
+    if version != VERSION:
+        return False
+    offset = 6
+    names = {}
+    for i in range(task_count):
+        if len(body) < offset + 1 + TASK_NAME_LEN:
+            return None
+        name = body[offset + 1:offset + 1 + TASK_NAME_LEN]
+        names[body[offset]] = name.split(b"\0")[0].decode("ascii", "replace")
+        offset += 1 + TASK_NAME_LEN
+    if len(body) < offset + 2:
+        return None
+    record_count, = struct.unpack_from("<H", body, offset)
+    offset += 2
+    length = offset + record_count * RECORD_SIZE
+    if len(body) < length + 1:
+        return None
+    if sum(body[:length]) & 0xFF != body[length]:
+        return False
+    records = [struct.unpack_from(RECORD_FORMAT, body, offset + i * RECORD_SIZE)
+               for i in range(record_count)]
+    return length, clock, names, records
+
+
+class Converter:
+    def __init__(self):
+        self.events = []
+        self.names = {}
+        self.queue_types = {}
+        self.offset = 0  # Keeps time moving forward between frames
+
+    def microseconds(self, timestamp, clock):
+        return timestamp * 1e6 / clock
+
+    def add_frame(self, clock, names, records):
+        self.names.update(names)
+        if not records:
+            return
+        # Timestamps are 32 bits wide, unwrap them within the frame
+        base = records[0][3]
+        start = self.offset
+        running = None
+        running_since = None
+        elapsed = 0
+        for event, obj, data, timestamp in records:
+            elapsed += (timestamp - base) & 0xFFFFFFFF
+            base = timestamp
+            ts = start + self.microseconds(elapsed, clock)
+            if event == TASK_SWITCHED_IN:
+                if running is not None:
+                    self.slice(running, running_since, ts)
+                running, running_since = obj, ts
+            elif event == TASK_CREATE:
+                self.instant(ISR_TID if running is None else running, ts,
+                             "create %s" % self.task_name(obj),
+                             {"priority": data})
+            elif event == TASK_DELAY:
+                self.instant(obj, ts, "delay")
+            elif event == TASK_DELAY_UNTIL:
+                self.instant(obj, ts, "delay until", {"wake tick": data})
+            elif event == TICK:
+                self.instant(ISR_TID, ts, "tick", {"tick": data})
+            elif event == QUEUE_CREATE:
+                self.queue_types[obj] = data
+            elif event in QUEUE_EVENTS:
+                name, change = QUEUE_EVENTS[event]
+                in_isr = event in (QUEUE_SEND_FROM_ISR, QUEUE_RECEIVE_FROM_ISR)
+                tid = ISR_TID if in_isr or running is None else running
+                self.instant(tid, ts, "%s %s" % (name, self.queue_name(obj)),
+                             {"waiting": data})
+                # Data is the level before the operation
+                self.events.append({
+                    "ph": "C", "pid": PID, "ts": ts,
+                    "name": self.queue_name(obj),
+                    "args": {"waiting": data + change}})
+            elif event == TIMER_CREATE:
+                pass
+            elif event == TIMER_COMMAND_SEND:
+                command = TIMER_COMMANDS.get(data & 0xFF, str(data & 0xFF))
+                self.instant(ISR_TID if running is None else running, ts,
+                             "timer %d %s" % (obj, command),
+                             {"result": data >> 8})
+            elif event == TIMER_EXPIRED:
+                self.instant(ISR_TID if running is None else running, ts,
+                             "timer %d expired" % obj)
+        end = start + self.microseconds(elapsed, clock)
+        if running is not None:
+            self.slice(running, running_since, end)
+        # Frames are sent back to back, the gap between them is not known
+        self.offset = end + 1000
+
+    def task_name(self, number):
+        return self.names.get(number, "task %d" % number)
+
+    def queue_name(self, number):
+        kind = self.queue_types.get(number)
+        kind = QUEUE_TYPES[kind] if kind is not None and kind < len(
+            QUEUE_TYPES) else "queue"
+        return "%s %d" % (kind, number)
+
+    def slice(self, tid, start, end):
+        self.events.append({"ph": "X", "pid": PID, "tid": tid, "ts": start,
+                            "dur": end - start, "name": self.task_name(tid)})
+
+    def instant(self, tid, ts, name, args=None):
+        event = {"ph": "i", "s": "t", "pid": PID, "tid": tid, "ts": ts,
+                 "name": name}
+        if args:
+            event["args"] = args
+        self.events.append(event)
+
+    def json(self):
+        metadata = [{"ph": "M", "pid": PID, "name": "process_name",
+                     "args": {"name": "ATmega4809"}},
+                    {"ph": "M", "pid": PID, "tid": ISR_TID,
+                     "name": "thread_name", "args": {"name": "ISR"}}]
+        for number, name in sorted(self.names.items()):
+            metadata.append({"ph": "M", "pid": PID, "tid": number,
+                             "name": "thread_name", "args": {"name": name}})
+        return {"traceEvents": metadata + self.events,
+                "displayTimeUnit": "ms"}
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit("usage: %s <serial port or capture file> <output.json>" %
+                 sys.argv[0])
+    converter = Converter()
+    count = 0
+    for clock, names, records in frames(open_input(sys.argv[1])):
+        converter.add_frame(clock, names, records)
+        count += 1
+    with open(sys.argv[2], "w") as output:
+        json.dump(converter.json(), output)
+    print("%d frames, %d events" % (count, len(converter.events)))
+
+
+if __name__ == "__main__":
+    main()
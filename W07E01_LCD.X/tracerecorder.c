@@ -0,0 +1,206 @@
+/*
+ * File:   tracerecorder.c
+ * Author: Nevil Sandaradura
+ * Email: npsand@utu.fi
+ * Device:  ATmega4809 Curiosity Nano
+ * 
+ * Kernel trace recorder, see tracerecorder.h for the frame format.
+ * A record costs one critical section and a read of the run time stats
+ * timer. Recording stops while the buffer is being sent, which takes about
+ * 0.6 s at 9600 baud for 64 records.
+ * 
+ * Created on October 19, 2026
+ */
+
+#include <stdint.h>
+// FreeRTOS
+#include "FreeRTOS.h" 
+#include "task.h"
+
+#include "uart.h" // To send bytes
+#include "tracerecorder.h"
+
+#if TRACE_RECORDER_ENABLE == 1
+
+#if configGENERATE_RUN_TIME_STATS != 1
+#error The trace recorder needs configGENERATE_RUN_TIME_STATS for timestamps
+#endif
+
+typedef struct
+{
+    uint8_t event;
+    uint8_t object;
+    uint16_t data;
+    uint32_t timestamp;
+} trace_record_t;
+
+static trace_record_t trace_buffer[TRACE_BUFFER_RECORDS];
+static uint16_t trace_next = 0; // Index of the next record to write
+static uint16_t trace_count = 0; // Number of valid records
+static volatile uint8_t trace_paused = 0; // Set while sending
+
+static char trace_task_names[TRACE_MAX_TASKS][configMAX_TASK_NAME_LEN];
+static uint8_t trace_task_numbers[TRACE_MAX_TASKS];
+static uint8_t trace_task_count = 0;
+static uint8_t trace_current_task = 0;
+
+static uint8_t trace_queue_count = 0;
+static uint8_t trace_timer_count = 0;
+
+static uint8_t checksum;
+
+void trace_record(uint8_t event, uint8_t object, uint16_t data)
+{
+    trace_record_t *record;
+    
+    // Kernel calls this from tasks and ISRs, with or without interrupts
+    // disabled, see TRACE_ENTER_CRITICAL
+    TRACE_ENTER_CRITICAL();
+    if(!trace_paused)
+    {
+        record = &trace_buffer[trace_next];
+        record->event = event;
+        record->object = object;
+        record->data = data;
+        record->timestamp = portGET_RUN_TIME_COUNTER_VALUE();
+        
+        if(++trace_next >= TRACE_BUFFER_RECORDS)
+        {
+            trace_next = 0;
+        }
+        if(trace_count < TRACE_BUFFER_RECORDS)
+        {
+            trace_count++;
+        }
+    }
+    TRACE_EXIT_CRITICAL();
+}
+
+void trace_task_create(uint8_t number, const char *name, uint8_t priority)
+{
+    // Names are kept outside the ring buffer so they are never overwritten
+    if(trace_task_count < TRACE_MAX_TASKS)
+    {
+        trace_task_numbers[trace_task_count] = number;
+        for(uint8_t i = 0; i < configMAX_TASK_NAME_LEN; i++)
+        {
+            trace_task_names[trace_task_count][i] = name[i];
+            if(name[i] == '\0')
+            {
+                break;
+            }
+        }
+        trace_task_count++;
+    }
+    trace_record(TRACE_EVENT_TASK_CREATE, number, priority);
+}
+
+void trace_task_switched_in(uint8_t number)
+{
+    // The kernel reports a switch even if the same task keeps running
+    if(number != trace_current_task)
+    {
+        trace_current_task = number;
+        trace_record(TRACE_EVENT_TASK_SWITCHED_IN, number, 0);
+    }
+}
+
+uint8_t trace_queue_create(uint8_t type)
+{
+    uint8_t number;
+    
+    TRACE_ENTER_CRITICAL();
+    number = ++trace_queue_count;
+    TRACE_EXIT_CRITICAL();
+    trace_record(TRACE_EVENT_QUEUE_CREATE, number, type);
+    return number;
+}
+
+uint8_t trace_timer_create(void)
+{
+    uint8_t number;
+    
+    TRACE_ENTER_CRITICAL();
+    number = ++trace_timer_count;
+    TRACE_EXIT_CRITICAL();
+    trace_record(TRACE_EVENT_TIMER_CREATE, number, 0);
+    return number;
+}
+
+static void send_byte(uint8_t value)
+{
+    checksum += value;
+    usart0_send_char((char)value);
+}
+
+static void send_u16(uint16_t value)
+{
+    send_byte((uint8_t)value);
+    send_byte((uint8_t)(value >> 8));
+}
+
+static void send_u32(uint32_t value)
+{
+    send_u16((uint16_t)value);
+    send_u16((uint16_t)(value >> 16));
+}
+
+void trace_send(void)
+{
+    uint16_t index;
+    
+    portENTER_CRITICAL();
+    trace_paused = 1;
+    portEXIT_CRITICAL();
+    
+    // Sync bytes
+    usart0_send_char((char)0xA5);
+    usart0_send_char((char)0x5B);
+    
+    checksum = 0;
+    send_byte(TRACE_VERSION);
+    send_u32(TRACE_CLOCK_HZ);
+    
+    send_byte(trace_task_count);
+    for(uint8_t i = 0; i < trace_task_count; i++)
+    {
+        send_byte(trace_task_numbers[i]);
+        // Name is sent NUL padded to a fixed length
+        uint8_t end = 0;
+        for(uint8_t j = 0; j < configMAX_TASK_NAME_LEN; j++)
+        {
+            if(trace_task_names[i][j] == '\0')
+            {
+                end = 1;
+            }
+            send_byte(end ? 0 : (uint8_t)trace_task_names[i][j]);
+        }
+    }
+    
+    // Oldest record first
+    send_u16(trace_count);
+    index = (trace_next + TRACE_BUFFER_RECORDS - trace_count) % TRACE_BUFFER_RECORDS;
+    for(uint16_t i = 0; i < trace_count; i++)
+    {
+        send_byte(trace_buffer[index].event);
+        send_byte(trace_buffer[index].object);
+        send_u16(trace_buffer[index].data);
+        send_u32(trace_buffer[index].timestamp);
+        if(++index >= TRACE_BUFFER_RECORDS)
+        {
+            index = 0;
+        }
+    }
+    
+    usart0_send_char((char)checksum);
+    
+    // Start a new trace with the task that is running, which is this one
+    portENTER_CRITICAL();
+    trace_next = 0;
+    trace_count = 0;
+    trace_paused = 0;
+    trace_record(TRACE_EVENT_TASK_SWITCHED_IN, trace_current_task, 0);
+    portEXIT_CRITICAL();
+}
+
+#endif /* TRACE_RECORDER_ENABLE */
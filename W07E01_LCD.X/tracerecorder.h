@@ -0,0 +1,153 @@
+/* 
+ * File:   tracerecorder.h
+ * Author: Nevil Sandaradura
+ * Email: npsand@utu.fi
+ * Device:  ATmega4809 Curiosity Nano
+ * 
+ * Kernel trace recorder. Implements the FreeRTOS trace macros by writing
+ * fixed size records to a RAM ring buffer, the oldest records are
+ * overwritten. Included at the end of FreeRTOSConfig.h, so it must only use
+ * types from stdint.h.
+ * 
+ * Binary frame sent over USART0, multi-byte values are little endian:
+ * 
+ *   0xA5 0x5B                  sync, not part of the checksum
+ *   uint8_t  version           TRACE_VERSION
+ *   uint32_t clock             timestamp clock in Hz
+ *   uint8_t  task count
+ *   per task:
+ *     uint8_t  task number
+ *     char     name[configMAX_TASK_NAME_LEN], NUL padded
+ *   uint16_t record count      oldest record first
+ *   per record:
+ *     uint8_t  event           trace_event_t
+ *     uint8_t  object          task, queue or timer number
+ *     uint16_t data            depends on the event
+ *     uint32_t timestamp       run time stats clock counts
+ *   uint8_t  checksum          sum of the bytes after the sync bytes
+ * 
+ * trace2json.py converts the frames to Chrome trace JSON.
+ * 
+ * Created on October 19, 2026
+ */
+
+#ifndef TRACERECORDER_H
+#define	TRACERECORDER_H
+
+#include <stdint.h>
+
+// 0 leaves the trace macros empty and the recorder out. Only with
+// APP_DIAGNOSTICS by default, see FreeRTOSConfig.h
+#ifndef TRACE_RECORDER_ENABLE
+#define TRACE_RECORDER_ENABLE APP_DIAGNOSTICS
+#endif
+// Ring buffer size, each record takes 8 bytes of RAM
+#define TRACE_BUFFER_RECORDS 64
+// Tasks whose names are remembered
+#define TRACE_MAX_TASKS 8
+// Record every tick interrupt, fills the buffer in TRACE_BUFFER_RECORDS ms
+#define TRACE_TICKS 0
+// Seconds between trace frames on USART0, 0 disables the frames
+#ifndef TRACE_DUMP_INTERVAL_S
+#define TRACE_DUMP_INTERVAL_S 10
+#endif
+// Frame format version
+#define TRACE_VERSION 1
+// Timestamps use the run time stats clock of the port, CLK_PER / 2
+#ifndef TRACE_CLOCK_HZ
+#define TRACE_CLOCK_HZ (configCPU_CLOCK_HZ / 2)
+#endif
+// Critical section of the recorder. The kernel records with or without
+// interrupts disabled, so it must restore the state it found. The AVR port
+// saves SREG, ports that count nesting instead override this
+#ifndef TRACE_ENTER_CRITICAL
+#define TRACE_ENTER_CRITICAL() portENTER_CRITICAL()
+#define TRACE_EXIT_CRITICAL() portEXIT_CRITICAL()
+#endif
+
+// Event ids, data is the number of messages waiting before the operation
+// for queue events
+typedef enum
+{
+    TRACE_EVENT_TASK_CREATE = 1,        // data: priority
+    TRACE_EVENT_TASK_SWITCHED_IN,
+    TRACE_EVENT_TASK_DELAY,
+    TRACE_EVENT_TASK_DELAY_UNTIL,       // data: tick to wake at
+    TRACE_EVENT_TICK,                   // data: tick count
+    TRACE_EVENT_QUEUE_CREATE,           // data: queue type
+    TRACE_EVENT_QUEUE_SEND,
+    TRACE_EVENT_QUEUE_SEND_FAILED,
+    TRACE_EVENT_QUEUE_RECEIVE,
+    TRACE_EVENT_QUEUE_RECEIVE_FAILED,
+    TRACE_EVENT_QUEUE_PEEK,
+    TRACE_EVENT_QUEUE_BLOCK_SEND,
+    TRACE_EVENT_QUEUE_BLOCK_RECEIVE,
+    TRACE_EVENT_QUEUE_SEND_FROM_ISR,
+    TRACE_EVENT_QUEUE_RECEIVE_FROM_ISR,
+    TRACE_EVENT_TIMER_CREATE,
+    TRACE_EVENT_TIMER_COMMAND_SEND,     // data: command, result << 8
+    TRACE_EVENT_TIMER_EXPIRED
+} trace_event_t;
+
+// Declaring functions
+void trace_record(uint8_t event, uint8_t object, uint16_t data);
+void trace_task_create(uint8_t number, const char *name, uint8_t priority);
+void trace_task_switched_in(uint8_t number);
+uint8_t trace_queue_create(uint8_t type);
+uint8_t trace_timer_create(void);
+void trace_send(void);
+
+#if TRACE_RECORDER_ENABLE == 1
+
+// These expand inside the kernel sources, where the structures are visible
+#define traceTASK_CREATE(pxNewTCB) \
+    trace_task_create((uint8_t)(pxNewTCB)->uxTCBNumber, \
+                      (pxNewTCB)->pcTaskName, (uint8_t)(pxNewTCB)->uxPriority)
+#define traceTASK_SWITCHED_IN() \
+    trace_task_switched_in((uint8_t)pxCurrentTCB->uxTCBNumber)
+#define traceTASK_DELAY() \
+    trace_record(TRACE_EVENT_TASK_DELAY, (uint8_t)pxCurrentTCB->uxTCBNumber, 0)
+#define traceTASK_DELAY_UNTIL(xTimeToWake) \
+    trace_record(TRACE_EVENT_TASK_DELAY_UNTIL, \
+                 (uint8_t)pxCurrentTCB->uxTCBNumber, (uint16_t)(xTimeToWake))
+#if TRACE_TICKS == 1
+#define traceTASK_INCREMENT_TICK(xTickCount) \
+    trace_record(TRACE_EVENT_TICK, 0, (uint16_t)(xTickCount))
+#endif
+
+#define traceQUEUE_CREATE(pxNewQueue) \
+    (pxNewQueue)->uxQueueNumber = trace_queue_create((pxNewQueue)->ucQueueType)
+#define TRACE_QUEUE(event, pxQueue) \
+    trace_record((event), (uint8_t)(pxQueue)->uxQueueNumber, \
+                 (uint16_t)(pxQueue)->uxMessagesWaiting)
+#define traceQUEUE_SEND(pxQueue) \
+    TRACE_QUEUE(TRACE_EVENT_QUEUE_SEND, pxQueue)
+#define traceQUEUE_SEND_FAILED(pxQueue) \
+    TRACE_QUEUE(TRACE_EVENT_QUEUE_SEND_FAILED, pxQueue)
+#define traceQUEUE_RECEIVE(pxQueue) \
+    TRACE_QUEUE(TRACE_EVENT_QUEUE_RECEIVE, pxQueue)
+#define traceQUEUE_RECEIVE_FAILED(pxQueue) \
+    TRACE_QUEUE(TRACE_EVENT_QUEUE_RECEIVE_FAILED, pxQueue)
+#define traceQUEUE_PEEK(pxQueue) \
+    TRACE_QUEUE(TRACE_EVENT_QUEUE_PEEK, pxQueue)
+#define traceBLOCKING_ON_QUEUE_SEND(pxQueue) \
+    TRACE_QUEUE(TRACE_EVENT_QUEUE_BLOCK_SEND, pxQueue)
+#define traceBLOCKING_ON_QUEUE_RECEIVE(pxQueue) \
+    TRACE_QUEUE(TRACE_EVENT_QUEUE_BLOCK_RECEIVE, pxQueue)
+#define traceQUEUE_SEND_FROM_ISR(pxQueue) \
+    TRACE_QUEUE(TRACE_EVENT_QUEUE_SEND_FROM_ISR, pxQueue)
+#define traceQUEUE_RECEIVE_FROM_ISR(pxQueue) \
+    TRACE_QUEUE(TRACE_EVENT_QUEUE_RECEIVE_FROM_ISR, pxQueue)
+
+#define traceTIMER_CREATE(pxNewTimer) \
+    (pxNewTimer)->uxTimerNumber = trace_timer_create()
+#define traceTIMER_COMMAND_SEND(xTimer, xMessageID, xMessageValueValue, xReturn) \
+    trace_record(TRACE_EVENT_TIMER_COMMAND_SEND, \
+                 (uint8_t)((Timer_t *)(xTimer))->uxTimerNumber, \
+                 (uint16_t)((uint8_t)(xMessageID) | ((uint8_t)(xReturn) << 8)))
+#define traceTIMER_EXPIRED(pxTimer) \
+    trace_record(TRACE_EVENT_TIMER_EXPIRED, (uint8_t)(pxTimer)->uxTimerNumber, 0)
+
+#endif /* TRACE_RECORDER_ENABLE */
+
+#endif	/* TRACERECORDER_H */
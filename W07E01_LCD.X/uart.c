@@ -16,6 +16,10 @@
 
 #include "uart.h" // To get E.g. baud rate
 #include "adc.h" // To get ADC readings
+#include "sampler.h" // Published ADC values
+#include "heapstats.h" // To print heap usage
+#include "runtimestats.h" // To send task CPU usage
+#include "tracerecorder.h" // To send kernel trace
 
 
 // Copied from documentation
@@ -53,21 +57,89 @@ void usart0_init(void)
     stdout = &USART_stream;
 }
 
+// Prints the ADC values if the sampler published new ones, and the
+// statistics when they are due
+static void usart0_report(void)
+{
+    static UBaseType_t printed = 0; // Sequence number of the values printed
+    ADC_result_t output_buffer;
+    UBaseType_t sequence = sampler_read(&output_buffer);
+#if HEAP_STATS_INTERVAL_S > 0
+    static uint8_t heap_stats_counter = 0; // Seconds since last heap dump
+#endif
+#if RUN_TIME_STATS_INTERVAL_S > 0
+    static uint8_t run_time_stats_counter = 0; // Seconds since last dump
+#endif
+#if TRACE_RECORDER_ENABLE == 1 && TRACE_DUMP_INTERVAL_S > 0
+    static uint8_t trace_counter = 0; // Seconds since last trace dump
+#endif
+#if ADC_STATS_INTERVAL_S > 0
+    static uint8_t adc_stats_counter = 0; // Seconds since last ADC report
+#endif
+
+    if(sequence != printed)
+    {
+        printed = sequence;
+        // Print to serail terminal
+        printf("LDR: %d\tNTC: %d\tPOT: %d\r\n", output_buffer.ldr, output_buffer.ntc, output_buffer.pot);
+    }
+#if ADC_STATS_INTERVAL_S > 0
+    // Print ADC throughput every ADC_STATS_INTERVAL_S seconds
+    if(++adc_stats_counter >= ADC_STATS_INTERVAL_S)
+    {
+        adc_stats_counter = 0;
+        adc_stats_print();
+        sampler_stats_print();
+    }
+#endif
+#if HEAP_STATS_INTERVAL_S > 0
+    // Print heap usage every HEAP_STATS_INTERVAL_S seconds
+    if(++heap_stats_counter >= HEAP_STATS_INTERVAL_S)
+    {
+        heap_stats_counter = 0;
+        heap_stats_print();
+    }
+#endif
+#if RUN_TIME_STATS_INTERVAL_S > 0
+    // Send task CPU usage every RUN_TIME_STATS_INTERVAL_S seconds
+    if(++run_time_stats_counter >= RUN_TIME_STATS_INTERVAL_S)
+    {
+        run_time_stats_counter = 0;
+        run_time_stats_send();
+    }
+#endif
+#if TRACE_RECORDER_ENABLE == 1 && TRACE_DUMP_INTERVAL_S > 0
+    // Send kernel trace every TRACE_DUMP_INTERVAL_S seconds
+    if(++trace_counter >= TRACE_DUMP_INTERVAL_S)
+    {
+        trace_counter = 0;
+        trace_send();
+    }
+#endif
+}
+
 void usart0_write(void* param)
 {
-    ADC_result_t output_buffer; // Store value from output queue
-    
     for(;;)
     {       
-        // Take mutex, get ADC values and free mutex
-        xSemaphoreTake(mutex, 100);
-        output_buffer = adc_read();
-        xSemaphoreGive(mutex);
-        // Print to serail terminal
-        printf("LDR: %d\tNTC: %d\tPOT: %d\r\n", output_buffer.ldr, output_buffer.ntc, output_buffer.pot);
+        // The statistics count seconds, so this still runs every second
+        usart0_report();
         // 1s delay
         vTaskDelay(pdMS_TO_TICKS(1000));
     }
     // This task will run infinitely
     vTaskDelete(NULL);
+}
+
+void usart0_co_routine(CoRoutineHandle_t handle, UBaseType_t index)
+{
+    crSTART(handle);
+    for(;;)
+    {
+        // Other co-routines wait until the line has been sent
+        usart0_report();
+        // 1s delay
+        crDELAY(handle, pdMS_TO_TICKS(1000));
+    }
+    crEND();
 }
\ No newline at end of file
@@ -13,9 +13,14 @@
 // Macro to set baud rate, copied from course materials
 #define USART0_BAUD_RATE(BAUD_RATE) ((float)(configCPU_CLOCK_HZ * 64 / (16 * \
 (float)BAUD_RATE)) + 0.5)
+#include "croutine.h"
+
 // Declaring functions
 void USART0_sendString(char *str);
+void usart0_send_char(char c);
 void usart0_write(void* param);
+// Same as usart0_write, for the co-routine build
+void usart0_co_routine(CoRoutineHandle_t handle, UBaseType_t index);
 void usart0_init(void);
 
 #endif	/* USART_H */
\ No newline at end of file